@@ -4218,6 +4218,69 @@ add_newdoc('numpy.core.multiarray', 'ndarray', ('setflags',
     """))
 
 
+add_newdoc('numpy.core.multiarray', 'ndarray', ('partition',
+    """
+    a.partition(kth, axis=-1, kind='introselect', order=None)
+
+    Rearranges the elements in the array in such a way that value of the
+    element in kth position is in the position it would be in a sorted array.
+    All elements smaller than the kth element are moved before this element
+    and all equal or greater are moved behind it. The ordering of the
+    elements in the two partitions is undefined.
+
+    Parameters
+    ----------
+    kth : int or sequence of ints
+        Element index to partition by. The kth element value will be in its
+        final sorted position and all smaller elements will be moved before
+        it and all equal or greater elements behind it. If provided with a
+        sequence of kth it will partition all elements indexed by kth of
+        them into their sorted position at once.
+    axis : int, optional
+        Axis along which to sort. Default is -1, which means sort along the
+        last axis.
+    kind : {'introselect'}, optional
+        Selection algorithm. Default is 'introselect'.
+    order : list, optional
+        When `a` is an array with fields defined, this argument specifies
+        which fields to compare first, second, etc.  Not all fields need be
+        specified.
+
+    See Also
+    --------
+    numpy.partition : Return a partitioned copy of an array.
+    argpartition : Indirect partition.
+    sort : Full sort.
+
+    Notes
+    -----
+    See ``np.partition`` for notes on the different algorithms.
+
+    Examples
+    --------
+    >>> a = np.array([3, 4, 2, 1])
+    >>> a.partition(3)
+    >>> a[3]
+    4
+
+    """))
+
+
+add_newdoc('numpy.core.multiarray', 'ndarray', ('argpartition',
+    """
+    a.argpartition(kth, axis=-1, kind='introselect', order=None)
+
+    Returns the indices that would partition this array.
+
+    Refer to `numpy.argpartition` for full documentation.
+
+    See Also
+    --------
+    numpy.argpartition : equivalent function
+
+    """))
+
+
 add_newdoc('numpy.core.multiarray', 'ndarray', ('sort',
     """
     a.sort(axis=-1, kind='quicksort', order=None)
@@ -4229,7 +4292,7 @@ add_newdoc('numpy.core.multiarray', 'ndarray', ('sort',
     axis : int, optional
         Axis along which to sort. Default is -1, which means sort along the
         last axis.
-    kind : {'quicksort', 'mergesort', 'heapsort'}, optional
+    kind : {'quicksort', 'mergesort', 'heapsort', 'radix'}, optional
         Sorting algorithm. Default is 'quicksort'.
     order : list, optional
         When `a` is an array with fields defined, this argument specifies
@@ -5733,6 +5796,81 @@ add_newdoc('numpy.core', 'ufunc', ('reduceat',
 
     """))
 
+add_newdoc('numpy.core', 'ufunc', ('reduceby',
+    """
+    reduceby(a, labels, minlength=0, dtype=None, out=None)
+
+    Reduces the elements of `a` with the same label.
+
+    Element ``i`` of the result is ``ufunc.reduce(a[labels == i])``, for
+    all the labels at once in a single pass over `a`. Labels without
+    elements give the identity of the ufunc.
+
+    .. versionadded:: 1.7.0
+
+    Parameters
+    ----------
+    a : array_like
+        The 1-D array to act on.
+    labels : array_like
+        Non-negative integers, the label of each element of `a`.
+    minlength : int, optional
+        A minimum length of the result.
+    dtype : data-type code, optional
+        The type used to represent the intermediate results. Defaults
+        to the data type of the output array if this is provided, or
+        the data type of the input array if no output array is provided.
+    out : ndarray, optional
+        A 1-D array with an element for each label. The elements of `a`
+        are reduced into it, so labels without elements keep their value.
+        If not provided a freshly-allocated array is returned.
+
+    Returns
+    -------
+    r : ndarray
+        The reduced values, of length ``max(labels) + 1``, `minlength` or
+        ``len(out)``, whichever is largest. If `out` was supplied, `r` is a
+        reference to `out`.
+
+    Raises
+    ------
+    ValueError
+        If a label is negative, or if a label has no elements and the
+        ufunc has no identity.
+
+    See Also
+    --------
+    bincount, ufunc.reduceat
+
+    Notes
+    -----
+    Consecutive elements with the same label are reduced together as the
+    segments of `reduceat`, so the reduction is fastest if `labels` is
+    sorted.
+
+    Examples
+    --------
+    >>> a = np.array([1., 4., 2., 6., 3.])
+    >>> labels = np.array([0, 2, 0, 2, 1])
+    >>> np.add.reduceby(a, labels)
+    array([  3.,   3.,  10.])
+    >>> np.maximum.reduceby(a, labels)
+    array([ 2.,  3.,  6.])
+
+    The mean of each group:
+
+    >>> np.add.reduceby(a, labels) / np.bincount(labels)
+    array([ 1.5,  3. ,  5. ])
+
+    Labels without elements:
+
+    >>> np.multiply.reduceby(a, labels, minlength=4)
+    array([  2.,   3.,  24.,   1.])
+    >>> np.minimum.reduceby(a, labels, out=np.repeat(np.inf, 4))
+    array([  1.,   3.,   4.,  inf])
+
+    """))
+
 add_newdoc('numpy.core', 'ufunc', ('outer',
     """
     outer(A, B)
@@ -206,6 +206,7 @@ cmplx = 'FDG'
 cmplxO = cmplx + O
 cmplxP = cmplx + P
 inexact = flts + cmplx
+inexactvec = 'fd'
 noint = inexact+O
 nointP = inexact+P
 allP = bints+times+flts+cmplxP
@@ -685,7 +686,9 @@ defdict = {
     Ufunc(1, 1, None,
           docstrings.get('numpy.core.umath.sqrt'),
           None,
-          TD(inexact, f='sqrt', astype={'e':'f'}),
+          TD('e', f='sqrt', astype={'e':'f'}),
+          TD(inexactvec),
+          TD('g'+cmplx, f='sqrt'),
           TD(P, f='sqrt'),
           ),
 'ceil' :
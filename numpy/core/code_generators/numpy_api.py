@@ -344,6 +344,8 @@ multiarray_funcs_api = {
     'NpyNA_FromDTypeAndPayload':            304,
     'PyArray_AllowNAConverter':             305,
     'PyArray_OutputAllowNAConverter':       306,
+    'PyDataMem_SetHandler':                 307,
+    'PyDataMem_GetHandler':                 308,
 }
 
 ufunc_types_api = {
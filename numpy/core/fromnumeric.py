@@ -3,7 +3,8 @@ __docformat__ = "restructuredtext en"
 
 # functions that are now methods
 __all__ = ['take', 'reshape', 'choose', 'repeat', 'put',
-           'swapaxes', 'transpose', 'sort', 'argsort', 'argmax', 'argmin',
+           'swapaxes', 'transpose', 'sort', 'argsort', 'partition',
+           'argpartition', 'argmax', 'argmin',
            'searchsorted', 'alen',
            'resize', 'diagonal', 'trace', 'ravel', 'nonzero', 'shape',
            'compress', 'clip', 'sum', 'product', 'prod', 'sometrue', 'alltrue',
@@ -499,7 +500,7 @@ def sort(a, axis=-1, kind='quicksort', order=None):
     axis : int or None, optional
         Axis along which to sort. If None, the array is flattened before
         sorting. The default is -1, which sorts along the last axis.
-    kind : {'quicksort', 'mergesort', 'heapsort'}, optional
+    kind : {'quicksort', 'mergesort', 'heapsort', 'radix'}, optional
         Sorting algorithm. Default is 'quicksort'.
     order : list, optional
         When `a` is a structured array, this argument specifies which fields
@@ -523,17 +524,24 @@ def sort(a, axis=-1, kind='quicksort', order=None):
     The various sorting algorithms are characterized by their average speed,
     worst case performance, work space size, and whether they are stable. A
     stable sort keeps items with the same key in the same relative
-    order. The three available algorithms have the following
+    order. The four available algorithms have the following
     properties:
 
     =========== ======= ============= ============ =======
        kind      speed   worst case    work space  stable
     =========== ======= ============= ============ =======
-    'quicksort'    1     O(n^2)            0          no
+    'quicksort'    1     O(n*log(n))       0          no
     'mergesort'    2     O(n*log(n))      ~n/2        yes
     'heapsort'     3     O(n*log(n))       0          no
+    'radix'        1     O(n)             ~n          yes
     =========== ======= ============= ============ =======
 
+    'quicksort' is an introsort, it switches to heapsort for partitions
+    which recurse too deep. 'radix' is a least significant digit radix
+    sort, on large integer arrays it is the fastest of the four. It is
+    only implemented for boolean and integer arrays, the other types use
+    'mergesort' instead.
+
     All the sort algorithms make temporary copies of the data when
     sorting along any but the last axis.  Consequently, sorting along
     the last axis is faster and uses less space than sorting along
@@ -611,7 +619,7 @@ def argsort(a, axis=-1, kind='quicksort', order=None):
     axis : int or None, optional
         Axis along which to sort.  The default is -1 (the last axis). If None,
         the flattened array is used.
-    kind : {'quicksort', 'mergesort', 'heapsort'}, optional
+    kind : {'quicksort', 'mergesort', 'heapsort', 'radix'}, optional
         Sorting algorithm.
     order : list, optional
         When `a` is an array with fields defined, this argument specifies
@@ -681,6 +689,153 @@ def argsort(a, axis=-1, kind='quicksort', order=None):
     return argsort(axis, kind, order)
 
 
+def partition(a, kth, axis=-1, kind='introselect', order=None):
+    """
+    Return a partitioned copy of an array.
+
+    Creates a copy of the array with its elements rearranged in such a way
+    that the value of the element in kth position is in the position it
+    would be in a sorted array. All elements smaller than the kth element
+    are moved before this element and all equal or greater are moved
+    behind it. The ordering of the elements in the two partitions is
+    undefined.
+
+    Parameters
+    ----------
+    a : array_like
+        Array to be sorted.
+    kth : int or sequence of ints
+        Element index to partition by. The kth value of the element will
+        be in its final sorted position and all smaller elements will be
+        moved before it and all equal or greater elements behind it. If
+        provided with a sequence of kth it will partition all elements
+        indexed by kth of them into their sorted position at once.
+    axis : int or None, optional
+        Axis along which to sort. If None, the array is flattened before
+        sorting. The default is -1, which sorts along the last axis.
+    kind : {'introselect'}, optional
+        Selection algorithm. Default is 'introselect'.
+    order : list, optional
+        When `a` is a structured array, this argument specifies which fields
+        to compare first, second, and so on.  This list does not need to
+        include all of the fields.
+
+    Returns
+    -------
+    partitioned_array : ndarray
+        Array of the same type and shape as `a`.
+
+    See Also
+    --------
+    ndarray.partition : Method to sort an array in-place.
+    argpartition : Indirect partition.
+    sort : Full sorting
+
+    Notes
+    -----
+    The various selection algorithms are characterized by their average
+    speed, worst case performance, work space size, and whether they are
+    stable. A stable sort keeps items with the same key in the same
+    relative order. The available algorithms have the following
+    properties:
+
+    ================= ======= ============= ============ =======
+       kind            speed   worst case    work space  stable
+    ================= ======= ============= ============ =======
+    'introselect'        1        O(n)           0          no
+    ================= ======= ============= ============ =======
+
+    All the partition algorithms make temporary copies of the data when
+    partitioning along any but the last axis.  Consequently, partitioning
+    along the last axis is faster and uses less space than partitioning
+    along any other axis.
+
+    The sort order for complex numbers and nans is the same as for `sort`.
+    Arrays of other than the numeric types are partitioned by sorting
+    them.
+
+    Examples
+    --------
+    >>> a = np.array([7, 1, 5, 3, 8, 2])
+    >>> p = np.partition(a, 2)
+    >>> p[2]
+    3
+    >>> np.all(p[:2] <= p[2]) and np.all(p[3:] >= p[2])
+    True
+
+    The median of an array with an odd number of elements:
+
+    >>> b = np.array([7, 1, 5, 3, 8])
+    >>> np.partition(b, len(b) // 2)[len(b) // 2]
+    5
+
+    """
+    if axis is None:
+        a = asanyarray(a).flatten()
+        axis = 0
+    else:
+        a = asanyarray(a).copy()
+    a.partition(kth, axis=axis, kind=kind, order=order)
+    return a
+
+
+def argpartition(a, kth, axis=-1, kind='introselect', order=None):
+    """
+    Perform an indirect partition along the given axis using the algorithm
+    specified by the `kind` keyword. It returns an array of indices of the
+    same shape as `a` that index data along the given axis in partitioned
+    order.
+
+    Parameters
+    ----------
+    a : array_like
+        Array to sort.
+    kth : int or sequence of ints
+        Element index to partition by. The kth element will be in its final
+        sorted position and all smaller elements will be moved before it and
+        all larger elements behind it. If provided with a sequence of kth
+        it will partition all of them into their sorted position at once.
+    axis : int or None, optional
+        Axis along which to sort.  The default is -1 (the last axis). If None,
+        the flattened array is used.
+    kind : {'introselect'}, optional
+        Selection algorithm. Default is 'introselect'
+    order : list, optional
+        When `a` is an array with fields defined, this argument specifies
+        which fields to compare first, second, etc.  Not all fields need be
+        specified.
+
+    Returns
+    -------
+    index_array : ndarray, int
+        Array of indices that partition `a` along the specified axis.
+        In other words, ``a[index_array]`` yields a partitioned `a`.
+
+    See Also
+    --------
+    partition : Describes partition algorithms used.
+    ndarray.partition : Inplace partition.
+    argsort : Full indirect sort
+
+    Examples
+    --------
+    One dimensional array:
+
+    >>> x = np.array([7, 1, 5, 3, 8, 2])
+    >>> i = np.argpartition(x, 2)
+    >>> x[i[2]]
+    3
+    >>> np.all(x[i[:2]] <= 3) and np.all(x[i[3:]] >= 3)
+    True
+
+    """
+    try:
+        argpartition = a.argpartition
+    except AttributeError:
+        return _wrapit(a, 'argpartition', kth, axis, kind, order)
+    return argpartition(kth, axis, kind=kind, order=order)
+
+
 def argmax(a, axis=None):
     """
     Indices of the maximum values along an axis.
@@ -37,6 +37,12 @@
 #define NPY_MAXDIMS 32
 #define NPY_MAXARGS 32
 
+/*
+ * The dimensions and strides of arrays with at most this many dimensions
+ * are stored in the array object, saving an allocation per array.
+ */
+#define NPY_MAXINLINEDIMS 4
+
 /* Used for Converter Functions "O&" code in ParseTuple */
 #define NPY_FAIL 0
 #define NPY_SUCCEED 1
@@ -155,11 +161,22 @@ enum NPY_TYPECHAR {
 typedef enum {
         NPY_QUICKSORT=0,
         NPY_HEAPSORT=1,
-        NPY_MERGESORT=2
+        NPY_MERGESORT=2,
+        NPY_RADIXSORT=3
 } NPY_SORTKIND;
+/*
+ * The number of sort kinds with a slot in PyArray_ArrFuncs. The radix
+ * sorts only exist for the integer types and are looked up separately.
+ */
 #define NPY_NSORTS (NPY_MERGESORT + 1)
 
 
+typedef enum {
+        NPY_INTROSELECT=0
+} NPY_SELECTKIND;
+#define NPY_NSELECTS (NPY_INTROSELECT + 1)
+
+
 typedef enum {
         NPY_SEARCHLEFT=0,
         NPY_SEARCHRIGHT=1
@@ -341,6 +358,22 @@ NpyMaskValue_Create(npy_bool exposed, npy_uint8 payload)
 #define PyDataMem_FREE(ptr)  free(ptr)
 #define PyDataMem_RENEW(ptr,size) ((char *)realloc(ptr,size))
 
+  /*
+   * An allocator of the data buffers of arrays, see PyDataMem_SetHandler.
+   * The functions get ctx as their first argument and may be called without
+   * the GIL. free gets the size the buffer was last allocated with, or the
+   * number of bytes of its array if that is less.
+   */
+typedef struct {
+    /* A name for the allocator, shown to Python */
+    char name[128];
+    void *ctx;
+    void *(*malloc)(void *ctx, size_t size);
+    void *(*calloc)(void *ctx, size_t nelem, size_t elsize);
+    void *(*realloc)(void *ctx, void *ptr, size_t new_size);
+    void (*free)(void *ctx, void *ptr, size_t size);
+} PyDataMem_Handler;
+
 #define NPY_USE_PYMEM 1
 
 #if NPY_USE_PYMEM == 1
@@ -403,6 +436,10 @@ typedef int (PyArray_FillFunc)(void *, npy_intp, void *);
 
 typedef int (PyArray_SortFunc)(void *, npy_intp, void *);
 typedef int (PyArray_ArgSortFunc)(void *, npy_intp *, npy_intp, void *);
+typedef int (PyArray_PartitionFunc)(void *, npy_intp, npy_intp *, npy_intp,
+                                    void *);
+typedef int (PyArray_ArgPartitionFunc)(void *, npy_intp *, npy_intp,
+                                       npy_intp *, npy_intp, void *);
 
 typedef int (PyArray_FillWithScalarFunc)(void *, npy_intp, void *, void *);
 
@@ -687,6 +724,18 @@ typedef struct tagPyArrayObject_fields {
      * of whether there is an NA mask or not.
      */
     npy_intp *maskna_strides;
+    /*
+     * The allocator of the data buffer if the array owns it and NumPy
+     * allocated it, otherwise NULL, and an owned buffer is freed with
+     * PyDataMem_FREE.
+     */
+    const PyDataMem_Handler *mem_handler;
+    /*
+     * The buffer dimensions points to if there are at most
+     * NPY_MAXINLINEDIMS dimensions, otherwise it is allocated with
+     * PyDimMem_NEW.
+     */
+    npy_intp inline_dims[3 * NPY_MAXINLINEDIMS];
 } PyArrayObject_fields;
 
 /*
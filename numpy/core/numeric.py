@@ -16,6 +16,10 @@ __all__ = ['newaxis', 'ndarray', 'flatiter', 'nditer', 'nested_iters', 'ufunc',
            'load', 'loads', 'isscalar', 'binary_repr', 'base_repr',
            'ones', 'identity', 'allclose', 'compare_chararrays', 'putmask',
            'seterr', 'geterr', 'setbufsize', 'getbufsize',
+           'setnumthreads', 'getnumthreads', 'evaluate',
+           'setdatacache', 'getdatacache', 'datacachestats',
+           'setallocpolicy', 'getallocpolicy', 'allocpolicy',
+           'setdatatrace', 'datatracestats', 'getdatahandler',
            'seterrcall', 'geterrcall', 'errstate', 'flatnonzero',
            'Inf', 'inf', 'infty', 'Infinity',
            'nan', 'NaN', 'False_', 'True_', 'bitwise_not',
@@ -23,6 +27,7 @@ __all__ = ['newaxis', 'ndarray', 'flatiter', 'nditer', 'nested_iters', 'ufunc',
            'ComplexWarning']
 
 import sys
+import math
 import warnings
 import multiarray
 import umath
@@ -714,7 +719,129 @@ def _mode_from_name(mode):
         return _mode_from_name_dict[mode.lower()[0]]
     return mode
 
-def correlate(a, v, mode='valid', old_behavior=False):
+# The time of an FFT of size N, with the copies around it, is about
+# _fft_cost * N * (log2(N) + 6) multiply-adds of the direct sum, and that of
+# the setup about _fft_overhead of them
+_fft_cost = 4
+_fft_overhead = 20000
+
+def _fft_good_size(n):
+    """The smallest size of at least n with only the factors 2, 3 and 5."""
+    best = 1
+    while best < n:
+        best *= 2
+    p5 = 1
+    while p5 < best:
+        p35 = p5
+        while p35 < best:
+            p = p35
+            while p < n:
+                p *= 2
+            best = min(best, p)
+            p35 *= 3
+        p5 *= 5
+    return best
+
+def _fft_plan(n, m, cost):
+    """
+    The fastest FFT size for convolving sequences of lengths n >= m, or
+    None if its cost is above the given one. Sizes below n + m - 1 split
+    the long sequence into blocks which are overlapped and added.
+    """
+    full = _fft_good_size(n + m - 1)
+    sizes = [full]
+    size = 1
+    while size < 2*m:
+        size *= 2
+    while size < full:
+        sizes.append(size)
+        size *= 2
+    best = None
+    for size in sizes:
+        nblocks = -(-n // (size - m + 1))
+        c = (_fft_overhead +
+             _fft_cost * nblocks * size * (math.log(size, 2) + 6))
+        if c < cost:
+            best, cost = size, c
+    return best
+
+def _fft_convolve(a, v, size, dtype):
+    """
+    The full convolution of the 1-d arrays a and v, with len(a) >= len(v),
+    through FFTs of the given size, see _fft_plan.
+    """
+    from numpy.fft import rfft, irfft, fft, ifft
+    n, m = len(a), len(v)
+    if dtype.kind == 'c':
+        forward, inverse = fft, ifft
+        work = dtype.type(0)
+    else:
+        forward, inverse = rfft, irfft
+        work = float(0)
+    vf = forward(v, size)
+    step = size - m + 1
+    nblocks = -(-n // step)
+    out = zeros((nblocks + 1) * step, result_type(work, float))
+    # bound the temporaries to a few MB
+    group = max(1, (1 << 18) // size)
+    for i in range(0, nblocks, group):
+        j = min(i + group, nblocks)
+        blocks = zeros((j - i, step), a.dtype)
+        segment = a[i*step:j*step]
+        blocks.flat[:len(segment)] = segment
+        y = inverse(forward(blocks, size) * vf, size)
+        out[i*step:j*step] += y[:, :step].ravel()
+        tails = out[(i + 1)*step:(j + 1)*step].reshape(j - i, step)
+        tails[:, :m - 1] += y[:, step:step + m - 1]
+    out = out[:n + m - 1]
+    if dtype.kind in 'iu':
+        out = umath.rint(out)
+    return out.astype(dtype)
+
+def _fft_method(a, v, mode, method):
+    """
+    Check the method of correlate and convolve, and return the FFT size to
+    use for the arrays a and v, or None for the direct sum.
+    """
+    if method not in ('auto', 'direct', 'fft'):
+        raise ValueError("method must be 'auto', 'direct' or 'fft'")
+    if method == 'direct' or a.ndim != 1 or v.ndim != 1:
+        return None
+    dtype = result_type(a, v)
+    if dtype.kind not in 'iufc':
+        if method == 'fft':
+            raise TypeError("the FFT cannot convolve %s" % dtype)
+        return None
+    n, m = max(len(a), len(v)), min(len(a), len(v))
+    if m == 0:
+        return None
+    if method == 'fft':
+        return _fft_plan(n, m, float('inf'))
+    # the sums of integers stay exact
+    if dtype.kind not in 'fc':
+        return None
+    nout = (n - m + 1, n, n + m - 1)[mode]
+    return _fft_plan(n, m, nout * m)
+
+def _fft_mode(full, n, m, mode, inverted=False):
+    """
+    Cut the output of a mode out of the full convolution, inverted is set
+    for a correlation whose first sequence is the shorter one, whose
+    output the direct sum computes backwards.
+    """
+    if n < m:
+        n, m = m, n
+    if mode == 0:
+        return full[m - 1:n]
+    elif mode == 1:
+        if inverted:
+            start = m // 2
+        else:
+            start = (m - 1) - m // 2
+        return full[start:start + n]
+    return full
+
+def correlate(a, v, mode='valid', old_behavior=False, method='auto'):
     """
     Cross-correlation of two 1-dimensional sequences.
 
@@ -737,6 +864,8 @@ def correlate(a, v, mode='valid', old_behavior=False):
         If True, uses the old behavior from Numeric, (correlate(a,v) == correlate(v,
         a), and the conjugate is not taken for complex arrays). If False, uses
         the conventional signal processing definition (see note).
+    method : {'auto', 'direct', 'fft'}, optional
+        Refer to the `convolve` docstring.
 
     See Also
     --------
@@ -764,10 +893,18 @@ The new behavior fits the conventional definition of correlation: inputs are
 never swapped, and the second argument is conjugated for complex arrays.""",
             DeprecationWarning)
         return multiarray.correlate(a,v,mode)
-    else:
+    a, v = asarray(a), asarray(v)
+    size = _fft_method(a, v, mode, method)
+    if size is None:
         return multiarray.correlate2(a,v,mode)
+    v = v[::-1].conj()
+    if len(a) >= len(v):
+        full = _fft_convolve(a, v, size, result_type(a, v))
+    else:
+        full = _fft_convolve(v, a, size, result_type(a, v))
+    return _fft_mode(full, len(a), len(v), mode, len(a) < len(v))
 
-def convolve(a,v,mode='full'):
+def convolve(a,v,mode='full',method='auto'):
     """
     Returns the discrete, linear convolution of two one-dimensional sequences.
 
@@ -799,6 +936,12 @@ def convolve(a,v,mode='full'):
           ``max(M, N) - min(M, N) + 1``.  The convolution product is only given
           for points where the signals overlap completely.  Values outside
           the signal boundary have no effect.
+    method : {'auto', 'direct', 'fft'}, optional
+        'direct' sums the products, 'fft' multiplies the Fourier transforms
+        of the zero padded sequences, splitting a long sequence into blocks
+        when that is faster.  By default, 'auto' uses the FFT when it is
+        estimated to be faster, for floating point and complex inputs.
+        The FFT results differ from the direct sums by rounding errors.
 
     Returns
     -------
@@ -821,8 +964,8 @@ def convolve(a,v,mode='full'):
     is equivalent to the multiplication :math:`X(f) Y(f)` in the Fourier
     domain, after appropriate padding (padding is necessary to prevent
     circular convolution).  Since multiplication is more efficient (faster)
-    than convolution, the function `scipy.signal.fftconvolve` exploits the
-    FFT to calculate the convolution of large data-sets.
+    than convolution, the `fft` method exploits the FFT to calculate the
+    convolution of large data-sets.
 
     References
     ----------
@@ -858,7 +1001,11 @@ def convolve(a,v,mode='full'):
     if len(v) == 0 :
         raise ValueError('v cannot be empty')
     mode = _mode_from_name(mode)
-    return multiarray.correlate(a, v[::-1], mode)
+    size = _fft_method(a, v, mode, method)
+    if size is None:
+        return multiarray.correlate(a, v[::-1], mode)
+    full = _fft_convolve(a, v, size, result_type(a, v))
+    return _fft_mode(full, len(a), len(v), mode)
 
 def outer(a,b):
     """
@@ -2401,6 +2548,489 @@ def getbufsize():
     """
     return umath.geterrobj()[0]
 
+def setnumthreads(n):
+    """
+    Set the number of threads used to run large ufunc loops and sorts.
+
+    Elementwise operations, reductions and sorts over large arrays are
+    split into pieces which run concurrently. The setting applies to the whole
+    process, the default of 1 runs every loop in the calling thread. On
+    platforms without thread support the value is ignored.
+
+    Parameters
+    ----------
+    n : int
+        Number of threads, between 1 and 256.
+
+    Returns
+    -------
+    old : int
+        The previous number of threads.
+
+    See Also
+    --------
+    getnumthreads
+
+    Notes
+    -----
+    Loops and sorts operating on object arrays, and loops whose output
+    overlaps one of the inputs, always run in a single thread. Sums of floating
+    point numbers may differ in the last bits from the single threaded
+    result, as the additions happen in a different order.
+
+    """
+    return umath.setnumthreads(n)
+
+def getnumthreads():
+    """Return the number of threads used to run large ufunc loops.
+    """
+    return umath.getnumthreads()
+
+def setdatacache(nbytes):
+    """
+    Set the size of the cache of array data buffers.
+
+    The data buffers of arrays of 64 KiB and more are kept in a cache when
+    the arrays are deallocated, and new arrays take their data from it.
+    This saves the system allocator from mapping and faulting in fresh
+    pages for every temporary array of such a size. The cache is shared by
+    all threads of the process and is disabled by default.
+
+    Parameters
+    ----------
+    nbytes : int
+        The number of bytes the cache holds at most. 0 disables the cache
+        and frees the buffers it holds.
+
+    Returns
+    -------
+    old : int
+        The previous size of the cache.
+
+    See Also
+    --------
+    getdatacache, datacachestats
+
+    Notes
+    -----
+    The cache helps most with arrays larger than the system allocator keeps
+    in its heap, which it maps and unmaps again for every allocation, such
+    as arrays of more than 32 MiB with glibc. A buffer taken from the cache
+    is not cleared, like the memory returned by `empty` its contents are
+    arbitrary.
+
+    """
+    return multiarray.setdatacache(nbytes)
+
+def getdatacache():
+    """Return the number of bytes the cache of array data buffers holds at most.
+    """
+    return multiarray.getdatacache()
+
+def datacachestats():
+    """
+    Return statistics of the cache of array data buffers.
+
+    Returns
+    -------
+    stats : dict
+        With the keys 'maxbytes', the size of the cache, 'nbytes' and
+        'nblocks', the bytes and buffers it holds, 'hits' and 'misses', the
+        number of allocations served from the cache and from the system, and
+        'evictions', the number of buffers freed to make room for others.
+
+    See Also
+    --------
+    setdatacache
+
+    """
+    return multiarray.datacachestats()
+
+def setallocpolicy(align=None, hugepage_min=None):
+    """
+    Set how the data buffers of new arrays are allocated.
+
+    By default the data of an array is only as aligned as the system
+    allocator makes it, 16 bytes on most platforms. Aligning it to the
+    cache lines keeps vectorized loops from loading and storing items that
+    straddle two lines. Very large arrays may further be backed by huge
+    pages, which reduces the TLB misses of going through them. The policy
+    applies to the whole process.
+
+    Parameters
+    ----------
+    align : int, optional
+        The alignment of the data buffers in bytes, a power of two between
+        the size of a pointer and 2 MiB, or 0 for the alignment of the
+        system allocator.
+    hugepage_min : int, optional
+        The data buffers of at least this many bytes are aligned to 2 MiB
+        and the system is asked to back them by huge pages. 0 never does.
+
+    Returns
+    -------
+    old_policy : dict
+        Dictionary containing the old settings.
+
+    See Also
+    --------
+    getallocpolicy, allocpolicy
+
+    Notes
+    -----
+    The policy applies to arrays allocating their data, not to views. It
+    is ignored on platforms without ``posix_memalign``, and huge pages are
+    only requested on Linux, where they must be enabled for ``madvise`` in
+    ``/sys/kernel/mm/transparent_hugepage/enabled``. An array keeps the
+    alignment of its buffer when it is resized only if the system allocator
+    preserves it.
+
+    Examples
+    --------
+    >>> old = np.setallocpolicy(align=64)
+    >>> np.empty(1000).ctypes.data % 64
+    0
+    >>> np.setallocpolicy(**old)
+    {'align': 64, 'hugepage_min': 0}
+
+    """
+    old = getallocpolicy()
+    if align is None:
+        align = old['align']
+    if hugepage_min is None:
+        hugepage_min = old['hugepage_min']
+    multiarray.setallocpolicy(align, hugepage_min)
+    return old
+
+def getallocpolicy():
+    """
+    Get how the data buffers of new arrays are allocated.
+
+    Returns
+    -------
+    policy : dict
+        A dictionary with the keys 'align' and 'hugepage_min', see
+        `setallocpolicy`.
+
+    See Also
+    --------
+    setallocpolicy, allocpolicy
+
+    """
+    align, hugepage_min = multiarray.getallocpolicy()
+    return {'align': align, 'hugepage_min': hugepage_min}
+
+class allocpolicy(object):
+    """
+    allocpolicy(**kwargs)
+
+    Context manager for the allocation of array data.
+
+    Upon entering the context the allocation policy is set with
+    `setallocpolicy`, and upon exiting it is reset to what it was before.
+    The policy applies to the whole process, so arrays created by other
+    threads while the context is active follow it too.
+
+    Parameters
+    ----------
+    kwargs : {align, hugepage_min}
+        Keyword arguments, see `setallocpolicy`.
+
+    See Also
+    --------
+    setallocpolicy, getallocpolicy
+
+    Examples
+    --------
+    >>> with np.allocpolicy(align=64, hugepage_min=2**26):
+    ...     a = np.zeros(2**24)
+    ...
+    >>> a.ctypes.data % 2**21
+    0
+
+    """
+    def __init__(self, **kwargs):
+        self.kwargs = kwargs
+    def __enter__(self):
+        self.oldstate = setallocpolicy(**self.kwargs)
+    def __exit__(self, *exc_info):
+        setallocpolicy(**self.oldstate)
+
+def setdatatrace(flag):
+    """
+    Start or stop tracing the allocations of array data.
+
+    While tracing, the bytes of the data buffers of arrays are recorded by
+    the line of Python code which allocated them, the innermost line being
+    executed, to find where the memory of a program goes. Starting to trace
+    clears the statistics of an earlier run, except for the buffers of it
+    which are still in use.
+
+    Parameters
+    ----------
+    flag : bool
+        Whether to trace.
+
+    Returns
+    -------
+    old : bool
+        Whether allocations were traced before.
+
+    See Also
+    --------
+    datatracestats, getdatahandler
+
+    Notes
+    -----
+    Tracing works by installing an allocator which records the buffers and
+    passes them on to the allocator installed before, so it slows down
+    the allocation of arrays. When an extension installs another allocator
+    while tracing, stopping leaves that allocator in place. Only the
+    buffers allocated by NumPy are traced, not those of arrays wrapping
+    the memory of other objects.
+
+    Examples
+    --------
+    >>> old = np.setdatatrace(True)
+    >>> a = np.empty(1000)
+    >>> np.datatracestats()['current']
+    8000
+    >>> np.setdatatrace(old)
+    True
+
+    """
+    return multiarray.setdatatrace(bool(flag))
+
+def datatracestats():
+    """
+    Return the statistics of tracing the allocations of array data.
+
+    Returns
+    -------
+    stats : dict
+        With the keys 'current' and 'peak', the bytes of the traced buffers
+        in use and the most that were in use at once since tracing started,
+        and 'sites', a dictionary mapping the ``(filename, lineno)`` of each
+        line which allocated buffers to a tuple of the number and the bytes
+        of its allocations, and the bytes of its buffers in use now and at
+        most.
+
+    See Also
+    --------
+    setdatatrace
+
+    """
+    return multiarray.datatracestats()
+
+def getdatahandler():
+    """
+    Return the name of the allocator of the data of new arrays.
+
+    The default allocator is 'default_allocator', and 'tracing_allocator'
+    while `setdatatrace` is on. Extensions may install other allocators
+    with ``PyDataMem_SetHandler``.
+
+    """
+    return multiarray.getdatahandler()
+
+class _EvalNode(object):
+    # A node of the expression graph built by evaluate, either a leaf
+    # holding an operand or the call of a ufunc on other nodes.
+    def __init__(self, ufunc=None, args=(), value=None):
+        self.ufunc = ufunc
+        self.args = args
+        self.value = value
+
+def _eval_node(x):
+    if isinstance(x, _EvalNode):
+        return x
+    return _EvalNode(value=x)
+
+def _eval_unary(ufunc):
+    return lambda self: _EvalNode(ufunc, (self,))
+
+def _eval_binary(ufunc, reflected=False):
+    if reflected:
+        return lambda self, other: _EvalNode(ufunc, (_eval_node(other), self))
+    return lambda self, other: _EvalNode(ufunc, (self, _eval_node(other)))
+
+for _name, _ufunc in [('add', add), ('sub', subtract), ('mul', multiply),
+                      ('div', divide), ('truediv', true_divide),
+                      ('floordiv', floor_divide), ('mod', remainder),
+                      ('pow', power), ('and', bitwise_and),
+                      ('or', bitwise_or), ('xor', bitwise_xor),
+                      ('lshift', left_shift), ('rshift', right_shift)]:
+    setattr(_EvalNode, '__%s__' % _name, _eval_binary(_ufunc))
+    setattr(_EvalNode, '__r%s__' % _name, _eval_binary(_ufunc, True))
+for _name, _ufunc in [('neg', negative), ('abs', absolute),
+                      ('invert', invert)]:
+    setattr(_EvalNode, '__%s__' % _name, _eval_unary(_ufunc))
+
+# The comparisons give booleans and the logical operators need a truth
+# value, neither fits an expression computed in a single type.
+def _eval_unsupported(what):
+    def unsupported(self, *args):
+        raise TypeError("%s are not supported by evaluate" % what)
+    return unsupported
+
+for _name in ['lt', 'le', 'gt', 'ge', 'eq', 'ne']:
+    setattr(_EvalNode, '__%s__' % _name, _eval_unsupported('comparisons'))
+for _name in ['nonzero', 'bool']:
+    setattr(_EvalNode, '__%s__' % _name,
+            _eval_unsupported('and, or and not'))
+del _name, _ufunc
+
+def _eval_function(ufunc):
+    def call(*args):
+        if len(args) != ufunc.nin:
+            raise TypeError("%s takes %d arguments" % (ufunc.__name__,
+                                                       ufunc.nin))
+        return _EvalNode(ufunc, tuple([_eval_node(x) for x in args]))
+    return call
+
+def _eval_compile(root, nin):
+    # Turns the graph into a program for umath._evaluate, the calls in
+    # post-order. The inputs have the slots 0 to nin - 1 and the output
+    # the slot nin, an intermediate result gets a buffer slot after that
+    # which is free again after its last use.
+    order, uses = [], {}
+    def visit(node):
+        if id(node) in uses:
+            uses[id(node)] += 1
+            return
+        uses[id(node)] = 1
+        for arg in node.args:
+            if arg.ufunc is not None:
+                visit(arg)
+        order.append(node)
+    visit(root)
+
+    program, free, ntemps = [], [], 0
+    for node in order:
+        slots = [arg.slot for arg in node.args]
+        for arg in node.args:
+            if arg.ufunc is not None:
+                uses[id(arg)] -= 1
+                if uses[id(arg)] == 0:
+                    free.append(arg.slot)
+        if node is root:
+            node.slot = nin
+        elif free:
+            node.slot = free.pop()
+        else:
+            ntemps += 1
+            node.slot = nin + ntemps
+        program.append((node.ufunc, tuple(slots + [node.slot])))
+    return tuple(program)
+
+def evaluate(ex, local_dict=None, global_dict=None, out=None, dtype=None):
+    """
+    Evaluate an element-wise array expression in a single pass.
+
+    The expression is computed with the ufunc loops one block of elements
+    at a time, so the intermediate results only need small buffers, which
+    stay in the cache, instead of a temporary array each. For large arrays
+    this is faster and uses less memory than evaluating the expression
+    directly.
+
+    Parameters
+    ----------
+    ex : str
+        The expression, made of names, numbers, the arithmetic and bitwise
+        operators and calls of ufuncs with one output such as ``sin`` or
+        ``maximum``, which are looked up by name.
+    local_dict, global_dict : dict, optional
+        Where the names of the operands are looked up, by default the
+        local and global variables of the caller.
+    out : ndarray, optional
+        Array to store the result in. It must have the broadcast shape of
+        the operands.
+    dtype : data-type, optional
+        The type of every operation of the expression. By default it is
+        the result type of the operands, see `result_type`.
+
+    Returns
+    -------
+    out : ndarray
+        The result of the expression.
+
+    See Also
+    --------
+    setbufsize : the number of elements in a block.
+
+    Notes
+    -----
+    Unlike the direct evaluation, all the operations of the expression are
+    done in `dtype`, the operands are cast to it with the 'same_kind' rule.
+    Operations which give a different type, like the comparisons, are
+    not supported, nor are ``and``, ``or`` and ``not``, use ``&``, ``|``
+    and ``~`` instead.
+
+    Examples
+    --------
+    >>> a = np.arange(5.)
+    >>> b = np.ones(5)
+    >>> np.evaluate("2*a + sin(b)**2")
+    array([ 0.70807342,  2.70807342,  4.70807342,  6.70807342,  8.70807342])
+
+    """
+    if local_dict is None or global_dict is None:
+        frame = sys._getframe(1)
+        if local_dict is None:
+            local_dict = frame.f_locals
+        if global_dict is None:
+            global_dict = frame.f_globals
+        del frame
+
+    code = compile(ex, '<evaluate>', 'eval')
+    namespace = {'abs': _eval_unary(absolute)}
+    for name in code.co_names:
+        if name in namespace:
+            continue
+        if name in local_dict:
+            value = local_dict[name]
+        elif name in global_dict:
+            value = global_dict[name]
+        elif isinstance(getattr(umath, name, None), ufunc):
+            value = getattr(umath, name)
+        else:
+            raise NameError("name '%s' is not defined" % name)
+        if isinstance(value, ufunc):
+            if value.nout != 1:
+                raise TypeError("ufunc '%s' has more than one output" %
+                                value.__name__)
+            namespace[name] = _eval_function(value)
+        else:
+            namespace[name] = _EvalNode(value=value)
+    root = _eval_node(eval(code, {'__builtins__': None}, namespace))
+
+    # collect the leaves, constants are operands as well
+    operands, seen, stack = [], set(), [root]
+    while stack:
+        node = stack.pop()
+        if id(node) in seen:
+            continue
+        seen.add(id(node))
+        if node.ufunc is None:
+            node.slot = len(operands)
+            operands.append(node.value)
+        else:
+            stack.extend(node.args)
+    if dtype is None:
+        dtype = result_type(*operands)
+
+    if root.ufunc is None:
+        if out is not None:
+            out[...] = root.value
+            return out
+        result = array(root.value, dtype=dtype)
+    else:
+        program = _eval_compile(root, len(operands))
+        result = umath._evaluate(program, tuple(operands), dtype, out)
+    if out is None and result.ndim == 0:
+        return result[()]
+    return result
+
 def seterrcall(func):
     """
     Set the floating-point error callback function or log object.
@@ -160,11 +160,21 @@ def check_math_capabilities(config, moredefs, mathlibs):
                 OPTIONAL_STDFUNCS.remove(f)
 
     check_funcs(OPTIONAL_STDFUNCS)
+    check_funcs(OPTIONAL_SYSFUNCS)
 
     # C99 functions: float and long double versions
     check_funcs(C99_FUNCS_SINGLE)
     check_funcs(C99_FUNCS_EXTENDED)
 
+    for f, args in OPTIONAL_INTRINSICS:
+        if config.check_func(f, decl=False, call=True, call_args=args):
+            moredefs.append((fname2def(f), 1))
+
+    for dec, fn, code, header in OPTIONAL_FUNCTION_ATTRIBUTES_WITH_INTRINSICS:
+        if config.check_gcc_function_attribute_with_intrinsics(dec, fn, code,
+                                                               header):
+            moredefs.append((fname2def(fn), 1))
+
 def check_complex(config, mathlibs):
     priv = []
     pub = []
@@ -671,7 +681,9 @@ def configuration(parent_package='',top_path=None):
 
     # This library is created for the build but it is not installed
     config.add_library('npysort',
-            sources = [join('src', 'npysort', 'sort.c.src')])
+            sources = [join('src', 'npysort', 'sort.c.src'),
+                       join('src', 'npysort', 'selection.c.src'),
+                       join('src', 'npysort', 'binsearch.c.src')])
 
     #######################################################################
     #                        multiarray module                            #
@@ -689,7 +701,8 @@ def configuration(parent_package='',top_path=None):
                    join(local_dir, subpath, 'nditer_templ.c.src'),
                    join(local_dir, subpath, 'lowlevel_strided_loops.c.src'),
                    join(local_dir, subpath, 'boolean_ops.c.src'),
-                   join(local_dir, subpath, 'einsum.c.src')]
+                   join(local_dir, subpath, 'einsum.c.src'),
+                   join(local_dir, subpath, 'gemm.c.src')]
 
         # numpy.distutils generate .c from .c.src in weird directories, we have
         # to add them there as they depend on the build_dir
@@ -699,6 +712,7 @@ def configuration(parent_package='',top_path=None):
         cmd.template_sources(sources, ext)
 
     multiarray_deps = [
+            join('src', 'multiarray', 'alloc.h'),
             join('src', 'multiarray', 'arrayobject.h'),
             join('src', 'multiarray', 'arraytypes.h'),
             join('src', 'multiarray', 'array_assign.h'),
@@ -710,8 +724,11 @@ def configuration(parent_package='',top_path=None):
             join('src', 'multiarray', 'conversion_utils.h'),
             join('src', 'multiarray', 'ctors.h'),
             join('src', 'multiarray', 'descriptor.h'),
+            join('src', 'multiarray', 'gemm.h'),
             join('src', 'multiarray', 'getset.h'),
             join('src', 'multiarray', 'hashdescr.h'),
+            join('src', 'multiarray', 'hashtable.h'),
+            join('src', 'multiarray', 'textreading.h'),
             join('src', 'multiarray', 'iterators.h'),
             join('src', 'multiarray', 'mapping.h'),
             join('src', 'multiarray', 'methods.h'),
@@ -730,6 +747,8 @@ def configuration(parent_package='',top_path=None):
             join('src', 'multiarray', 'na_mask.h'),
             join('src', 'multiarray', 'na_object.h'),
             join('src', 'private', 'lowlevel_strided_loops.h'),
+            join('src', 'private', 'npy_threads.h'),
+            join('src', 'private', 'npy_gemm.h'),
             join('include', 'numpy', 'arrayobject.h'),
             join('include', 'numpy', '_neighborhood_iterator_imp.h'),
             join('include', 'numpy', 'npy_endian.h'),
@@ -752,6 +771,7 @@ def configuration(parent_package='',top_path=None):
             ]
 
     multiarray_src = [
+            join('src', 'multiarray', 'alloc.c'),
             join('src', 'multiarray', 'arrayobject.c'),
             join('src', 'multiarray', 'arraytypes.c.src'),
             join('src', 'multiarray', 'array_assign.c'),
@@ -773,8 +793,11 @@ def configuration(parent_package='',top_path=None):
             join('src', 'multiarray', 'dtype_transfer.c'),
             join('src', 'multiarray', 'einsum.c.src'),
             join('src', 'multiarray', 'flagsobject.c'),
+            join('src', 'multiarray', 'gemm.c.src'),
             join('src', 'multiarray', 'getset.c'),
             join('src', 'multiarray', 'hashdescr.c'),
+            join('src', 'multiarray', 'hashtable.c'),
+            join('src', 'multiarray', 'textreading.c'),
             join('src', 'multiarray', 'item_selection.c'),
             join('src', 'multiarray', 'iterators.c'),
             join('src', 'multiarray', 'lowlevel_strided_loops.c.src'),
@@ -854,12 +877,19 @@ def configuration(parent_package='',top_path=None):
     umath_src = [
             join('src', 'umath', 'umathmodule.c'),
             join('src', 'umath', 'funcs.inc.src'),
+            join('src', 'umath', 'simd.inc.src'),
             join('src', 'umath', 'loops.c.src'),
             join('src', 'umath', 'ufunc_object.c'),
-            join('src', 'umath', 'ufunc_type_resolution.c')]
+            join('src', 'umath', 'ufunc_type_resolution.c'),
+            join('src', 'umath', 'ufunc_threads.c'),
+            join('src', 'umath', 'ufunc_evaluate.c')]
 
     umath_deps = [
             generate_umath_py,
+            join('src', 'umath', 'simd.inc.src'),
+            join('src', 'umath', 'ufunc_threads.h'),
+            join('src', 'umath', 'ufunc_evaluate.h'),
+            join('src', 'private', 'npy_threads.h'),
             join(codegen_dir,'generate_ufunc_api.py')]
 
     if not ENABLE_SEPARATE_COMPILATION:
@@ -867,6 +897,7 @@ def configuration(parent_package='',top_path=None):
         umath_src = [join('src', 'umath', 'umathmodule_onefile.c')]
         umath_src.append(generate_umath_templated_sources)
         umath_src.append(join('src', 'umath', 'funcs.inc.src'))
+        umath_src.append(join('src', 'umath', 'simd.inc.src'))
 
     config.add_extension('umath',
                          sources = umath_src +
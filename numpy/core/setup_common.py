@@ -99,6 +99,33 @@ OPTIONAL_STDFUNCS = ["expm1", "log1p", "acosh", "asinh", "atanh",
 OPTIONAL_STDFUNCS_MAYBE = ["expm1", "log1p", "acosh", "atanh", "asinh", "hypot",
         "copysign"]
 
+# System functions used when available: the aligned and huge page backed
+# array data allocation of multiarray
+OPTIONAL_SYSFUNCS = ["posix_memalign", "madvise"]
+
+# Compiler builtins needed for runtime cpu feature detection, checked with
+# a call: (builtin, call arguments)
+OPTIONAL_INTRINSICS = [("__builtin_cpu_supports", '"sse2"')]
+
+# gcc function attributes enabling an instruction set for a single function,
+# together with a snippet of the corresponding intrinsics which must compile
+# inside such a function. They are used for the runtime dispatched simd loops
+# of the umath module: (attribute, name of the define, code, header)
+OPTIONAL_FUNCTION_ATTRIBUTES_WITH_INTRINSICS = [
+    ('__attribute__((target("avx2")))',
+     'attribute_target_avx2_with_intrinsics',
+     '__m256d temp = _mm256_set1_pd(1.0); temp = _mm256_add_pd(temp, temp)',
+     'immintrin.h'),
+    ('__attribute__((target("avx2,fma")))',
+     'attribute_target_avx2_fma_with_intrinsics',
+     '__m256d temp = _mm256_set1_pd(1.0); temp = _mm256_fmadd_pd(temp, temp, temp)',
+     'immintrin.h'),
+    ('__attribute__((target("avx512f")))',
+     'attribute_target_avx512f_with_intrinsics',
+     '__m512d temp = _mm512_set1_pd(1.0); temp = _mm512_add_pd(temp, temp)',
+     'immintrin.h'),
+    ]
+
 # C99 functions: float and long double versions
 C99_FUNCS = ["sin", "cos", "tan", "sinh", "cosh", "tanh", "fabs", "floor",
         "ceil", "rint", "trunc", "sqrt", "log10", "log", "log1p", "exp",
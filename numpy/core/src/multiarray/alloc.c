@@ -0,0 +1,816 @@
+/*
+ * This file implements the allocation of array data buffers.
+ *
+ * The buffers come from the current PyDataMem_Handler, and each array
+ * remembers the handler of its buffer so that a buffer is given back to
+ * the allocator it came from even after the handler has been replaced.
+ * Buffers NumPy did not allocate, owned by arrays made by other extensions,
+ * have no handler and are freed with PyDataMem_FREE. The default handler
+ * allocates with the system allocator, through the cache and under the
+ * allocation policy described below. The tracing handler wraps the handler
+ * which was current when tracing started and records the bytes allocated
+ * by each Python line.
+ *
+ * The cache holds array data buffers of the default handler. The system
+ * allocator serves blocks of some ten kilobytes and more by mapping fresh
+ * pages, or it gives them back to the system when they are freed, so
+ * every new array of that size faults its pages in again. Loops creating
+ * temporaries of the same sizes over and over spend much of their time
+ * there. array_dealloc hands the buffers of such arrays to the cache and
+ * PyArray_NewFromDescr takes them from it again.
+ *
+ * The buffers are ordinary PyDataMem_NEW blocks, so any of them may still
+ * be freed with PyDataMem_FREE or resized with PyDataMem_RENEW. The size
+ * a buffer is cached with is the one the default handler's free gets,
+ * which may be less than the size it was allocated with but never more.
+ * The sizes
+ * are divided into classes a quarter of a power of two apart, and a
+ * buffer goes to the bin of the largest class not above its size. A
+ * request is served from the bin of its class by a buffer at least as
+ * large, or by any buffer of the next class. Buffers are reused as they
+ * are, their contents are not cleared.
+ *
+ * The cache holds at most data_cache_max bytes, the buffers cached the
+ * longest time ago are freed to make room for new ones. It is empty until
+ * a size is set, as allocators like glibc's already keep blocks of up to
+ * some megabytes in their heap, and reusing the page aligned blocks they
+ * map for larger ones makes loops over several such arrays suffer from
+ * 4K aliasing. The GIL protects the cache: the default handler's malloc
+ * and free are only called when arrays are created or deallocated, which
+ * happens with the GIL held, while its realloc does not use the cache.
+ *
+ * The allocation policy asks for data buffers aligned to a given power of
+ * two, so that vectorized loops do not split cache lines, and for large
+ * buffers aligned to huge pages and backed by them, which cuts down on TLB
+ * misses. Such buffers come from posix_memalign, so they too may be freed
+ * with PyDataMem_FREE. The policy is ignored on systems without it, and
+ * huge pages are only requested on Linux through madvise. Cached buffers
+ * are only reused when they have the alignment the policy asks for.
+ *
+ * See LICENSE.txt for the license.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <frameobject.h>
+
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+#define _MULTIARRAYMODULE
+#include <numpy/arrayobject.h>
+
+#include "npy_config.h"
+#include "numpy/npy_3kcompat.h"
+
+#include "alloc.h"
+
+#if defined(HAVE_MADVISE)
+#include <sys/mman.h>
+#endif
+
+/* The number of size classes, enough for any positive npy_intp */
+#define DATA_CACHE_NCLASSES (4 * (NPY_BITSOF_INTP - NPY_DATA_CACHE_MIN_SHIFT))
+/* The number of buffers a bin holds at most */
+#define DATA_CACHE_DEPTH 8
+
+typedef struct {
+    void *ptr;
+    npy_intp size;
+    /* The value of data_cache_clock when the buffer was cached */
+    npy_uintp stamp;
+} data_cache_entry;
+
+/* The cached buffers of a size class, the oldest first */
+typedef struct {
+    int n;
+    data_cache_entry entries[DATA_CACHE_DEPTH];
+} data_cache_bin;
+
+static data_cache_bin data_cache_bins[DATA_CACHE_NCLASSES];
+static npy_intp data_cache_max = 0;
+static npy_intp data_cache_bytes = 0;
+static npy_intp data_cache_blocks = 0;
+static npy_uintp data_cache_clock = 0;
+
+/*
+ * The allocation policy: data_align is the alignment of the data buffers,
+ * 0 for the one of PyDataMem_NEW, and buffers of at least
+ * data_hugepage_min bytes are aligned to and backed by huge pages unless it
+ * is 0.
+ */
+static npy_intp data_align = 0;
+static npy_intp data_hugepage_min = 0;
+
+/* Statistics */
+static npy_intp data_cache_hits = 0;
+static npy_intp data_cache_misses = 0;
+static npy_intp data_cache_evictions = 0;
+
+/* The size class of size, which is at least NPY_DATA_CACHE_MIN */
+static int
+data_cache_class(npy_intp size)
+{
+    npy_uintp s = (npy_uintp)size;
+    int shift = NPY_DATA_CACHE_MIN_SHIFT - 2;
+
+    while ((s >> shift) > 7) {
+        shift++;
+    }
+    /* The top three bits of s are now 1xx */
+    return 4*(shift - (NPY_DATA_CACHE_MIN_SHIFT - 2)) + (int)(s >> shift) - 4;
+}
+
+/* Removes the entry i from bin and returns its buffer */
+static void *
+data_cache_take(data_cache_bin *bin, int i)
+{
+    void *p = bin->entries[i].ptr;
+
+    data_cache_bytes -= bin->entries[i].size;
+    data_cache_blocks--;
+    bin->n--;
+    memmove(&bin->entries[i], &bin->entries[i + 1],
+            (bin->n - i) * sizeof(data_cache_entry));
+    return p;
+}
+
+/* Frees the buffer cached the longest time ago */
+static void
+data_cache_evict(void)
+{
+    data_cache_bin *oldest = NULL;
+    int c;
+
+    for (c = 0; c < DATA_CACHE_NCLASSES; c++) {
+        data_cache_bin *bin = &data_cache_bins[c];
+
+        if (bin->n > 0 && (oldest == NULL ||
+                    bin->entries[0].stamp < oldest->entries[0].stamp)) {
+            oldest = bin;
+        }
+    }
+    if (oldest != NULL) {
+        PyDataMem_FREE(data_cache_take(oldest, 0));
+        data_cache_evictions++;
+    }
+}
+
+/* The alignment the policy asks for a buffer of size bytes, or 0 */
+static npy_intp
+data_alignment(npy_intp size)
+{
+#if defined(HAVE_POSIX_MEMALIGN)
+    if (data_hugepage_min > 0 && size >= data_hugepage_min &&
+                data_align < NPY_HUGEPAGE_SIZE) {
+        return NPY_HUGEPAGE_SIZE;
+    }
+    return data_align;
+#else
+    return 0;
+#endif
+}
+
+/* Whether p is aligned to align, which is 0 or a power of two */
+static NPY_INLINE int
+data_is_aligned(void *p, npy_intp align)
+{
+    return align == 0 || ((npy_uintp)p & (npy_uintp)(align - 1)) == 0;
+}
+
+/* Asks for huge pages backing the buffer p of size bytes if it is large */
+static void
+data_advise(void *p, npy_intp size)
+{
+#if defined(HAVE_MADVISE) && defined(MADV_HUGEPAGE)
+    if (data_hugepage_min > 0 && size >= data_hugepage_min &&
+                data_is_aligned(p, NPY_HUGEPAGE_SIZE)) {
+        /* Only a hint, the buffer is fine without huge pages */
+        madvise(p, size, MADV_HUGEPAGE);
+    }
+#endif
+}
+
+/* Allocates a buffer of size bytes aligned to align, which may be 0 */
+static void *
+data_alloc(npy_intp size, npy_intp align)
+{
+#if defined(HAVE_POSIX_MEMALIGN)
+    if (align > 0) {
+        void *p;
+
+        if (posix_memalign(&p, (size_t)align, (size_t)size) != 0) {
+            return NULL;
+        }
+        return p;
+    }
+#endif
+    return PyDataMem_NEW(size);
+}
+
+static void *
+default_malloc(void *NPY_UNUSED(ctx), size_t nbytes)
+{
+    npy_intp size = (npy_intp)nbytes;
+    npy_intp align = data_alignment(size);
+    void *p = NULL;
+
+    if (size >= NPY_DATA_CACHE_MIN && data_cache_max > 0) {
+        int c = data_cache_class(size), i;
+        data_cache_bin *bin = &data_cache_bins[c];
+
+        /* The most recently cached buffers are the likeliest to be hot */
+        for (i = bin->n - 1; i >= 0; i--) {
+            if (bin->entries[i].size >= size &&
+                        data_is_aligned(bin->entries[i].ptr, align)) {
+                p = data_cache_take(bin, i);
+                break;
+            }
+        }
+        if (p == NULL && c + 1 < DATA_CACHE_NCLASSES) {
+            bin = &data_cache_bins[c + 1];
+            for (i = bin->n - 1; i >= 0; i--) {
+                if (data_is_aligned(bin->entries[i].ptr, align)) {
+                    p = data_cache_take(bin, i);
+                    break;
+                }
+            }
+        }
+        if (p != NULL) {
+            data_cache_hits++;
+        }
+        else {
+            data_cache_misses++;
+        }
+    }
+    if (p == NULL) {
+        p = data_alloc(size, align);
+        if (p == NULL) {
+            return NULL;
+        }
+    }
+    data_advise(p, size);
+    return p;
+}
+
+/*
+ * Zeroed buffers never come from the cache. Clearing a cached buffer
+ * would write all of its pages, while calloc gets large buffers as fresh
+ * pages from the system, which are zero already and only take memory once
+ * they are written. There is no aligning calloc, so the buffers the policy
+ * aligns are cleared with memset and do take all their memory.
+ */
+static void *
+default_calloc(void *NPY_UNUSED(ctx), size_t nelem, size_t elsize)
+{
+    npy_intp size, align;
+    void *p;
+
+    if (elsize != 0 && nelem > (size_t)NPY_MAX_INTP / elsize) {
+        return NULL;
+    }
+    size = (npy_intp)(nelem * elsize);
+    align = data_alignment(size);
+    if (align == 0) {
+        p = calloc(nelem, elsize);
+    }
+    else {
+        p = data_alloc(size, align);
+        if (p != NULL) {
+            memset(p, 0, size);
+        }
+    }
+    if (p != NULL) {
+        data_advise(p, size);
+    }
+    return p;
+}
+
+static void *
+default_realloc(void *NPY_UNUSED(ctx), void *p, size_t size)
+{
+    return PyDataMem_RENEW(p, size);
+}
+
+static void
+default_free(void *NPY_UNUSED(ctx), void *p, size_t nbytes)
+{
+    npy_intp size = (npy_intp)nbytes;
+    data_cache_bin *bin;
+
+    if (size < NPY_DATA_CACHE_MIN || size > data_cache_max) {
+        PyDataMem_FREE(p);
+        return;
+    }
+    bin = &data_cache_bins[data_cache_class(size)];
+    if (bin->n == DATA_CACHE_DEPTH) {
+        PyDataMem_FREE(data_cache_take(bin, 0));
+        data_cache_evictions++;
+    }
+    while (data_cache_bytes > data_cache_max - size) {
+        data_cache_evict();
+    }
+    bin->entries[bin->n].ptr = p;
+    bin->entries[bin->n].size = size;
+    bin->entries[bin->n].stamp = data_cache_clock++;
+    bin->n++;
+    data_cache_bytes += size;
+    data_cache_blocks++;
+}
+
+static const PyDataMem_Handler default_handler = {
+    "default_allocator",
+    NULL,
+    default_malloc,
+    default_calloc,
+    default_realloc,
+    default_free
+};
+
+static const PyDataMem_Handler *current_handler = &default_handler;
+
+/*NUMPY_API
+ * Sets the allocator of the data buffers of new arrays and returns the
+ * previous one. NULL sets the default allocator. The handler must stay
+ * valid as long as there are buffers it allocated.
+ */
+NPY_NO_EXPORT const PyDataMem_Handler *
+PyDataMem_SetHandler(const PyDataMem_Handler *handler)
+{
+    const PyDataMem_Handler *old = current_handler;
+
+    current_handler = (handler != NULL) ? handler : &default_handler;
+    return old;
+}
+
+/*NUMPY_API
+ * Returns the allocator of the data buffers of new arrays.
+ */
+NPY_NO_EXPORT const PyDataMem_Handler *
+PyDataMem_GetHandler(void)
+{
+    return current_handler;
+}
+
+NPY_NO_EXPORT void *
+npy_data_alloc(npy_intp size, const PyDataMem_Handler **handler)
+{
+    const PyDataMem_Handler *h = current_handler;
+
+    *handler = h;
+    return h->malloc(h->ctx, size);
+}
+
+NPY_NO_EXPORT void *
+npy_data_zeroed_alloc(npy_intp size, const PyDataMem_Handler **handler)
+{
+    const PyDataMem_Handler *h = current_handler;
+
+    *handler = h;
+    return h->calloc(h->ctx, size, 1);
+}
+
+NPY_NO_EXPORT void *
+npy_data_realloc(void *p, npy_intp size, const PyDataMem_Handler *handler)
+{
+    if (handler == NULL) {
+        return PyDataMem_RENEW(p, size);
+    }
+    return handler->realloc(handler->ctx, p, size);
+}
+
+NPY_NO_EXPORT void
+npy_data_free(void *p, npy_intp size, const PyDataMem_Handler *handler)
+{
+    if (handler == NULL) {
+        PyDataMem_FREE(p);
+    }
+    else {
+        handler->free(handler->ctx, p, size);
+    }
+}
+
+NPY_NO_EXPORT int
+npy_dims_alloc(PyArrayObject_fields *fa, int nd)
+{
+    if (nd <= NPY_MAXINLINEDIMS) {
+        fa->dimensions = fa->inline_dims;
+    }
+    else {
+        fa->dimensions = PyDimMem_NEW(3*nd);
+        if (fa->dimensions == NULL) {
+            fa->nd = 0;
+            fa->strides = fa->maskna_strides = NULL;
+            return -1;
+        }
+    }
+    fa->strides = fa->dimensions + nd;
+    fa->maskna_strides = fa->dimensions + 2*nd;
+    return 0;
+}
+
+NPY_NO_EXPORT void
+npy_dims_free(PyArrayObject_fields *fa)
+{
+    if (fa->dimensions != fa->inline_dims) {
+        PyDimMem_FREE(fa->dimensions);
+    }
+    fa->dimensions = fa->strides = fa->maskna_strides = NULL;
+}
+
+/*
+ * The tracing handler. trace_blocks maps the address of each buffer it
+ * allocated to a tuple of the index of its site, its size and the address
+ * of the handler which allocated it, trace_sites_index maps the
+ * (filename, line number) of a site to its index in trace_sites. These
+ * are only used with the GIL held.
+ */
+typedef struct {
+    PyObject *key;
+    /* The number and the bytes of the allocations */
+    npy_intp count, total;
+    /* The bytes in use, and the most that were in use at once */
+    npy_intp current, peak;
+} trace_site;
+
+static int trace_enabled = 0;
+static const PyDataMem_Handler *trace_inner = NULL;
+static PyObject *trace_blocks = NULL;
+static PyObject *trace_sites_index = NULL;
+static trace_site *trace_sites = NULL;
+static npy_intp trace_nsites = 0, trace_maxsites = 0;
+static npy_intp trace_current = 0, trace_peak = 0;
+
+/* The index of the site of the innermost Python frame, or -1 on error */
+static npy_intp
+trace_site_of_frame(void)
+{
+    PyFrameObject *frame = PyEval_GetFrame();
+    PyObject *key, *index;
+    npy_intp i;
+
+    if (frame != NULL) {
+        key = Py_BuildValue("Oi", frame->f_code->co_filename,
+                            PyFrame_GetLineNumber(frame));
+    }
+    else {
+        key = Py_BuildValue("si", "<unknown>", 0);
+    }
+    if (key == NULL) {
+        return -1;
+    }
+    index = PyDict_GetItem(trace_sites_index, key);
+    if (index != NULL) {
+        Py_DECREF(key);
+        return PyInt_AsSsize_t(index);
+    }
+    if (trace_nsites == trace_maxsites) {
+        npy_intp n = (trace_maxsites > 0) ? 2*trace_maxsites : 64;
+        trace_site *sites = PyArray_realloc(trace_sites,
+                                            n * sizeof(trace_site));
+
+        if (sites == NULL) {
+            Py_DECREF(key);
+            return -1;
+        }
+        trace_sites = sites;
+        trace_maxsites = n;
+    }
+    i = trace_nsites;
+    index = PyInt_FromLong((long)i);
+    if (index == NULL || PyDict_SetItem(trace_sites_index, key, index) < 0) {
+        Py_XDECREF(index);
+        Py_DECREF(key);
+        return -1;
+    }
+    Py_DECREF(index);
+    trace_sites[i].key = key;
+    trace_sites[i].count = trace_sites[i].total = 0;
+    trace_sites[i].current = trace_sites[i].peak = 0;
+    trace_nsites++;
+    return i;
+}
+
+/* Adds size bytes to the use of site i */
+static void
+trace_add(npy_intp i, npy_intp size)
+{
+    trace_site *site = &trace_sites[i];
+
+    site->current += size;
+    if (site->current > site->peak) {
+        site->peak = site->current;
+    }
+    trace_current += size;
+    if (trace_current > trace_peak) {
+        trace_peak = trace_current;
+    }
+}
+
+/* Records the buffer p of size bytes, allocated by inner */
+static void
+trace_record(void *p, npy_intp size, const PyDataMem_Handler *inner,
+             npy_intp site)
+{
+    PyObject *key, *value;
+
+    if (site < 0) {
+        site = trace_site_of_frame();
+        if (site < 0) {
+            return;
+        }
+        trace_sites[site].count++;
+        trace_sites[site].total += size;
+    }
+    key = PyLong_FromVoidPtr(p);
+    value = Py_BuildValue("nnN", (Py_ssize_t)site, (Py_ssize_t)size,
+                          PyLong_FromVoidPtr((void *)inner));
+    if (key == NULL || value == NULL ||
+                PyDict_SetItem(trace_blocks, key, value) < 0) {
+        Py_XDECREF(key);
+        Py_XDECREF(value);
+        return;
+    }
+    Py_DECREF(key);
+    Py_DECREF(value);
+    trace_add(site, size);
+}
+
+/*
+ * Forgets the buffer p, setting *site to the index of its site and
+ * returning the handler which allocated it. Buffers which could not be
+ * recorded belong to trace_inner.
+ */
+static const PyDataMem_Handler *
+trace_forget(void *p, npy_intp *site)
+{
+    const PyDataMem_Handler *inner = trace_inner;
+    PyObject *key, *value;
+
+    *site = -1;
+    key = PyLong_FromVoidPtr(p);
+    if (key == NULL) {
+        return inner;
+    }
+    value = PyDict_GetItem(trace_blocks, key);
+    if (value != NULL) {
+        npy_intp size = PyInt_AsSsize_t(PyTuple_GET_ITEM(value, 1));
+
+        *site = PyInt_AsSsize_t(PyTuple_GET_ITEM(value, 0));
+        inner = PyLong_AsVoidPtr(PyTuple_GET_ITEM(value, 2));
+        trace_sites[*site].current -= size;
+        trace_current -= size;
+        PyDict_DelItem(trace_blocks, key);
+    }
+    Py_DECREF(key);
+    return inner;
+}
+
+static void *
+trace_malloc(void *NPY_UNUSED(ctx), size_t size)
+{
+    const PyDataMem_Handler *inner = trace_inner;
+    void *p = inner->malloc(inner->ctx, size);
+
+    if (p != NULL) {
+        PyGILState_STATE state = PyGILState_Ensure();
+        PyObject *type, *value, *traceback;
+
+        PyErr_Fetch(&type, &value, &traceback);
+        trace_record(p, size, inner, -1);
+        PyErr_Restore(type, value, traceback);
+        PyGILState_Release(state);
+    }
+    return p;
+}
+
+static void *
+trace_calloc(void *NPY_UNUSED(ctx), size_t nelem, size_t elsize)
+{
+    const PyDataMem_Handler *inner = trace_inner;
+    void *p = inner->calloc(inner->ctx, nelem, elsize);
+
+    if (p != NULL) {
+        PyGILState_STATE state = PyGILState_Ensure();
+        PyObject *type, *value, *traceback;
+
+        PyErr_Fetch(&type, &value, &traceback);
+        trace_record(p, nelem * elsize, inner, -1);
+        PyErr_Restore(type, value, traceback);
+        PyGILState_Release(state);
+    }
+    return p;
+}
+
+static void *
+trace_realloc(void *NPY_UNUSED(ctx), void *p, size_t size)
+{
+    PyGILState_STATE state = PyGILState_Ensure();
+    PyObject *type, *value, *traceback;
+    const PyDataMem_Handler *inner;
+    npy_intp site;
+    void *q;
+
+    PyErr_Fetch(&type, &value, &traceback);
+    inner = trace_forget(p, &site);
+    q = inner->realloc(inner->ctx, p, size);
+    /* A failed realloc leaves the old buffer */
+    trace_record(q != NULL ? q : p, q != NULL ? (npy_intp)size : 0,
+                 inner, site);
+    PyErr_Restore(type, value, traceback);
+    PyGILState_Release(state);
+    return q;
+}
+
+static void
+trace_free(void *NPY_UNUSED(ctx), void *p, size_t size)
+{
+    PyGILState_STATE state = PyGILState_Ensure();
+    PyObject *type, *value, *traceback;
+    const PyDataMem_Handler *inner;
+    npy_intp site;
+
+    PyErr_Fetch(&type, &value, &traceback);
+    inner = trace_forget(p, &site);
+    PyErr_Restore(type, value, traceback);
+    PyGILState_Release(state);
+    inner->free(inner->ctx, p, size);
+}
+
+static const PyDataMem_Handler trace_handler = {
+    "tracing_allocator",
+    NULL,
+    trace_malloc,
+    trace_calloc,
+    trace_realloc,
+    trace_free
+};
+
+NPY_NO_EXPORT PyObject *
+array_setdatatrace(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    int enable, old = trace_enabled;
+    npy_intp i;
+
+    if (!PyArg_ParseTuple(args, "i", &enable)) {
+        return NULL;
+    }
+    if (enable && !trace_enabled) {
+        if (trace_blocks == NULL) {
+            trace_blocks = PyDict_New();
+            trace_sites_index = PyDict_New();
+            if (trace_blocks == NULL || trace_sites_index == NULL) {
+                Py_CLEAR(trace_blocks);
+                Py_CLEAR(trace_sites_index);
+                return NULL;
+            }
+        }
+        /* The buffers of an earlier run still count as in use */
+        for (i = 0; i < trace_nsites; i++) {
+            trace_sites[i].count = trace_sites[i].total = 0;
+            trace_sites[i].peak = trace_sites[i].current;
+        }
+        trace_peak = trace_current;
+        trace_inner = PyDataMem_SetHandler(&trace_handler);
+        trace_enabled = 1;
+    }
+    else if (!enable && trace_enabled) {
+        /* Leave a handler set since tracing started in place */
+        if (current_handler == &trace_handler) {
+            PyDataMem_SetHandler(trace_inner);
+        }
+        trace_enabled = 0;
+    }
+    return PyBool_FromLong(old);
+}
+
+NPY_NO_EXPORT PyObject *
+array_datatracestats(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *sites;
+    npy_intp i;
+
+    if (!PyArg_ParseTuple(args, "")) {
+        return NULL;
+    }
+    sites = PyDict_New();
+    if (sites == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < trace_nsites; i++) {
+        trace_site *site = &trace_sites[i];
+        PyObject *value;
+
+        if (site->count == 0 && site->current == 0) {
+            continue;
+        }
+        value = Py_BuildValue("nnnn", (Py_ssize_t)site->count,
+                              (Py_ssize_t)site->total,
+                              (Py_ssize_t)site->current,
+                              (Py_ssize_t)site->peak);
+        if (value == NULL || PyDict_SetItem(sites, site->key, value) < 0) {
+            Py_XDECREF(value);
+            Py_DECREF(sites);
+            return NULL;
+        }
+        Py_DECREF(value);
+    }
+    return Py_BuildValue("{s:n,s:n,s:N}",
+            "current", (Py_ssize_t)trace_current,
+            "peak", (Py_ssize_t)trace_peak,
+            "sites", sites);
+}
+
+NPY_NO_EXPORT PyObject *
+array_getdatahandler(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return NULL;
+    }
+    return PyUString_FromString(current_handler->name);
+}
+
+NPY_NO_EXPORT PyObject *
+array_setdatacache(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    npy_intp maxbytes, old = data_cache_max;
+
+    if (!PyArg_ParseTuple(args, "n", &maxbytes)) {
+        return NULL;
+    }
+    if (maxbytes < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                "the size of the data cache must not be negative");
+        return NULL;
+    }
+    data_cache_max = maxbytes;
+    while (data_cache_bytes > data_cache_max) {
+        data_cache_evict();
+    }
+    return Py_BuildValue("n", (Py_ssize_t)old);
+}
+
+NPY_NO_EXPORT PyObject *
+array_setallocpolicy(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    npy_intp align, hugepage_min;
+    PyObject *old = Py_BuildValue("nn", (Py_ssize_t)data_align,
+                                  (Py_ssize_t)data_hugepage_min);
+
+    if (old == NULL) {
+        return NULL;
+    }
+    if (!PyArg_ParseTuple(args, "nn", &align, &hugepage_min)) {
+        Py_DECREF(old);
+        return NULL;
+    }
+    if (align != 0 && (align < (npy_intp)sizeof(void *) ||
+                       align > NPY_HUGEPAGE_SIZE || (align & (align - 1)))) {
+        PyErr_Format(PyExc_ValueError,
+                "the alignment must be 0 or a power of two between %d and %d",
+                (int)sizeof(void *), (int)NPY_HUGEPAGE_SIZE);
+        Py_DECREF(old);
+        return NULL;
+    }
+    if (hugepage_min < 0) {
+        PyErr_SetString(PyExc_ValueError,
+                "the huge page threshold must not be negative");
+        Py_DECREF(old);
+        return NULL;
+    }
+    data_align = align;
+    data_hugepage_min = hugepage_min;
+    return old;
+}
+
+NPY_NO_EXPORT PyObject *
+array_getallocpolicy(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return NULL;
+    }
+    return Py_BuildValue("nn", (Py_ssize_t)data_align,
+                         (Py_ssize_t)data_hugepage_min);
+}
+
+NPY_NO_EXPORT PyObject *
+array_getdatacache(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return NULL;
+    }
+    return Py_BuildValue("n", (Py_ssize_t)data_cache_max);
+}
+
+NPY_NO_EXPORT PyObject *
+array_datacachestats(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return NULL;
+    }
+    return Py_BuildValue("{s:n,s:n,s:n,s:n,s:n,s:n}",
+            "maxbytes", (Py_ssize_t)data_cache_max,
+            "nbytes", (Py_ssize_t)data_cache_bytes,
+            "nblocks", (Py_ssize_t)data_cache_blocks,
+            "hits", (Py_ssize_t)data_cache_hits,
+            "misses", (Py_ssize_t)data_cache_misses,
+            "evictions", (Py_ssize_t)data_cache_evictions);
+}
@@ -0,0 +1,108 @@
+#ifndef _NPY_PRIVATE__ALLOC_H_
+#define _NPY_PRIVATE__ALLOC_H_
+
+/* Buffers of fewer bytes are never cached */
+#define NPY_DATA_CACHE_MIN_SHIFT 16
+#define NPY_DATA_CACHE_MIN ((npy_intp)1 << NPY_DATA_CACHE_MIN_SHIFT)
+
+/* The size of the huge pages buffers are aligned to */
+#define NPY_HUGEPAGE_SIZE ((npy_intp)2 << 20)
+
+/*
+ * Allocates an array data buffer of size bytes with the current handler,
+ * which is stored in *handler. The GIL must be held.
+ */
+NPY_NO_EXPORT void *
+npy_data_alloc(npy_intp size, const PyDataMem_Handler **handler);
+
+/*
+ * Like npy_data_alloc, but the buffer is filled with zero bytes.
+ */
+NPY_NO_EXPORT void *
+npy_data_zeroed_alloc(npy_intp size, const PyDataMem_Handler **handler);
+
+/*
+ * Resizes the data buffer p allocated by handler, or by PyDataMem_NEW if
+ * handler is NULL.
+ */
+NPY_NO_EXPORT void *
+npy_data_realloc(void *p, npy_intp size, const PyDataMem_Handler *handler);
+
+/*
+ * Frees the data buffer p of at least size bytes allocated by handler, or
+ * by PyDataMem_NEW if handler is NULL. The GIL must be held.
+ */
+NPY_NO_EXPORT void
+npy_data_free(void *p, npy_intp size, const PyDataMem_Handler *handler);
+
+/*
+ * Sets the dimensions, strides and NA mask strides of fa to a buffer for
+ * nd dimensions, in the array object if it is small enough. Returns -1
+ * and leaves the array without dimensions if the allocation fails.
+ */
+NPY_NO_EXPORT int
+npy_dims_alloc(PyArrayObject_fields *fa, int nd);
+
+/*
+ * Frees the buffer of the dimensions and strides of fa.
+ */
+NPY_NO_EXPORT void
+npy_dims_free(PyArrayObject_fields *fa);
+
+/*
+ * This is the 'setdatacache' function exposed for calling
+ * from Python.
+ */
+NPY_NO_EXPORT PyObject *
+array_setdatacache(PyObject *NPY_UNUSED(self), PyObject *args);
+
+/*
+ * This is the 'setallocpolicy' function exposed for calling
+ * from Python.
+ */
+NPY_NO_EXPORT PyObject *
+array_setallocpolicy(PyObject *NPY_UNUSED(self), PyObject *args);
+
+/*
+ * This is the 'getallocpolicy' function exposed for calling
+ * from Python.
+ */
+NPY_NO_EXPORT PyObject *
+array_getallocpolicy(PyObject *NPY_UNUSED(self), PyObject *args);
+
+/*
+ * This is the 'getdatacache' function exposed for calling
+ * from Python.
+ */
+NPY_NO_EXPORT PyObject *
+array_getdatacache(PyObject *NPY_UNUSED(self), PyObject *args);
+
+/*
+ * This is the 'datacachestats' function exposed for calling
+ * from Python.
+ */
+NPY_NO_EXPORT PyObject *
+array_datacachestats(PyObject *NPY_UNUSED(self), PyObject *args);
+
+/*
+ * This is the 'setdatatrace' function exposed for calling
+ * from Python.
+ */
+NPY_NO_EXPORT PyObject *
+array_setdatatrace(PyObject *NPY_UNUSED(self), PyObject *args);
+
+/*
+ * This is the 'datatracestats' function exposed for calling
+ * from Python.
+ */
+NPY_NO_EXPORT PyObject *
+array_datatracestats(PyObject *NPY_UNUSED(self), PyObject *args);
+
+/*
+ * This is the 'getdatahandler' function exposed for calling
+ * from Python.
+ */
+NPY_NO_EXPORT PyObject *
+array_getdatahandler(PyObject *NPY_UNUSED(self), PyObject *args);
+
+#endif
@@ -51,6 +51,7 @@ maintainer email:  oliphant.travis@ieee.org
 #include "buffer.h"
 #include "na_object.h"
 #include "na_mask.h"
+#include "alloc.h"
 
 /*NUMPY_API
   Compute the size of an array (in number of items)
@@ -398,7 +399,7 @@ array_dealloc(PyArrayObject *self)
              * self already...
              */
         }
-        PyDataMem_FREE(fa->data);
+        npy_data_free(fa->data, PyArray_NBYTES(self), fa->mem_handler);
     }
 
     /* If the array has an NA mask, free its associated data */
@@ -409,7 +410,7 @@ array_dealloc(PyArrayObject *self)
         }
     }
 
-    PyDimMem_FREE(fa->dimensions);
+    npy_dims_free(fa);
     Py_DECREF(fa->descr);
     Py_TYPE(self)->tp_free((PyObject *)self);
 }
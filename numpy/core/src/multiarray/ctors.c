@@ -24,6 +24,7 @@
 #include "_datetime.h"
 #include "datetime_strings.h"
 #include "na_object.h"
+#include "alloc.h"
 
 /*
  * Reading from a file or a string.
@@ -859,15 +860,14 @@ discover_dimensions(PyObject *obj, int *maxndim, npy_intp *d, int check_it,
     return 0;
 }
 
-/*NUMPY_API
- * Generic new array creation routine.
- *
- * steals a reference to descr (even on failure)
+/*
+ * PyArray_NewFromDescr, allocating zeroed data if zeroed is set and the
+ * data is not passed in.
  */
-NPY_NO_EXPORT PyObject *
-PyArray_NewFromDescr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
-                     npy_intp *dims, npy_intp *strides, void *data,
-                     int flags, PyObject *obj)
+static PyObject *
+_array_new_from_descr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
+                      npy_intp *dims, npy_intp *strides, void *data,
+                      int flags, PyObject *obj, int zeroed)
 {
     PyArrayObject_fields *fa;
     int i;
@@ -886,9 +886,9 @@ PyArray_NewFromDescr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
         }
         nd =_update_descr_and_dimensions(&descr, newdims,
                                          newstrides, nd);
-        ret = PyArray_NewFromDescr(subtype, descr, nd, newdims,
-                                   newstrides,
-                                   data, flags, obj);
+        ret = _array_new_from_descr(subtype, descr, nd, newdims,
+                                    newstrides,
+                                    data, flags, obj, zeroed);
         return ret;
     }
 
@@ -983,15 +983,13 @@ PyArray_NewFromDescr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
     fa->weakreflist = (PyObject *)NULL;
     fa->maskna_dtype = NULL;
     fa->maskna_data = NULL;
+    fa->mem_handler = NULL;
 
     if (nd > 0) {
-        fa->dimensions = PyDimMem_NEW(3*nd);
-        if (fa->dimensions == NULL) {
+        if (npy_dims_alloc(fa, nd) < 0) {
             PyErr_NoMemory();
             goto fail;
         }
-        fa->strides = fa->dimensions + nd;
-        fa->maskna_strides = fa->dimensions + 2 * nd;
         memcpy(fa->dimensions, dims, sizeof(npy_intp)*nd);
         if (strides == NULL) { /* fill it in */
             sd = _array_fill_strides(fa->strides, dims, nd, sd,
@@ -1021,7 +1019,12 @@ PyArray_NewFromDescr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
         if (sd == 0) {
             sd = descr->elsize;
         }
-        data = PyDataMem_NEW(sd);
+        if (zeroed) {
+            data = npy_data_zeroed_alloc(sd, &fa->mem_handler);
+        }
+        else {
+            data = npy_data_alloc(sd, &fa->mem_handler);
+        }
         if (data == NULL) {
             PyErr_NoMemory();
             goto fail;
@@ -1032,7 +1035,7 @@ PyArray_NewFromDescr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
          * It is bad to have unitialized OBJECT pointers
          * which could also be sub-fields of a VOID array
          */
-        if (PyDataType_FLAGCHK(descr, NPY_NEEDS_INIT)) {
+        if (!zeroed && PyDataType_FLAGCHK(descr, NPY_NEEDS_INIT)) {
             memset(data, 0, sd);
         }
     }
@@ -1107,6 +1110,20 @@ PyArray_NewFromDescr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
     return NULL;
 }
 
+/*NUMPY_API
+ * Generic new array creation routine.
+ *
+ * steals a reference to descr (even on failure)
+ */
+NPY_NO_EXPORT PyObject *
+PyArray_NewFromDescr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
+                     npy_intp *dims, npy_intp *strides, void *data,
+                     int flags, PyObject *obj)
+{
+    return _array_new_from_descr(subtype, descr, nd, dims, strides,
+                                 data, flags, obj, 0);
+}
+
 /*NUMPY_API
  * Creates a new array with the same shape as the provided one,
  * with possible memory layout order and data type changes.
@@ -1914,15 +1931,19 @@ PyArray_CheckFromAny(PyObject *op, PyArray_Descr *descr, int min_depth,
 {
     PyObject *obj;
     if (requires & NPY_ARRAY_NOTSWAPPED) {
+        /* descr may be shared, only a new copy is changed */
         if (!descr && PyArray_Check(op) &&
             !PyArray_ISNBO(PyArray_DESCR((PyArrayObject *)op)->byteorder)) {
             descr = PyArray_DescrNew(PyArray_DESCR((PyArrayObject *)op));
+            if (descr) {
+                descr->byteorder = NPY_NATIVE;
+            }
         }
         else if (descr && !PyArray_ISNBO(descr->byteorder)) {
             PyArray_DESCR_REPLACE(descr);
-        }
-        if (descr) {
-            descr->byteorder = NPY_NATIVE;
+            if (descr) {
+                descr->byteorder = NPY_NATIVE;
+            }
         }
     }
 
@@ -2988,6 +3009,14 @@ PyArray_Zeros(int nd, npy_intp *dims, PyArray_Descr *type, int is_f_order)
     if (!type) {
         type = PyArray_DescrFromType(NPY_DEFAULT_TYPE);
     }
+    /*
+     * The zero of types without object references is all zero bytes,
+     * which zeroed data from calloc is without touching its pages.
+     */
+    if (!PyDataType_REFCHK(type)) {
+        return _array_new_from_descr(&PyArray_Type, type, nd, dims,
+                                     NULL, NULL, is_f_order, NULL, 1);
+    }
     ret = (PyArrayObject *)PyArray_NewFromDescr(&PyArray_Type,
                                                 type,
                                                 nd, dims,
@@ -3456,7 +3485,8 @@ array_from_text(PyArray_Descr *dtype, npy_intp num, char *sep, size_t *nread,
         dptr += dtype->elsize;
         if (num < 0 && thisbuf == size) {
             totalbytes += bytes;
-            tmp = PyDataMem_RENEW(PyArray_DATA(r), totalbytes);
+            tmp = npy_data_realloc(PyArray_DATA(r), totalbytes,
+                                   ((PyArrayObject_fields *)r)->mem_handler);
             if (tmp == NULL) {
                 err = 1;
                 break;
@@ -3470,7 +3500,9 @@ array_from_text(PyArray_Descr *dtype, npy_intp num, char *sep, size_t *nread,
         }
     }
     if (num < 0) {
-        tmp = PyDataMem_RENEW(PyArray_DATA(r), PyArray_MAX(*nread,1)*dtype->elsize);
+        tmp = npy_data_realloc(PyArray_DATA(r),
+                               PyArray_MAX(*nread,1)*dtype->elsize,
+                               ((PyArrayObject_fields *)r)->mem_handler);
         if (tmp == NULL) {
             err = 1;
         }
@@ -3552,7 +3584,8 @@ PyArray_FromFile(FILE *fp, PyArray_Descr *dtype, npy_intp num, char *sep)
         const size_t nsize = PyArray_MAX(nread,1)*PyArray_DESCR(ret)->elsize;
         char *tmp;
 
-        if((tmp = PyDataMem_RENEW(PyArray_DATA(ret), nsize)) == NULL) {
+        if((tmp = npy_data_realloc(PyArray_DATA(ret), nsize,
+                        ((PyArrayObject_fields *)ret)->mem_handler)) == NULL) {
             Py_DECREF(ret);
             return PyErr_NoMemory();
         }
@@ -3832,7 +3865,9 @@ PyArray_FromIter(PyObject *obj, PyArray_Descr *dtype, npy_intp count)
             */
             elcount = (i >> 1) + (i < 4 ? 4 : 2) + i;
             if (elcount <= NPY_MAX_INTP/elsize) {
-                new_data = PyDataMem_RENEW(PyArray_DATA(ret), elcount * elsize);
+                new_data = npy_data_realloc(PyArray_DATA(ret),
+                        elcount * elsize,
+                        ((PyArrayObject_fields *)ret)->mem_handler);
             }
             else {
                 new_data = NULL;
@@ -3867,7 +3902,8 @@ PyArray_FromIter(PyObject *obj, PyArray_Descr *dtype, npy_intp count)
     if (i == 0) {
         i = 1;
     }
-    new_data = PyDataMem_RENEW(PyArray_DATA(ret), i * elsize);
+    new_data = npy_data_realloc(PyArray_DATA(ret), i * elsize,
+                                ((PyArrayObject_fields *)ret)->mem_handler);
     if (new_data == NULL) {
         PyErr_SetString(PyExc_MemoryError, "cannot allocate array memory");
         goto done;
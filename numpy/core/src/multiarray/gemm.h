@@ -0,0 +1,34 @@
+#ifndef _NPY_PRIVATE__GEMM_H_
+#define _NPY_PRIVATE__GEMM_H_
+
+#include "npy_gemm.h"
+
+/*
+ * The products of at least this many multiplications use npy_gemm in dot
+ * and inner, smaller ones go through the dotfunc of the type.
+ */
+#define NPY_GEMM_MIN_WORK 4096
+
+/* See npy_gemm_func in npy_gemm.h */
+NPY_NO_EXPORT int
+npy_gemm(int typenum, npy_intp m, npy_intp n, npy_intp k, const void *alpha,
+         const char *a, const npy_intp *aoffsets, npy_intp astride,
+         int conj_a,
+         const char *b, const npy_intp *boffsets, npy_intp bstride,
+         int conj_b,
+         char *c, npy_intp crow, npy_intp ccol,
+         npy_ufunc_threads_api *threads);
+
+/* Whether npy_gemm supports the type */
+NPY_NO_EXPORT int
+npy_gemm_supported(int typenum);
+
+/* Chooses the kernels for the running cpu, called at module initialization */
+NPY_NO_EXPORT void
+npy_gemm_init(void);
+
+/* The _GEMM capsule */
+NPY_NO_EXPORT PyObject *
+npy_gemm_capsule(void);
+
+#endif
@@ -16,6 +16,7 @@
 #include "scalartypes.h"
 #include "descriptor.h"
 #include "getset.h"
+#include "alloc.h"
 
 /*******************  array attribute get and set routines ******************/
 
@@ -63,27 +64,20 @@ array_shape_set(PyArrayObject *self, PyObject *val)
     }
 
     /* Free old dimensions and strides */
-    PyDimMem_FREE(PyArray_DIMS(self));
+    npy_dims_free((PyArrayObject_fields *)self);
     nd = PyArray_NDIM(ret);
     ((PyArrayObject_fields *)self)->nd = nd;
     if (nd > 0) {
         /* create new dimensions and strides */
-        ((PyArrayObject_fields *)self)->dimensions = PyDimMem_NEW(3*nd);
-        if (PyArray_DIMS(self) == NULL) {
+        if (npy_dims_alloc((PyArrayObject_fields *)self, nd) < 0) {
             Py_DECREF(ret);
             PyErr_SetString(PyExc_MemoryError,"");
             return -1;
         }
-        ((PyArrayObject_fields *)self)->strides = PyArray_DIMS(self) + nd;
-        ((PyArrayObject_fields *)self)->maskna_strides = PyArray_DIMS(self) + 2*nd;
         memcpy(PyArray_DIMS(self), PyArray_DIMS(ret), nd*sizeof(npy_intp));
         memcpy(PyArray_STRIDES(self), PyArray_STRIDES(ret), nd*sizeof(npy_intp));
         memcpy(PyArray_MASKNA_STRIDES(self), PyArray_MASKNA_STRIDES(ret), nd*sizeof(npy_intp));
     }
-    else {
-        ((PyArrayObject_fields *)self)->dimensions = NULL;
-        ((PyArrayObject_fields *)self)->strides = NULL;
-    }
     Py_DECREF(ret);
     PyArray_UpdateFlags(self, NPY_ARRAY_C_CONTIGUOUS | NPY_ARRAY_F_CONTIGUOUS);
     return 0;
@@ -346,7 +340,9 @@ array_data_set(PyArrayObject *self, PyObject *op)
     }
     if (PyArray_FLAGS(self) & NPY_ARRAY_OWNDATA) {
         PyArray_XDECREF(self);
-        PyDataMem_FREE(PyArray_DATA(self));
+        npy_data_free(PyArray_DATA(self), PyArray_NBYTES(self),
+                      ((PyArrayObject_fields *)self)->mem_handler);
+        ((PyArrayObject_fields *)self)->mem_handler = NULL;
     }
     if (PyArray_BASE(self)) {
         if (PyArray_FLAGS(self) & NPY_ARRAY_UPDATEIFCOPY) {
@@ -526,15 +522,21 @@ array_descr_set(PyArrayObject *self, PyObject *arg)
         if (temp == NULL) {
             return -1;
         }
-        PyDimMem_FREE(PyArray_DIMS(self));
-        ((PyArrayObject_fields *)self)->dimensions = PyArray_DIMS(temp);
-        ((PyArrayObject_fields *)self)->nd = PyArray_NDIM(temp);
-        ((PyArrayObject_fields *)self)->strides = PyArray_STRIDES(temp);
         newtype = PyArray_DESCR(temp);
         Py_INCREF(PyArray_DESCR(temp));
-        /* Fool deallocator not to delete these*/
-        ((PyArrayObject_fields *)temp)->nd = 0;
-        ((PyArrayObject_fields *)temp)->dimensions = NULL;
+        npy_dims_free((PyArrayObject_fields *)self);
+        ((PyArrayObject_fields *)self)->nd = PyArray_NDIM(temp);
+        if (npy_dims_alloc((PyArrayObject_fields *)self,
+                           PyArray_NDIM(temp)) < 0) {
+            ((PyArrayObject_fields *)self)->descr = newtype;
+            Py_DECREF(temp);
+            PyErr_NoMemory();
+            return -1;
+        }
+        memcpy(PyArray_DIMS(self), PyArray_DIMS(temp),
+               PyArray_NDIM(temp)*sizeof(npy_intp));
+        memcpy(PyArray_STRIDES(self), PyArray_STRIDES(temp),
+               PyArray_NDIM(temp)*sizeof(npy_intp));
         Py_DECREF(temp);
     }
 
@@ -0,0 +1,571 @@
+/*
+ * This file implements the hash tables used by the set operations in
+ * numpy.lib.arraysetops, which find the distinct elements of an array in
+ * linear time instead of sorting all of it.
+ *
+ * The tables use open addressing with linear probing. The distinct
+ * elements are numbered in the order they are first seen, and an entry
+ * holds the key of an element and its number. Elements of at most eight
+ * bytes are their own key, so a probe does not have to look at the array,
+ * larger ones are hashed and compared with the first element of their
+ * kind. The keys are canonical, 0.0 and -0.0 are the same element, and as
+ * for the sorting implementation a NaN is never equal to anything, so each
+ * NaN is a distinct element.
+ *
+ * See LICENSE.txt for the license.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+#define _MULTIARRAYMODULE
+#include <numpy/arrayobject.h>
+#include <numpy/halffloat.h>
+
+#include "npy_config.h"
+#include "numpy/npy_3kcompat.h"
+
+#include "hashtable.h"
+
+/* The multiplier of the Fibonacci hashing, 2**64 over the golden ratio */
+#define HASH_MULTIPLIER NPY_ULONGLONG_SUFFIX(0x9E3779B97F4A7C15)
+/* The initial number of elements a table has room for */
+#define HASH_INITIAL_SIZE 1024
+
+/*
+ * Sets *key to the key of the element at p and returns 1, or returns 0
+ * if the element is a NaN.
+ */
+typedef int (hash_key_func)(const char *p, npy_intp itemsize,
+                            npy_uint64 *key);
+/* Whether the elements at a and b, which have the same key, are equal */
+typedef int (hash_equal_func)(const char *a, const char *b,
+                              npy_intp itemsize);
+
+static int
+bool_key(const char *p, npy_intp NPY_UNUSED(itemsize), npy_uint64 *key)
+{
+    *key = (*(npy_bool *)p != 0);
+    return 1;
+}
+
+#define UINT_KEY(name, type)                                                \
+static int                                                                  \
+name##_key(const char *p, npy_intp NPY_UNUSED(itemsize), npy_uint64 *key)   \
+{                                                                           \
+    *key = *(type *)p;                                                      \
+    return 1;                                                               \
+}
+
+UINT_KEY(uint8, npy_uint8)
+UINT_KEY(uint16, npy_uint16)
+UINT_KEY(uint32, npy_uint32)
+UINT_KEY(uint64, npy_uint64)
+
+#undef UINT_KEY
+
+static int
+half_key(const char *p, npy_intp NPY_UNUSED(itemsize), npy_uint64 *key)
+{
+    npy_half h = *(npy_half *)p;
+
+    if (npy_half_isnan(h)) {
+        return 0;
+    }
+    *key = npy_half_iszero(h) ? 0 : h;
+    return 1;
+}
+
+/* The bits of f with -0.0 as 0.0, or 0 for a NaN */
+static NPY_INLINE int
+float_bits(npy_float f, npy_uint64 *bits)
+{
+    union {
+        npy_float f;
+        npy_uint32 u;
+    } conv;
+
+    if (f != f) {
+        return 0;
+    }
+    conv.f = (f == 0) ? 0 : f;
+    *bits = conv.u;
+    return 1;
+}
+
+static NPY_INLINE int
+double_bits(npy_double d, npy_uint64 *bits)
+{
+    union {
+        npy_double d;
+        npy_uint64 u;
+    } conv;
+
+    if (d != d) {
+        return 0;
+    }
+    conv.d = (d == 0) ? 0 : d;
+    *bits = conv.u;
+    return 1;
+}
+
+static int
+float_key(const char *p, npy_intp NPY_UNUSED(itemsize), npy_uint64 *key)
+{
+    return float_bits(*(npy_float *)p, key);
+}
+
+static int
+double_key(const char *p, npy_intp NPY_UNUSED(itemsize), npy_uint64 *key)
+{
+    return double_bits(*(npy_double *)p, key);
+}
+
+static int
+cfloat_key(const char *p, npy_intp NPY_UNUSED(itemsize), npy_uint64 *key)
+{
+    const npy_cfloat *c = (const npy_cfloat *)p;
+    npy_uint64 re, im;
+
+    if (!float_bits(c->real, &re) || !float_bits(c->imag, &im)) {
+        return 0;
+    }
+    *key = (re << 32) | im;
+    return 1;
+}
+
+static int
+cdouble_key(const char *p, npy_intp NPY_UNUSED(itemsize), npy_uint64 *key)
+{
+    const npy_cdouble *c = (const npy_cdouble *)p;
+    npy_uint64 re, im;
+
+    if (!double_bits(c->real, &re) || !double_bits(c->imag, &im)) {
+        return 0;
+    }
+    *key = re ^ ((im * HASH_MULTIPLIER) >> 17) ^ (im << 47);
+    return 1;
+}
+
+static int
+cdouble_equal(const char *a, const char *b, npy_intp NPY_UNUSED(itemsize))
+{
+    const npy_cdouble *ca = (const npy_cdouble *)a;
+    const npy_cdouble *cb = (const npy_cdouble *)b;
+
+    return ca->real == cb->real && ca->imag == cb->imag;
+}
+
+/* The 64 bit FNV-1a hash of the bytes */
+static int
+bytes_key(const char *p, npy_intp itemsize, npy_uint64 *key)
+{
+    npy_uint64 h = NPY_ULONGLONG_SUFFIX(0xcbf29ce484222325);
+    npy_intp i;
+
+    for (i = 0; i < itemsize; i++) {
+        h = (h ^ (npy_ubyte)p[i]) * NPY_ULONGLONG_SUFFIX(0x100000001b3);
+    }
+    *key = h;
+    return 1;
+}
+
+static int
+bytes_equal(const char *a, const char *b, npy_intp itemsize)
+{
+    return memcmp(a, b, itemsize) == 0;
+}
+
+/*
+ * Gets the functions for the elements of descr, raising a TypeError and
+ * returning -1 for the types without hash support. The elements have to
+ * be aligned and in native byte order.
+ */
+static int
+get_hash_funcs(PyArray_Descr *descr,
+               hash_key_func **key, hash_equal_func **equal)
+{
+    *equal = NULL;
+    switch (descr->type_num) {
+        case NPY_BOOL:
+            *key = &bool_key;
+            return 0;
+        case NPY_BYTE:
+        case NPY_UBYTE:
+        case NPY_SHORT:
+        case NPY_USHORT:
+        case NPY_INT:
+        case NPY_UINT:
+        case NPY_LONG:
+        case NPY_ULONG:
+        case NPY_LONGLONG:
+        case NPY_ULONGLONG:
+            switch (descr->elsize) {
+                case 1:
+                    *key = &uint8_key;
+                    return 0;
+                case 2:
+                    *key = &uint16_key;
+                    return 0;
+                case 4:
+                    *key = &uint32_key;
+                    return 0;
+                case 8:
+                    *key = &uint64_key;
+                    return 0;
+            }
+            break;
+        case NPY_HALF:
+            *key = &half_key;
+            return 0;
+        case NPY_FLOAT:
+            *key = &float_key;
+            return 0;
+        case NPY_DOUBLE:
+            *key = &double_key;
+            return 0;
+        case NPY_CFLOAT:
+            *key = &cfloat_key;
+            return 0;
+        case NPY_CDOUBLE:
+            *key = &cdouble_key;
+            *equal = &cdouble_equal;
+            return 0;
+        case NPY_STRING:
+        case NPY_UNICODE:
+            *key = &bytes_key;
+            *equal = &bytes_equal;
+            return 0;
+    }
+    PyErr_SetString(PyExc_TypeError,
+            "the data type is not supported by the hash tables");
+    return -1;
+}
+
+typedef struct {
+    npy_uint64 key;
+    /* the number of the element, -1 for an unused entry */
+    npy_intp group;
+} hash_entry;
+
+typedef struct {
+    hash_key_func *key;
+    /* NULL if the elements are their own key */
+    hash_equal_func *equal;
+    /* the array the table is built from */
+    const char *data;
+    npy_intp stride, itemsize;
+    /* 2**bits entries, nentries of them used */
+    hash_entry *entries;
+    int bits;
+    npy_intp nentries;
+    /* the index of the first element in data of each group */
+    npy_intp *first, ngroups, first_size;
+} hash_table;
+
+static NPY_INLINE npy_intp
+hash_slot(npy_uint64 key, int bits)
+{
+    return (npy_intp)((key * HASH_MULTIPLIER) >> (64 - bits));
+}
+
+static void
+hash_table_free(hash_table *t)
+{
+    PyDataMem_FREE(t->entries);
+    PyDataMem_FREE(t->first);
+    t->entries = NULL;
+    t->first = NULL;
+}
+
+/*
+ * Initializes an empty table for the elements of arr, returns -1 with an
+ * exception set on failure.
+ */
+static int
+hash_table_init(hash_table *t, PyArrayObject *arr)
+{
+    npy_intp i, size = PyArray_DIM(arr, 0);
+
+    if (get_hash_funcs(PyArray_DESCR(arr), &t->key, &t->equal) < 0) {
+        return -1;
+    }
+    t->data = PyArray_DATA(arr);
+    t->stride = PyArray_STRIDE(arr, 0);
+    t->itemsize = PyArray_DESCR(arr)->elsize;
+
+    if (size > HASH_INITIAL_SIZE) {
+        size = HASH_INITIAL_SIZE;
+    }
+    t->bits = 4;
+    while (((npy_intp)1 << t->bits) < 2 * size) {
+        t->bits++;
+    }
+    t->nentries = 0;
+    t->ngroups = 0;
+    t->first_size = (npy_intp)1 << (t->bits - 1);
+    t->entries = (hash_entry *)PyDataMem_NEW(sizeof(hash_entry) << t->bits);
+    t->first = (npy_intp *)PyDataMem_NEW(sizeof(npy_intp) * t->first_size);
+    if (t->entries == NULL || t->first == NULL) {
+        hash_table_free(t);
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (i = 0; i < ((npy_intp)1 << t->bits); i++) {
+        t->entries[i].group = -1;
+    }
+    return 0;
+}
+
+/* Doubles the number of entries, returns -1 if out of memory */
+static int
+hash_table_grow(hash_table *t)
+{
+    npy_intp i, n = (npy_intp)1 << t->bits, mask = 2 * n - 1;
+    hash_entry *entries = (hash_entry *)PyDataMem_NEW(
+                                        2 * n * sizeof(hash_entry));
+
+    if (entries == NULL) {
+        return -1;
+    }
+    for (i = 0; i < 2 * n; i++) {
+        entries[i].group = -1;
+    }
+    for (i = 0; i < n; i++) {
+        if (t->entries[i].group >= 0) {
+            npy_intp s = hash_slot(t->entries[i].key, t->bits + 1);
+
+            while (entries[s].group >= 0) {
+                s = (s + 1) & mask;
+            }
+            entries[s] = t->entries[i];
+        }
+    }
+    PyDataMem_FREE(t->entries);
+    t->entries = entries;
+    t->bits++;
+    return 0;
+}
+
+/* Adds a group starting at index, returns -1 if out of memory */
+static npy_intp
+hash_table_new_group(hash_table *t, npy_intp index)
+{
+    if (t->ngroups == t->first_size) {
+        npy_intp *first = (npy_intp *)PyDataMem_RENEW(t->first,
+                                    2 * t->first_size * sizeof(npy_intp));
+        if (first == NULL) {
+            return -1;
+        }
+        t->first = first;
+        t->first_size *= 2;
+    }
+    t->first[t->ngroups] = index;
+    return t->ngroups++;
+}
+
+/*
+ * Returns the group of the element p, which if insert is set is the
+ * element at index of the array of the table and starts a new group when
+ * it is not found. Returns -1 for an element which is not found and -2 if
+ * out of memory.
+ */
+static npy_intp
+hash_table_lookup(hash_table *t, const char *p, npy_intp index, int insert)
+{
+    npy_uint64 key;
+    npy_intp s, group, mask = ((npy_intp)1 << t->bits) - 1;
+
+    if (!t->key(p, t->itemsize, &key)) {
+        /* a NaN */
+        if (!insert) {
+            return -1;
+        }
+        group = hash_table_new_group(t, index);
+        return group < 0 ? -2 : group;
+    }
+    for (s = hash_slot(key, t->bits); t->entries[s].group >= 0;
+                                                    s = (s + 1) & mask) {
+        const hash_entry *e = &t->entries[s];
+
+        if (e->key == key && (t->equal == NULL ||
+                t->equal(t->data + t->first[e->group] * t->stride, p,
+                         t->itemsize))) {
+            return e->group;
+        }
+    }
+    if (!insert) {
+        return -1;
+    }
+    group = hash_table_new_group(t, index);
+    if (group < 0) {
+        return -2;
+    }
+    t->entries[s].key = key;
+    t->entries[s].group = group;
+    /* keep the table at most half full */
+    if (2 * ++t->nentries > mask + 1 && hash_table_grow(t) < 0) {
+        return -2;
+    }
+    return group;
+}
+
+/* Converts obj to a one dimensional array the tables can read */
+static PyArrayObject *
+hash_table_array(PyObject *obj)
+{
+    return (PyArrayObject *)PyArray_CheckFromAny(obj, NULL, 1, 1,
+                            NPY_ARRAY_ALIGNED | NPY_ARRAY_NOTSWAPPED, NULL);
+}
+
+NPY_NO_EXPORT PyObject *
+array_unique_hash(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"ar", "return_inverse", "max_groups", NULL};
+
+    PyObject *ar_in;
+    PyArrayObject *arr = NULL, *first = NULL, *inverse = NULL;
+    int return_inverse = 0, exceeded = 0;
+    Py_ssize_t max_groups = -1;
+    npy_intp i, size, group = 0, *inv = NULL;
+    hash_table t;
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|in:_unique_hash", kwlist,
+                                    &ar_in, &return_inverse, &max_groups)) {
+        return NULL;
+    }
+    arr = hash_table_array(ar_in);
+    if (arr == NULL) {
+        return NULL;
+    }
+    size = PyArray_DIM(arr, 0);
+    if (return_inverse) {
+        inverse = (PyArrayObject *)PyArray_SimpleNew(1, &size, NPY_INTP);
+        if (inverse == NULL) {
+            goto fail;
+        }
+        inv = (npy_intp *)PyArray_DATA(inverse);
+    }
+    if (hash_table_init(&t, arr) < 0) {
+        goto fail;
+    }
+
+    NPY_BEGIN_THREADS;
+    for (i = 0; i < size; i++) {
+        group = hash_table_lookup(&t, t.data + i * t.stride, i, 1);
+        if (group < 0) {
+            break;
+        }
+        if (inv != NULL) {
+            inv[i] = group;
+        }
+        if (max_groups >= 0 && t.ngroups > max_groups) {
+            exceeded = 1;
+            break;
+        }
+    }
+    NPY_END_THREADS;
+
+    if (group < 0) {
+        hash_table_free(&t);
+        PyErr_NoMemory();
+        goto fail;
+    }
+    if (exceeded) {
+        hash_table_free(&t);
+        Py_DECREF(arr);
+        Py_XDECREF(inverse);
+        Py_RETURN_NONE;
+    }
+    first = (PyArrayObject *)PyArray_SimpleNew(1, &t.ngroups, NPY_INTP);
+    if (first == NULL) {
+        hash_table_free(&t);
+        goto fail;
+    }
+    memcpy(PyArray_DATA(first), t.first, t.ngroups * sizeof(npy_intp));
+    hash_table_free(&t);
+    Py_DECREF(arr);
+
+    if (inverse == NULL) {
+        Py_INCREF(Py_None);
+        return Py_BuildValue("NN", first, Py_None);
+    }
+    return Py_BuildValue("NN", first, inverse);
+
+fail:
+    Py_XDECREF(arr);
+    Py_XDECREF(inverse);
+    return NULL;
+}
+
+NPY_NO_EXPORT PyObject *
+array_in1d_hash(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"ar1", "ar2", NULL};
+
+    PyObject *ar1_in, *ar2_in;
+    PyArrayObject *arr1 = NULL, *arr2 = NULL, *ret = NULL;
+    npy_intp i, size, group = 0;
+    npy_bool *mask;
+    const char *data1;
+    npy_intp stride1;
+    hash_table t;
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO:_in1d_hash", kwlist,
+                                    &ar1_in, &ar2_in)) {
+        return NULL;
+    }
+    arr1 = hash_table_array(ar1_in);
+    if (arr1 == NULL) {
+        return NULL;
+    }
+    arr2 = hash_table_array(ar2_in);
+    if (arr2 == NULL) {
+        goto fail;
+    }
+    if (!PyArray_EquivTypes(PyArray_DESCR(arr1), PyArray_DESCR(arr2))) {
+        PyErr_SetString(PyExc_TypeError,
+                "the arrays must have the same data type");
+        goto fail;
+    }
+    size = PyArray_DIM(arr1, 0);
+    ret = (PyArrayObject *)PyArray_SimpleNew(1, &size, NPY_BOOL);
+    if (ret == NULL) {
+        goto fail;
+    }
+    mask = (npy_bool *)PyArray_DATA(ret);
+    data1 = PyArray_DATA(arr1);
+    stride1 = PyArray_STRIDE(arr1, 0);
+    if (hash_table_init(&t, arr2) < 0) {
+        goto fail;
+    }
+
+    NPY_BEGIN_THREADS;
+    for (i = 0; i < PyArray_DIM(arr2, 0) && group >= 0; i++) {
+        group = hash_table_lookup(&t, t.data + i * t.stride, i, 1);
+    }
+    if (group >= 0) {
+        for (i = 0; i < size; i++) {
+            mask[i] = hash_table_lookup(&t, data1 + i * stride1, 0, 0) >= 0;
+        }
+    }
+    NPY_END_THREADS;
+
+    hash_table_free(&t);
+    if (group < 0) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+    Py_DECREF(arr1);
+    Py_DECREF(arr2);
+    return (PyObject *)ret;
+
+fail:
+    Py_XDECREF(arr1);
+    Py_XDECREF(arr2);
+    Py_XDECREF(ret);
+    return NULL;
+}
@@ -0,0 +1,20 @@
+#ifndef _NPY_PRIVATE__HASHTABLE_H_
+#define _NPY_PRIVATE__HASHTABLE_H_
+
+/*
+ * This is the '_unique_hash' function exposed for calling
+ * from Python.
+ */
+NPY_NO_EXPORT PyObject *
+array_unique_hash(PyObject *NPY_UNUSED(self),
+                      PyObject *args, PyObject *kwds);
+
+/*
+ * This is the '_in1d_hash' function exposed for calling
+ * from Python.
+ */
+NPY_NO_EXPORT PyObject *
+array_in1d_hash(PyObject *NPY_UNUSED(self),
+                      PyObject *args, PyObject *kwds);
+
+#endif
@@ -19,6 +19,8 @@
 #include "lowlevel_strided_loops.h"
 #include "na_object.h"
 #include "reduction.h"
+#include "npy_sort.h"
+#include "npy_threads.h"
 
 #include "item_selection.h"
 
@@ -868,171 +870,734 @@ PyArray_Choose(PyArrayObject *ip, PyObject *op, PyArrayObject *out,
  * underlying sort function for the type is available.  Note that axis is
  * already valid. The sort functions require 1-d contiguous and well-behaved
  * data.  Therefore, a copy will be made of the data if needed before handing
- * it to the sorting routine.  An iterator is constructed and adjusted to walk
- * over all but the desired sorting axis.
+ * it to the sorting routine.
+ *
+ * The 1-d slices along the axis, the lanes, are copied a tile of
+ * neighbouring lanes at a time, so that the strided reads use whole cache
+ * lines instead of one element of each. With more than one thread set by
+ * numpy.setnumthreads the lanes are sorted concurrently on the thread pool
+ * of the umath module, and lanes too few to keep the threads busy are each
+ * split into pieces which are sorted concurrently and then merged.
+ *
+ * The partitions use the same code, with part instead of sort and the
+ * sorted indices kth to select.
  */
+
+/* Size of the buffer a tile of lanes is copied into */
+#define SORT_TILE_BYTES (256 * 1024)
+/* Tiles have at least as many lanes as fit into a cache line of the array */
+#define SORT_CACHE_LINE 64
+/* Below this many elements per task sorting is not worth threading */
+#define SORT_THREAD_MIN_SIZE 65536
+
+#define SORT_ALIGN(n) (((n) + 15) & ~(npy_intp)15)
+
+typedef struct {
+    PyArrayObject *op;
+    /* the indices of argsort and argpartition, NULL for sort */
+    PyArrayObject *ret;
+    PyArray_SortFunc *sort;
+    PyArray_PartitionFunc *part;
+    PyArray_ArgSortFunc *argsort;
+    PyArray_ArgPartitionFunc *argpart;
+    npy_intp *kth, nkth;
+    /* length of the lanes and their strides in op and ret */
+    npy_intp N, astride, rstride;
+    int elsize, swap;
+    /* whether the values and the indices are sorted in a buffer */
+    int vcopy, icopy;
+    /* the other dimensions, the last one has the smallest stride in op */
+    int nouter;
+    npy_intp outer_dims[NPY_MAXDIMS];
+    npy_intp outer_astrides[NPY_MAXDIMS], outer_rstrides[NPY_MAXDIMS];
+    npy_intp nlanes, tile;
+    /* a work area and the result for each task */
+    npy_intp ntasks;
+    char **work;
+    int *status;
+    /* set when the lanes are sorted by sort_lane_parallel */
+    struct sort_merge *merge;
+} sortlike_job;
+
+static NPY_INLINE npy_intp
+sort_intp_abs(npy_intp x)
+{
+    return (x < 0) ? -x : x;
+}
+
+static void
+sortlike_job_init(sortlike_job *job, PyArrayObject *op, PyArrayObject *ret,
+                  int axis)
+{
+    int idim, i, ndim = PyArray_NDIM(op);
+    npy_intp lane_bytes;
+
+    job->op = op;
+    job->ret = ret;
+    job->N = PyArray_DIM(op, axis);
+    job->elsize = PyArray_DESCR(op)->elsize;
+    job->swap = !PyArray_ISNOTSWAPPED(op);
+    job->astride = PyArray_STRIDE(op, axis);
+    job->vcopy = !PyArray_ISALIGNED(op) || job->swap ||
+                 job->astride != (npy_intp)job->elsize;
+    if (ret != NULL) {
+        job->rstride = PyArray_STRIDE(ret, axis);
+        job->icopy = job->rstride != (npy_intp)sizeof(npy_intp);
+    }
+    else {
+        job->rstride = 0;
+        job->icopy = 0;
+    }
+
+    /*
+     * Enumerate the lanes with the largest stride first, so neighbouring
+     * lanes are usually close in memory.
+     */
+    job->nouter = 0;
+    job->nlanes = 1;
+    for (idim = 0; idim < ndim; idim++) {
+        npy_intp astride, rstride;
+
+        if (idim == axis) {
+            continue;
+        }
+        astride = PyArray_STRIDE(op, idim);
+        rstride = ret != NULL ? PyArray_STRIDE(ret, idim) : 0;
+        for (i = job->nouter; i > 0 &&
+                sort_intp_abs(job->outer_astrides[i - 1]) <
+                                    sort_intp_abs(astride); i--) {
+            job->outer_dims[i] = job->outer_dims[i - 1];
+            job->outer_astrides[i] = job->outer_astrides[i - 1];
+            job->outer_rstrides[i] = job->outer_rstrides[i - 1];
+        }
+        job->outer_dims[i] = PyArray_DIM(op, idim);
+        job->outer_astrides[i] = astride;
+        job->outer_rstrides[i] = rstride;
+        job->nouter++;
+        job->nlanes *= PyArray_DIM(op, idim);
+    }
+
+    /* the work area of a tile holds two pointers and the buffers per lane */
+    lane_bytes = 2 * sizeof(char *) +
+                 (job->vcopy ? job->N * job->elsize : 0) +
+                 (job->icopy ? job->N * (npy_intp)sizeof(npy_intp) : 0);
+    job->tile = SORT_TILE_BYTES / lane_bytes;
+    if (job->vcopy && job->nouter > 0) {
+        npy_intp s = sort_intp_abs(job->outer_astrides[job->nouter - 1]);
+
+        if (s > 0 && s < SORT_CACHE_LINE && job->tile < SORT_CACHE_LINE / s) {
+            job->tile = SORT_CACHE_LINE / s;
+        }
+    }
+    if (job->tile > job->nlanes) {
+        job->tile = job->nlanes;
+    }
+    if (job->tile < 1) {
+        job->tile = 1;
+    }
+    job->ntasks = 1;
+    job->work = NULL;
+    job->status = NULL;
+    job->merge = NULL;
+}
+
+static npy_intp
+sortlike_work_size(sortlike_job *job)
+{
+    return SORT_ALIGN(2 * job->tile * sizeof(char *)) +
+           (job->vcopy ? SORT_ALIGN(job->tile * job->N * job->elsize) : 0) +
+           (job->icopy ? job->tile * job->N * sizeof(npy_intp) : 0);
+}
+
+/* Allocates the work areas of ntasks tasks, returns -1 on failure */
 static int
-_new_sort(PyArrayObject *op, int axis, NPY_SORTKIND which)
+sortlike_job_alloc(sortlike_job *job, npy_intp ntasks)
 {
-    PyArrayIterObject *it;
-    int needcopy = 0, swap;
-    npy_intp N, size;
-    int elsize;
-    npy_intp astride;
-    PyArray_SortFunc *sort;
-    NPY_BEGIN_THREADS_DEF;
+    npy_intp i, size = sortlike_work_size(job);
 
-    it = (PyArrayIterObject *)PyArray_IterAllButAxis((PyObject *)op, &axis);
-    swap = !PyArray_ISNOTSWAPPED(op);
-    if (it == NULL) {
+    job->ntasks = ntasks;
+    job->work = (char **)PyDataMem_NEW(ntasks *
+                                       (sizeof(char *) + sizeof(int)));
+    if (job->work == NULL) {
+        PyErr_NoMemory();
         return -1;
     }
+    job->status = (int *)(job->work + ntasks);
+    for (i = 0; i < ntasks; i++) {
+        job->status[i] = 0;
+        job->work[i] = PyDataMem_NEW(size);
+        if (job->work[i] == NULL) {
+            for (; i > 0; i--) {
+                PyDataMem_FREE(job->work[i - 1]);
+            }
+            PyDataMem_FREE(job->work);
+            job->work = NULL;
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+    return 0;
+}
 
-    NPY_BEGIN_THREADS_DESCR(PyArray_DESCR(op));
-    sort = PyArray_DESCR(op)->f->sort[which];
-    size = it->size;
-    N = PyArray_DIMS(op)[axis];
-    elsize = PyArray_DESCR(op)->elsize;
-    astride = PyArray_STRIDES(op)[axis];
+static void
+sortlike_job_free(sortlike_job *job)
+{
+    npy_intp i;
 
-    needcopy = !(PyArray_FLAGS(op) & NPY_ARRAY_ALIGNED) ||
-                (astride != (npy_intp) elsize) || swap;
-    if (needcopy) {
-        char *buffer = PyDataMem_NEW(N*elsize);
+    if (job->work != NULL) {
+        for (i = 0; i < job->ntasks; i++) {
+            PyDataMem_FREE(job->work[i]);
+        }
+        PyDataMem_FREE(job->work);
+        job->work = NULL;
+    }
+}
 
-        while (size--) {
-            _unaligned_strided_byte_copy(buffer, (npy_intp) elsize, it->dataptr,
-                                         astride, N, elsize);
-            if (swap) {
-                _strided_byte_swap(buffer, (npy_intp) elsize, N, elsize);
+/* Fills in the data pointers of n lanes starting with lane number start */
+static void
+lane_pointers(sortlike_job *job, npy_intp start, npy_intp n,
+              char **vptrs, char **rptrs)
+{
+    npy_intp coord[NPY_MAXDIMS], i;
+    char *vp = PyArray_BYTES(job->op);
+    char *rp = job->ret != NULL ? PyArray_BYTES(job->ret) : NULL;
+    /* the offset of rp, which is NULL when sorting in place */
+    npy_intp roff = 0;
+    int idim;
+
+    for (idim = job->nouter - 1; idim >= 0; idim--) {
+        coord[idim] = start % job->outer_dims[idim];
+        start /= job->outer_dims[idim];
+        vp += coord[idim] * job->outer_astrides[idim];
+        roff += coord[idim] * job->outer_rstrides[idim];
+    }
+    for (i = 0; i < n; i++) {
+        vptrs[i] = vp;
+        rptrs[i] = rp != NULL ? rp + roff : NULL;
+        for (idim = job->nouter - 1; idim >= 0; idim--) {
+            if (++coord[idim] < job->outer_dims[idim]) {
+                vp += job->outer_astrides[idim];
+                roff += job->outer_rstrides[idim];
+                break;
             }
-            if (sort(buffer, N, op) < 0) {
-                PyDataMem_FREE(buffer);
-                goto fail;
+            coord[idim] = 0;
+            vp -= (job->outer_dims[idim] - 1) * job->outer_astrides[idim];
+            roff -= (job->outer_dims[idim] - 1) * job->outer_rstrides[idim];
+        }
+    }
+}
+
+/*
+ * Copies n strided lanes of N elements into the contiguous buffer buf.
+ * The lanes are copied in blocks about a cache line wide, reading the same
+ * element of all lanes of a block before going to the next one.
+ */
+#define _LANES_COPY(size, DST, SRC) \
+        for (jb = 0; jb < n; jb += nb) { \
+            npy_intp jend = jb + nb < n ? jb + nb : n; \
+            for (i = 0; i < N; i++) { \
+                for (j = jb; j < jend; j++) { \
+                    memcpy(DST, SRC, size); \
+                } \
+            } \
+        }
+
+#define _LANES_COPY_SIZES(DST, SRC) \
+        switch (elsize) { \
+            case 1: _LANES_COPY(1, DST, SRC); break; \
+            case 2: _LANES_COPY(2, DST, SRC); break; \
+            case 4: _LANES_COPY(4, DST, SRC); break; \
+            case 8: _LANES_COPY(8, DST, SRC); break; \
+            case 16: _LANES_COPY(16, DST, SRC); break; \
+            default: _LANES_COPY(elsize, DST, SRC); break; \
+        }
+
+static void
+gather_lanes(char *buf, char **lanes, npy_intp n, npy_intp N,
+             npy_intp stride, int elsize)
+{
+    npy_intp i, j, jb, nb = elsize < SORT_CACHE_LINE ?
+                                SORT_CACHE_LINE / elsize : 1;
+
+    _LANES_COPY_SIZES(buf + (j * N + i) * elsize, lanes[j] + i * stride);
+}
+
+/* The reverse of gather_lanes */
+static void
+scatter_lanes(char **lanes, char *buf, npy_intp n, npy_intp N,
+              npy_intp stride, int elsize)
+{
+    npy_intp i, j, jb, nb = elsize < SORT_CACHE_LINE ?
+                                SORT_CACHE_LINE / elsize : 1;
+
+    _LANES_COPY_SIZES(lanes[j] + i * stride, buf + (j * N + i) * elsize);
+}
+
+#undef _LANES_COPY
+#undef _LANES_COPY_SIZES
+
+static int
+sort_lane_parallel(struct sort_merge *m, char *v, npy_intp *tosort);
+
+/* Sorts or partitions the lane v, tosort are the indices for argsort */
+static int
+sort_one_lane(sortlike_job *job, char *v, npy_intp *tosort)
+{
+    npy_intp i;
+
+    if (tosort == NULL) {
+        if (job->part != NULL) {
+            return job->part(v, job->N, job->kth, job->nkth, job->op);
+        }
+        if (job->merge != NULL) {
+            return sort_lane_parallel(job->merge, v, NULL);
+        }
+        return job->sort(v, job->N, job->op);
+    }
+    for (i = 0; i < job->N; i++) {
+        tosort[i] = i;
+    }
+    if (job->argpart != NULL) {
+        return job->argpart(v, tosort, job->N, job->kth, job->nkth, job->op);
+    }
+    if (job->merge != NULL) {
+        return sort_lane_parallel(job->merge, v, tosort);
+    }
+    return job->argsort(v, tosort, job->N, job->op);
+}
+
+/* Sorts the lanes [start, end) using the work area of a task */
+static int
+sort_lane_range(sortlike_job *job, npy_intp start, npy_intp end, char *work)
+{
+    npy_intp N = job->N, lane, n, i;
+    int elsize = job->elsize;
+    char **vptrs = (char **)work;
+    char **rptrs = vptrs + job->tile;
+    char *vbuf = work + SORT_ALIGN(2 * job->tile * sizeof(char *));
+    npy_intp *ibuf = (npy_intp *)(vbuf +
+                        (job->vcopy ? SORT_ALIGN(job->tile * N * elsize) : 0));
+
+    for (lane = start; lane < end; lane += n) {
+        n = end - lane < job->tile ? end - lane : job->tile;
+        lane_pointers(job, lane, n, vptrs, rptrs);
+        if (job->vcopy) {
+            gather_lanes(vbuf, vptrs, n, N, job->astride, elsize);
+            if (job->swap) {
+                _strided_byte_swap(vbuf, (npy_intp)elsize, n * N, elsize);
+            }
+        }
+        for (i = 0; i < n; i++) {
+            char *v = job->vcopy ? vbuf + i * N * elsize : vptrs[i];
+            npy_intp *tosort = NULL;
+
+            if (job->ret != NULL) {
+                tosort = job->icopy ? ibuf + i * N : (npy_intp *)rptrs[i];
+            }
+            if (sort_one_lane(job, v, tosort) < 0) {
+                return -1;
             }
-            if (swap) {
-                _strided_byte_swap(buffer, (npy_intp) elsize, N, elsize);
+        }
+        if (job->ret == NULL) {
+            if (job->vcopy) {
+                if (job->swap) {
+                    _strided_byte_swap(vbuf, (npy_intp)elsize, n * N, elsize);
+                }
+                scatter_lanes(vptrs, vbuf, n, N, job->astride, elsize);
             }
-            _unaligned_strided_byte_copy(it->dataptr, astride, buffer,
-                                         (npy_intp) elsize, N, elsize);
-            PyArray_ITER_NEXT(it);
         }
-        PyDataMem_FREE(buffer);
+        else if (job->icopy) {
+            scatter_lanes(rptrs, (char *)ibuf, n, N, job->rstride,
+                          sizeof(npy_intp));
+        }
+    }
+    return 0;
+}
+
+/* Sorts a share of the lanes, split at tile boundaries */
+static void
+sort_lanes_task(void *data, npy_intp itask)
+{
+    sortlike_job *job = (sortlike_job *)data;
+    npy_intp ntiles = (job->nlanes + job->tile - 1) / job->tile;
+    npy_intp start = ntiles * itask / job->ntasks * job->tile;
+    npy_intp end = ntiles * (itask + 1) / job->ntasks * job->tile;
+
+    if (end > job->nlanes) {
+        end = job->nlanes;
+    }
+    job->status[itask] = sort_lane_range(job, start, end, job->work[itask]);
+}
+
+/*
+ * A lane sorted by several threads is cut into one run per task, the runs
+ * are sorted concurrently and then merged in pairs until one is left.
+ * Every merge pass is split into equal parts of the output, the start of
+ * each part in the two runs is found by a binary search. Taking from the
+ * first run on ties keeps the sort stable.
+ */
+typedef struct sort_merge {
+    sortlike_job *job;
+    npy_ufunc_threads_api *api;
+    PyArray_CompareFunc *compare;
+    /* the values, and the indices sorted by argsort */
+    char *v;
+    npy_intp *tosort;
+    /* size of the items merged, elements or indices */
+    npy_intp isize;
+    /* the pass merges from src into dst, a buffer of N items */
+    char *src, *dst, *buffer;
+    npy_intp ntasks, nruns;
+    /* run i is [bounds[i], bounds[i + 1]) */
+    npy_intp *bounds;
+    int *status;
+} sort_merge;
+
+#define MERGE_KEY(m, p) ((m)->tosort == NULL ? (p) : \
+                         (m)->v + *(npy_intp *)(p) * (m)->job->elsize)
+#define MERGE_LT(m, a, b) \
+        ((m)->compare(MERGE_KEY(m, a), MERGE_KEY(m, b), (m)->job->op) < 0)
+
+/* The number of items taken from a in the first k of the merge of a and b */
+static npy_intp
+merge_split(sort_merge *m, char *a, npy_intp na, char *b, npy_intp nb,
+            npy_intp k)
+{
+    npy_intp lo = k > nb ? k - nb : 0, hi = k < na ? k : na;
+    npy_intp isize = m->isize;
+
+    while (lo < hi) {
+        npy_intp i = lo + ((hi - lo) >> 1);
+
+        if (MERGE_LT(m, b + (k - i - 1) * isize, a + i * isize)) {
+            hi = i;
+        }
+        else {
+            lo = i + 1;
+        }
+    }
+    return lo;
+}
+
+/* Writes items [k0, k1) of the merge of the runs [lo, mid) and [mid, hi) */
+static void
+merge_part(sort_merge *m, npy_intp lo, npy_intp mid, npy_intp hi,
+           npy_intp k0, npy_intp k1)
+{
+    npy_intp isize = m->isize, na = mid - lo, nb = hi - mid;
+    char *a = m->src + lo * isize, *b = m->src + mid * isize;
+    npy_intp i0 = merge_split(m, a, na, b, nb, k0 - lo);
+    npy_intp i1 = merge_split(m, a, na, b, nb, k1 - lo);
+    char *pa = a + i0 * isize, *pa_end = a + i1 * isize;
+    char *pb = b + (k0 - lo - i0) * isize;
+    char *pb_end = b + (k1 - lo - i1) * isize;
+    char *out = m->dst + k0 * isize;
+
+    while (pa < pa_end && pb < pb_end) {
+        if (MERGE_LT(m, pb, pa)) {
+            memcpy(out, pb, isize);
+            pb += isize;
+        }
+        else {
+            memcpy(out, pa, isize);
+            pa += isize;
+        }
+        out += isize;
+    }
+    memcpy(out, pa, pa_end - pa);
+    out += pa_end - pa;
+    memcpy(out, pb, pb_end - pb);
+}
+
+#undef MERGE_KEY
+#undef MERGE_LT
+
+static void
+sort_run_task(void *data, npy_intp itask)
+{
+    sort_merge *m = (sort_merge *)data;
+    sortlike_job *job = m->job;
+    npy_intp lo = m->bounds[itask], n = m->bounds[itask + 1] - lo;
+
+    if (m->tosort == NULL) {
+        m->status[itask] = job->sort(m->v + lo * job->elsize, n, job->op);
     }
     else {
-        while (size--) {
-            if (sort(it->dataptr, N, op) < 0) {
-                goto fail;
-            }
-            PyArray_ITER_NEXT(it);
+        m->status[itask] = job->argsort(m->v, m->tosort + lo, n, job->op);
+    }
+}
+
+static void
+merge_pass_task(void *data, npy_intp itask)
+{
+    sort_merge *m = (sort_merge *)data;
+    npy_intp N = m->job->N, r;
+    npy_intp k0 = N * itask / m->ntasks, k1 = N * (itask + 1) / m->ntasks;
+
+    for (r = 0; r < m->nruns; r += 2) {
+        npy_intp lo = m->bounds[r], mid = m->bounds[r + 1];
+        npy_intp hi = m->bounds[r + 2 < m->nruns ? r + 2 : m->nruns];
+
+        /* an odd run out is merged with an empty one, which copies it */
+        if (r + 1 == m->nruns) {
+            mid = hi;
+        }
+        if (k0 < hi && lo < k1) {
+            merge_part(m, lo, mid, hi, k0 > lo ? k0 : lo, k1 < hi ? k1 : hi);
         }
     }
-    NPY_END_THREADS_DESCR(PyArray_DESCR(op));
-    Py_DECREF(it);
-    return 0;
+}
 
- fail:
-    NPY_END_THREADS;
-    Py_DECREF(it);
+static int
+sort_lane_parallel(sort_merge *m, char *v, npy_intp *tosort)
+{
+    npy_intp N = m->job->N, i;
+    char *items = tosort == NULL ? v : (char *)tosort;
+
+    m->v = v;
+    m->tosort = tosort;
+    m->isize = tosort == NULL ? m->job->elsize : sizeof(npy_intp);
+    m->nruns = m->ntasks;
+    for (i = 0; i <= m->nruns; i++) {
+        m->bounds[i] = N * i / m->nruns;
+    }
+    m->api->run_tasks(&sort_run_task, m, m->nruns);
+    for (i = 0; i < m->nruns; i++) {
+        if (m->status[i] < 0) {
+            return -1;
+        }
+    }
+
+    m->src = items;
+    m->dst = m->buffer;
+    while (m->nruns > 1) {
+        char *tmp;
+
+        m->api->run_tasks(&merge_pass_task, m, m->ntasks);
+        for (i = 0; i < (m->nruns + 1) / 2; i++) {
+            m->bounds[i] = m->bounds[2 * i];
+        }
+        m->nruns = (m->nruns + 1) / 2;
+        m->bounds[m->nruns] = N;
+        tmp = m->src;
+        m->src = m->dst;
+        m->dst = tmp;
+    }
+    if (m->src != items) {
+        memcpy(items, m->src, N * m->isize);
+    }
     return 0;
 }
 
-static PyObject*
-_new_argsort(PyArrayObject *op, int axis, NPY_SORTKIND which)
+/*
+ * Sorts all lanes of the job, on the thread pool if that is worth it.
+ * Called with the GIL held, releases it while sorting if the type allows.
+ */
+static int
+sortlike_run(sortlike_job *job)
 {
-
-    PyArrayIterObject *it = NULL;
-    PyArrayIterObject *rit = NULL;
-    PyArrayObject *ret;
-    int needcopy = 0, i;
-    npy_intp N, size;
-    int elsize, swap;
-    npy_intp astride, rstride, *iptr;
-    PyArray_ArgSortFunc *argsort;
+    PyArray_Descr *descr = PyArray_DESCR(job->op);
+    npy_ufunc_threads_api *api = NULL;
+    npy_intp nthreads = 1, ntasks = 1, i;
+    sort_merge merge;
+    int ret = 0;
     NPY_BEGIN_THREADS_DEF;
 
-    ret = (PyArrayObject *)PyArray_New(Py_TYPE(op),
-                            PyArray_NDIM(op),
-                            PyArray_DIMS(op),
-                            NPY_INTP,
-                            NULL, NULL, 0, 0, (PyObject *)op);
-    if (ret == NULL) {
-        return NULL;
+    if (job->nlanes == 0 || job->N == 0) {
+        return 0;
     }
-    it = (PyArrayIterObject *)PyArray_IterAllButAxis((PyObject *)op, &axis);
-    rit = (PyArrayIterObject *)PyArray_IterAllButAxis((PyObject *)ret, &axis);
-    if (rit == NULL || it == NULL) {
-        goto fail;
+
+    if (job->N * job->nlanes >= 2 * SORT_THREAD_MIN_SIZE &&
+            !PyDataType_FLAGCHK(descr, NPY_NEEDS_PYAPI)) {
+        api = npy_get_ufunc_threads();
+        if (api != NULL) {
+            nthreads = api->get_num_threads();
+        }
+    }
+
+    merge.buffer = NULL;
+    if (nthreads > 1 && job->nlanes < nthreads &&
+            job->part == NULL && job->argpart == NULL &&
+            descr->f->compare != NULL &&
+            job->N >= 2 * SORT_THREAD_MIN_SIZE) {
+        /* too few lanes, sort each of them on all threads */
+        merge.job = job;
+        merge.api = api;
+        merge.compare = descr->f->compare;
+        merge.ntasks = job->N / SORT_THREAD_MIN_SIZE;
+        if (merge.ntasks > nthreads) {
+            merge.ntasks = nthreads;
+        }
+        merge.isize = job->ret == NULL ? job->elsize : sizeof(npy_intp);
+        merge.buffer = PyDataMem_NEW(job->N * merge.isize +
+                            (merge.ntasks + 1) * sizeof(npy_intp) +
+                            merge.ntasks * sizeof(int));
+        if (merge.buffer == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        merge.bounds = (npy_intp *)(merge.buffer + job->N * merge.isize);
+        merge.status = (int *)(merge.bounds + merge.ntasks + 1);
+        job->merge = &merge;
+        job->tile = 1;
     }
-    swap = !PyArray_ISNOTSWAPPED(op);
+    else if (nthreads > 1) {
+        npy_intp ntiles = (job->nlanes + job->tile - 1) / job->tile;
 
-    NPY_BEGIN_THREADS_DESCR(PyArray_DESCR(op));
-    argsort = PyArray_DESCR(op)->f->argsort[which];
-    size = it->size;
-    N = PyArray_DIMS(op)[axis];
-    elsize = PyArray_DESCR(op)->elsize;
-    astride = PyArray_STRIDES(op)[axis];
-    rstride = PyArray_STRIDE(ret,axis);
+        ntasks = job->N * job->nlanes / SORT_THREAD_MIN_SIZE;
+        if (ntasks > nthreads) {
+            ntasks = nthreads;
+        }
+        if (ntasks > ntiles) {
+            ntasks = ntiles;
+        }
+    }
 
-    needcopy = swap || !(PyArray_FLAGS(op) & NPY_ARRAY_ALIGNED) ||
-                         (astride != (npy_intp) elsize) ||
-            (rstride != sizeof(npy_intp));
-    if (needcopy) {
-        char *valbuffer, *indbuffer;
+    if (sortlike_job_alloc(job, ntasks) < 0) {
+        PyDataMem_FREE(merge.buffer);
+        return -1;
+    }
 
-        valbuffer = PyDataMem_NEW(N*elsize);
-        indbuffer = PyDataMem_NEW(N*sizeof(npy_intp));
-        while (size--) {
-            _unaligned_strided_byte_copy(valbuffer, (npy_intp) elsize, it->dataptr,
-                                         astride, N, elsize);
-            if (swap) {
-                _strided_byte_swap(valbuffer, (npy_intp) elsize, N, elsize);
-            }
-            iptr = (npy_intp *)indbuffer;
-            for (i = 0; i < N; i++) {
-                *iptr++ = i;
-            }
-            if (argsort(valbuffer, (npy_intp *)indbuffer, N, op) < 0) {
-                PyDataMem_FREE(valbuffer);
-                PyDataMem_FREE(indbuffer);
-                goto fail;
-            }
-            _unaligned_strided_byte_copy(rit->dataptr, rstride, indbuffer,
-                                         sizeof(npy_intp), N, sizeof(npy_intp));
-            PyArray_ITER_NEXT(it);
-            PyArray_ITER_NEXT(rit);
-        }
-        PyDataMem_FREE(valbuffer);
-        PyDataMem_FREE(indbuffer);
+    NPY_BEGIN_THREADS_DESCR(descr);
+    if (ntasks > 1) {
+        api->run_tasks(&sort_lanes_task, job, ntasks);
     }
     else {
-        while (size--) {
-            iptr = (npy_intp *)rit->dataptr;
-            for (i = 0; i < N; i++) {
-                *iptr++ = i;
-            }
-            if (argsort(it->dataptr, (npy_intp *)rit->dataptr, N, op) < 0) {
-                goto fail;
+        sort_lanes_task(job, 0);
+    }
+    NPY_END_THREADS_DESCR(descr);
+
+    for (i = 0; i < ntasks; i++) {
+        if (job->status[i] < 0) {
+            if (!PyErr_Occurred()) {
+                PyErr_NoMemory();
             }
-            PyArray_ITER_NEXT(it);
-            PyArray_ITER_NEXT(rit);
+            ret = -1;
+            break;
         }
     }
+    sortlike_job_free(job);
+    PyDataMem_FREE(merge.buffer);
+    return ret;
+}
 
-    NPY_END_THREADS_DESCR(PyArray_DESCR(op));
+static int
+_new_sortlike(PyArrayObject *op, int axis, PyArray_SortFunc *sort,
+              PyArray_PartitionFunc *part, npy_intp *kth, npy_intp nkth)
+{
+    sortlike_job job;
+
+    sortlike_job_init(&job, op, NULL, axis);
+    job.sort = sort;
+    job.part = part;
+    job.argsort = NULL;
+    job.argpart = NULL;
+    job.kth = kth;
+    job.nkth = nkth;
+    return sortlike_run(&job);
+}
 
-    Py_DECREF(it);
-    Py_DECREF(rit);
+static PyObject*
+_new_argsortlike(PyArrayObject *op, int axis, PyArray_ArgSortFunc *argsort,
+                 PyArray_ArgPartitionFunc *argpart,
+                 npy_intp *kth, npy_intp nkth)
+{
+    PyArrayObject *ret;
+    sortlike_job job;
+
+    ret = (PyArrayObject *)PyArray_New(Py_TYPE(op),
+                            PyArray_NDIM(op),
+                            PyArray_DIMS(op),
+                            NPY_INTP,
+                            NULL, NULL, 0, 0, (PyObject *)op);
+    if (ret == NULL) {
+        return NULL;
+    }
+    sortlike_job_init(&job, op, ret, axis);
+    job.sort = NULL;
+    job.part = NULL;
+    job.argsort = argsort;
+    job.argpart = argpart;
+    job.kth = kth;
+    job.nkth = nkth;
+    if (sortlike_run(&job) < 0) {
+        Py_DECREF(ret);
+        return NULL;
+    }
     return (PyObject *)ret;
+}
 
- fail:
-    NPY_END_THREADS;
-    Py_DECREF(ret);
-    Py_XDECREF(it);
-    Py_XDECREF(rit);
-    return NULL;
+
+/*
+ * The radix sorts have no slot in PyArray_ArrFuncs, they only exist for
+ * the integer types. Other types use their merge sort instead, which is
+ * stable as well.
+ */
+static PyArray_SortFunc *
+get_sort_func(PyArray_Descr *descr, NPY_SORTKIND which)
+{
+    if (which == NPY_RADIXSORT) {
+        switch (descr->type_num) {
+            case NPY_BOOL:
+                return (PyArray_SortFunc *)&radixsort_bool;
+            case NPY_BYTE:
+                return (PyArray_SortFunc *)&radixsort_byte;
+            case NPY_UBYTE:
+                return (PyArray_SortFunc *)&radixsort_ubyte;
+            case NPY_SHORT:
+                return (PyArray_SortFunc *)&radixsort_short;
+            case NPY_USHORT:
+                return (PyArray_SortFunc *)&radixsort_ushort;
+            case NPY_INT:
+                return (PyArray_SortFunc *)&radixsort_int;
+            case NPY_UINT:
+                return (PyArray_SortFunc *)&radixsort_uint;
+            case NPY_LONG:
+                return (PyArray_SortFunc *)&radixsort_long;
+            case NPY_ULONG:
+                return (PyArray_SortFunc *)&radixsort_ulong;
+            case NPY_LONGLONG:
+                return (PyArray_SortFunc *)&radixsort_longlong;
+            case NPY_ULONGLONG:
+                return (PyArray_SortFunc *)&radixsort_ulonglong;
+        }
+        which = NPY_MERGESORT;
+    }
+    return descr->f->sort[which];
 }
 
+static PyArray_ArgSortFunc *
+get_argsort_func(PyArray_Descr *descr, NPY_SORTKIND which)
+{
+    if (which == NPY_RADIXSORT) {
+        switch (descr->type_num) {
+            case NPY_BOOL:
+                return (PyArray_ArgSortFunc *)&aradixsort_bool;
+            case NPY_BYTE:
+                return (PyArray_ArgSortFunc *)&aradixsort_byte;
+            case NPY_UBYTE:
+                return (PyArray_ArgSortFunc *)&aradixsort_ubyte;
+            case NPY_SHORT:
+                return (PyArray_ArgSortFunc *)&aradixsort_short;
+            case NPY_USHORT:
+                return (PyArray_ArgSortFunc *)&aradixsort_ushort;
+            case NPY_INT:
+                return (PyArray_ArgSortFunc *)&aradixsort_int;
+            case NPY_UINT:
+                return (PyArray_ArgSortFunc *)&aradixsort_uint;
+            case NPY_LONG:
+                return (PyArray_ArgSortFunc *)&aradixsort_long;
+            case NPY_ULONG:
+                return (PyArray_ArgSortFunc *)&aradixsort_ulong;
+            case NPY_LONGLONG:
+                return (PyArray_ArgSortFunc *)&aradixsort_longlong;
+            case NPY_ULONGLONG:
+                return (PyArray_ArgSortFunc *)&aradixsort_ulonglong;
+        }
+        which = NPY_MERGESORT;
+    }
+    return descr->f->argsort[which];
+}
 
 /* Be sure to save this global_compare when necessary */
 static PyArrayObject *global_obj;
@@ -1102,7 +1667,12 @@ PyArray_Sort(PyArrayObject *op, int axis, NPY_SORTKIND which)
     PyArrayObject *ap = NULL, *store_arr = NULL;
     char *ip;
     int i, n, m, elsize, orign;
+    PyArray_SortFunc *sort;
 
+    if ((int)which < 0 || which > NPY_RADIXSORT) {
+        PyErr_SetString(PyExc_ValueError, "not a valid sort kind");
+        return -1;
+    }
     n = PyArray_NDIM(op);
     if ((n == 0) || (PyArray_SIZE(op) == 1)) {
         return 0;
@@ -1121,8 +1691,9 @@ PyArray_Sort(PyArrayObject *op, int axis, NPY_SORTKIND which)
     }
 
     /* Determine if we should use type-specific algorithm or not */
-    if (PyArray_DESCR(op)->f->sort[which] != NULL) {
-        return _new_sort(op, axis, which);
+    sort = get_sort_func(PyArray_DESCR(op), which);
+    if (sort != NULL) {
+        return _new_sortlike(op, axis, sort, NULL, NULL, 0);
     }
     if ((which != NPY_QUICKSORT)
         || PyArray_DESCR(op)->f->compare == NULL) {
@@ -1194,7 +1765,12 @@ PyArray_ArgSort(PyArrayObject *op, int axis, NPY_SORTKIND which)
     npy_intp i, j, n, m, orign;
     int argsort_elsize;
     char *store_ptr;
+    PyArray_ArgSortFunc *argsort;
 
+    if ((int)which < 0 || which > NPY_RADIXSORT) {
+        PyErr_SetString(PyExc_ValueError, "not a valid sort kind");
+        return NULL;
+    }
     n = PyArray_NDIM(op);
     if ((n == 0) || (PyArray_SIZE(op) == 1)) {
         ret = (PyArrayObject *)PyArray_New(Py_TYPE(op), PyArray_NDIM(op),
@@ -1214,8 +1790,10 @@ PyArray_ArgSort(PyArrayObject *op, int axis, NPY_SORTKIND which)
         return NULL;
     }
     /* Determine if we should use new algorithm or not */
-    if (PyArray_DESCR(op2)->f->argsort[which] != NULL) {
-        ret = (PyArrayObject *)_new_argsort(op2, axis, which);
+    argsort = get_argsort_func(PyArray_DESCR(op2), which);
+    if (argsort != NULL) {
+        ret = (PyArrayObject *)_new_argsortlike(op2, axis, argsort,
+                                                NULL, NULL, 0);
         Py_DECREF(op2);
         return (PyObject *)ret;
     }
@@ -1276,6 +1854,220 @@ PyArray_ArgSort(PyArrayObject *op, int axis, NPY_SORTKIND which)
 }
 
 
+/*
+ * The selection functions of the builtin numeric types. The other types
+ * are partitioned by sorting them.
+ */
+static const struct {
+    int typenum;
+    PyArray_PartitionFunc *part;
+    PyArray_ArgPartitionFunc *argpart;
+} partition_funcs[] = {
+    {NPY_BOOL, (PyArray_PartitionFunc *)&introselect_bool,
+               (PyArray_ArgPartitionFunc *)&aintroselect_bool},
+    {NPY_BYTE, (PyArray_PartitionFunc *)&introselect_byte,
+               (PyArray_ArgPartitionFunc *)&aintroselect_byte},
+    {NPY_UBYTE, (PyArray_PartitionFunc *)&introselect_ubyte,
+                (PyArray_ArgPartitionFunc *)&aintroselect_ubyte},
+    {NPY_SHORT, (PyArray_PartitionFunc *)&introselect_short,
+                (PyArray_ArgPartitionFunc *)&aintroselect_short},
+    {NPY_USHORT, (PyArray_PartitionFunc *)&introselect_ushort,
+                 (PyArray_ArgPartitionFunc *)&aintroselect_ushort},
+    {NPY_INT, (PyArray_PartitionFunc *)&introselect_int,
+              (PyArray_ArgPartitionFunc *)&aintroselect_int},
+    {NPY_UINT, (PyArray_PartitionFunc *)&introselect_uint,
+               (PyArray_ArgPartitionFunc *)&aintroselect_uint},
+    {NPY_LONG, (PyArray_PartitionFunc *)&introselect_long,
+               (PyArray_ArgPartitionFunc *)&aintroselect_long},
+    {NPY_ULONG, (PyArray_PartitionFunc *)&introselect_ulong,
+                (PyArray_ArgPartitionFunc *)&aintroselect_ulong},
+    {NPY_LONGLONG, (PyArray_PartitionFunc *)&introselect_longlong,
+                   (PyArray_ArgPartitionFunc *)&aintroselect_longlong},
+    {NPY_ULONGLONG, (PyArray_PartitionFunc *)&introselect_ulonglong,
+                    (PyArray_ArgPartitionFunc *)&aintroselect_ulonglong},
+    {NPY_HALF, (PyArray_PartitionFunc *)&introselect_half,
+               (PyArray_ArgPartitionFunc *)&aintroselect_half},
+    {NPY_FLOAT, (PyArray_PartitionFunc *)&introselect_float,
+                (PyArray_ArgPartitionFunc *)&aintroselect_float},
+    {NPY_DOUBLE, (PyArray_PartitionFunc *)&introselect_double,
+                 (PyArray_ArgPartitionFunc *)&aintroselect_double},
+    {NPY_LONGDOUBLE, (PyArray_PartitionFunc *)&introselect_longdouble,
+                     (PyArray_ArgPartitionFunc *)&aintroselect_longdouble},
+    {NPY_CFLOAT, (PyArray_PartitionFunc *)&introselect_cfloat,
+                 (PyArray_ArgPartitionFunc *)&aintroselect_cfloat},
+    {NPY_CDOUBLE, (PyArray_PartitionFunc *)&introselect_cdouble,
+                  (PyArray_ArgPartitionFunc *)&aintroselect_cdouble},
+    {NPY_CLONGDOUBLE, (PyArray_PartitionFunc *)&introselect_clongdouble,
+                      (PyArray_ArgPartitionFunc *)&aintroselect_clongdouble}
+};
+
+static int
+get_partition_funcs(PyArray_Descr *descr, PyArray_PartitionFunc **part,
+                    PyArray_ArgPartitionFunc **argpart)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(partition_funcs)/sizeof(partition_funcs[0]); i++) {
+        if (partition_funcs[i].typenum == descr->type_num) {
+            *part = partition_funcs[i].part;
+            *argpart = partition_funcs[i].argpart;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Converts kth to a sorted intp array of indices into an axis of length n,
+ * wrapping negative values. Returns a new reference.
+ */
+static PyArrayObject *
+partition_prep_kth_array(PyArrayObject *ktharray, npy_intp n)
+{
+    PyArrayObject *kthrvl;
+    npy_intp *kth, nkth, i;
+
+    if (PyArray_ISBOOL(ktharray)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Booleans unacceptable as partition index");
+        return NULL;
+    }
+    kthrvl = (PyArrayObject *)PyArray_FromAny((PyObject *)ktharray,
+                        PyArray_DescrFromType(NPY_INTP), 0, 1,
+                        NPY_ARRAY_DEFAULT | NPY_ARRAY_ENSURECOPY, NULL);
+    if (kthrvl == NULL) {
+        return NULL;
+    }
+
+    kth = (npy_intp *)PyArray_DATA(kthrvl);
+    nkth = PyArray_SIZE(kthrvl);
+    for (i = 0; i < nkth; i++) {
+        npy_intp k = kth[i] < 0 ? kth[i] + n : kth[i];
+
+        if (k < 0 || k >= n) {
+            PyErr_Format(PyExc_ValueError, "kth(=%" NPY_INTP_FMT ") "
+                         "out of bounds (%" NPY_INTP_FMT ")", kth[i], n);
+            Py_DECREF(kthrvl);
+            return NULL;
+        }
+        kth[i] = k;
+    }
+
+    /* the selections go from the smallest kth to the largest */
+    if (PyArray_NDIM(kthrvl) == 1 &&
+            PyArray_Sort(kthrvl, 0, NPY_QUICKSORT) < 0) {
+        Py_DECREF(kthrvl);
+        return NULL;
+    }
+    return kthrvl;
+}
+
+/*
+ * Partition an array in-place, so that the elements at the positions kth
+ * along axis are those of the sorted array, with no larger elements in
+ * front of and no smaller elements behind each of them.
+ */
+NPY_NO_EXPORT int
+PyArray_Partition(PyArrayObject *op, PyArrayObject *ktharray, int axis,
+                  NPY_SELECTKIND which)
+{
+    PyArrayObject *kthrvl;
+    PyArray_PartitionFunc *part;
+    PyArray_ArgPartitionFunc *argpart;
+    int n, ret;
+
+    if ((int)which < 0 || which >= NPY_NSELECTS) {
+        PyErr_SetString(PyExc_ValueError, "not a valid partition kind");
+        return -1;
+    }
+    n = PyArray_NDIM(op);
+    if (n == 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Cannot partition a 0-d array");
+        return -1;
+    }
+    if (axis < 0) {
+        axis += n;
+    }
+    if ((axis < 0) || (axis >= n)) {
+        PyErr_Format(PyExc_ValueError, "axis(=%d) out of bounds", axis);
+        return -1;
+    }
+    if (!PyArray_ISWRITEABLE(op)) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "attempted partition on unwriteable array.");
+        return -1;
+    }
+
+    kthrvl = partition_prep_kth_array(ktharray, PyArray_DIM(op, axis));
+    if (kthrvl == NULL) {
+        return -1;
+    }
+
+    if (get_partition_funcs(PyArray_DESCR(op), &part, &argpart)) {
+        ret = _new_sortlike(op, axis, NULL, part,
+                            (npy_intp *)PyArray_DATA(kthrvl),
+                            PyArray_SIZE(kthrvl));
+    }
+    else {
+        /* a sorted array is partitioned for any kth */
+        ret = PyArray_Sort(op, axis, NPY_QUICKSORT);
+    }
+
+    Py_DECREF(kthrvl);
+    return ret;
+}
+
+/*
+ * ArgPartition an array, returning the indices which would partition it
+ * as PyArray_Partition does.
+ */
+NPY_NO_EXPORT PyObject *
+PyArray_ArgPartition(PyArrayObject *op, PyArrayObject *ktharray, int axis,
+                     NPY_SELECTKIND which)
+{
+    PyArrayObject *op2, *kthrvl;
+    PyArray_PartitionFunc *part;
+    PyArray_ArgPartitionFunc *argpart;
+    PyObject *ret;
+
+    if ((int)which < 0 || which >= NPY_NSELECTS) {
+        PyErr_SetString(PyExc_ValueError, "not a valid partition kind");
+        return NULL;
+    }
+    if (PyArray_NDIM(op) == 0) {
+        PyErr_SetString(PyExc_ValueError,
+                        "Cannot partition a 0-d array");
+        return NULL;
+    }
+
+    /* Creates new reference op2 */
+    if ((op2=(PyArrayObject *)PyArray_CheckAxis(op, &axis, 0)) == NULL) {
+        return NULL;
+    }
+
+    kthrvl = partition_prep_kth_array(ktharray, PyArray_DIM(op2, axis));
+    if (kthrvl == NULL) {
+        Py_DECREF(op2);
+        return NULL;
+    }
+
+    if (get_partition_funcs(PyArray_DESCR(op2), &part, &argpart)) {
+        ret = _new_argsortlike(op2, axis, NULL, argpart,
+                               (npy_intp *)PyArray_DATA(kthrvl),
+                               PyArray_SIZE(kthrvl));
+    }
+    else {
+        /* the indices which sort the array partition it for any kth */
+        ret = PyArray_ArgSort(op2, axis, NPY_QUICKSORT);
+    }
+
+    Py_DECREF(kthrvl);
+    Py_DECREF(op2);
+    return ret;
+}
+
+
 /*NUMPY_API
  *LexSort an array providing indices that will sort a collection of arrays
  *lexicographically.  The first key is sorted on first, followed by the second key
@@ -1483,6 +2275,10 @@ PyArray_LexSort(PyObject *sort_keys, int axis)
 
  fail:
     NPY_END_THREADS;
+    if (!PyErr_Occurred()) {
+        /* the sort functions only fail for lack of memory */
+        PyErr_NoMemory();
+    }
     Py_XDECREF(rit);
     Py_XDECREF(ret);
     for (i = 0; i < n; i++) {
@@ -1708,7 +2504,9 @@ local_argsearch_right(PyArrayObject *arr, PyArrayObject *key,
  *
  * Notes
  * -----
- * Binary search is used to find the indexes.
+ * Binary search is used to find the indexes. For the numeric types keys
+ * which are sorted themselves are searched starting from the index found
+ * for the previous key.
  */
 NPY_NO_EXPORT PyObject *
 PyArray_SearchSorted(PyArrayObject *op1, PyObject *op2,
@@ -1720,6 +2518,8 @@ PyArray_SearchSorted(PyArrayObject *op1, PyObject *op2,
     PyArrayObject *sorter = NULL;
     PyArrayObject *ret = NULL;
     PyArray_Descr *dtype;
+    npy_binsearch_func *binsearch;
+    npy_argbinsearch_func *argbinsearch;
     NPY_BEGIN_THREADS_DEF;
 
     /* Find common type */
@@ -1794,8 +2594,20 @@ PyArray_SearchSorted(PyArrayObject *op1, PyObject *op2,
         goto fail;
     }
 
+    /* the numeric types have their own searches, the others use compare */
+    binsearch = npy_get_binsearch_func(PyArray_DESCR(ap2)->type_num, side);
+    argbinsearch = npy_get_argbinsearch_func(PyArray_DESCR(ap2)->type_num,
+                                             side);
+
     if (ap3 == NULL) {
-        if (side == NPY_SEARCHLEFT) {
+        if (binsearch != NULL) {
+            NPY_BEGIN_THREADS;
+            binsearch(PyArray_DATA(ap1), PyArray_SIZE(ap1),
+                      PyArray_DATA(ap2), PyArray_SIZE(ap2),
+                      (npy_intp *)PyArray_DATA(ret));
+            NPY_END_THREADS;
+        }
+        else if (side == NPY_SEARCHLEFT) {
             NPY_BEGIN_THREADS_DESCR(PyArray_DESCR(ap2));
             local_search_left(ap1, ap2, ret);
             NPY_END_THREADS_DESCR(PyArray_DESCR(ap2));
@@ -1809,7 +2621,15 @@ PyArray_SearchSorted(PyArrayObject *op1, PyObject *op2,
     else {
         int err=0;
 
-        if (side == NPY_SEARCHLEFT) {
+        if (argbinsearch != NULL) {
+            NPY_BEGIN_THREADS;
+            err = argbinsearch(PyArray_DATA(ap1), PyArray_SIZE(ap1),
+                               PyArray_DATA(ap2), PyArray_SIZE(ap2),
+                               (npy_intp *)PyArray_DATA(sorter),
+                               (npy_intp *)PyArray_DATA(ret));
+            NPY_END_THREADS;
+        }
+        else if (side == NPY_SEARCHLEFT) {
             NPY_BEGIN_THREADS_DESCR(PyArray_DESCR(ap2));
             err = local_argsearch_left(ap1, ap2, sorter, ret);
             NPY_END_THREADS_DESCR(PyArray_DESCR(ap2));
@@ -37,6 +37,23 @@ NPY_NO_EXPORT PyObject *
 PyArray_ReduceCountNonzero(PyArrayObject *arr, PyArrayObject *out,
                         npy_bool *axis_flags, int skipna, int keepdims);
 
+/*
+ * Partitions op in-place along axis, so that the elements at the
+ * indices in ktharray are in their sorted positions.
+ *
+ * Returns 0 on success, -1 on failure.
+ */
+NPY_NO_EXPORT int
+PyArray_Partition(PyArrayObject *op, PyArrayObject *ktharray, int axis,
+                  NPY_SELECTKIND which);
+
+/*
+ * The indices which would partition op along axis.
+ */
+NPY_NO_EXPORT PyObject *
+PyArray_ArgPartition(PyArrayObject *op, PyArrayObject *ktharray, int axis,
+                     NPY_SELECTKIND which);
+
 
 
 #endif
@@ -22,6 +22,7 @@
 #include "boolean_ops.h"
 
 #include "methods.h"
+#include "alloc.h"
 
 
 /* NpyArg_ParseKeywords
@@ -1358,6 +1359,154 @@ array_argsort(PyArrayObject *self, PyObject *args, PyObject *kwds)
     return PyArray_Return((PyArrayObject *)res);
 }
 
+static PyObject *
+array_partition(PyArrayObject *self, PyObject *args, PyObject *kwds)
+{
+    int axis=-1;
+    int val;
+    NPY_SELECTKIND sortkind = NPY_INTROSELECT;
+    PyObject *order = NULL;
+    PyArray_Descr *saved = NULL;
+    PyArray_Descr *newd;
+    static char *kwlist[] = {"kth", "axis", "kind", "order", NULL};
+    PyArrayObject *ktharray;
+    PyObject *kthobj;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O&O&O", kwlist,
+                                    &kthobj,
+                                    PyArray_AxisConverter, &axis,
+                                    PyArray_SelectkindConverter, &sortkind,
+                                    &order)) {
+        return NULL;
+    }
+    if (order == Py_None) {
+        order = NULL;
+    }
+    if (order != NULL) {
+        PyObject *new_name;
+        PyObject *_numpy_internal;
+        saved = PyArray_DESCR(self);
+        if (!PyDataType_HASFIELDS(saved)) {
+            PyErr_SetString(PyExc_ValueError, "Cannot specify " \
+                            "order when the array has no fields.");
+            return NULL;
+        }
+        _numpy_internal = PyImport_ImportModule("numpy.core._internal");
+        if (_numpy_internal == NULL) {
+            return NULL;
+        }
+        new_name = PyObject_CallMethod(_numpy_internal, "_newnames",
+                                       "OO", saved, order);
+        Py_DECREF(_numpy_internal);
+        if (new_name == NULL) {
+            return NULL;
+        }
+        newd = PyArray_DescrNew(saved);
+        Py_DECREF(newd->names);
+        newd->names = new_name;
+        ((PyArrayObject_fields *)self)->descr = newd;
+    }
+
+    ktharray = (PyArrayObject *)PyArray_FromAny(kthobj, NULL, 0, 1,
+                                                NPY_ARRAY_DEFAULT, NULL);
+    if (ktharray == NULL) {
+        val = -1;
+    }
+    else if (axis == NPY_MAXDIMS) {
+        /* The flattened array is partitioned in place through a view */
+        PyArrayObject *flat = NULL;
+
+        if (!PyArray_ISCONTIGUOUS(self)) {
+            PyErr_SetString(PyExc_ValueError,
+                    "axis=None requires a C contiguous array");
+        }
+        else {
+            flat = (PyArrayObject *)PyArray_Ravel(self, NPY_CORDER);
+        }
+        val = (flat == NULL) ? -1 :
+                        PyArray_Partition(flat, ktharray, 0, sortkind);
+        Py_XDECREF(flat);
+        Py_DECREF(ktharray);
+    }
+    else {
+        val = PyArray_Partition(self, ktharray, axis, sortkind);
+        Py_DECREF(ktharray);
+    }
+
+    if (order != NULL) {
+        Py_XDECREF(PyArray_DESCR(self));
+        ((PyArrayObject_fields *)self)->descr = saved;
+    }
+    if (val < 0) {
+        return NULL;
+    }
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+array_argpartition(PyArrayObject *self, PyObject *args, PyObject *kwds)
+{
+    int axis = -1;
+    NPY_SELECTKIND sortkind = NPY_INTROSELECT;
+    PyObject *order = NULL, *res;
+    PyArray_Descr *newd, *saved=NULL;
+    static char *kwlist[] = {"kth", "axis", "kind", "order", NULL};
+    PyObject *kthobj;
+    PyArrayObject *ktharray;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O&O&O", kwlist,
+                                     &kthobj,
+                                     PyArray_AxisConverter, &axis,
+                                     PyArray_SelectkindConverter, &sortkind,
+                                     &order)) {
+        return NULL;
+    }
+    if (order == Py_None) {
+        order = NULL;
+    }
+    if (order != NULL) {
+        PyObject *new_name;
+        PyObject *_numpy_internal;
+        saved = PyArray_DESCR(self);
+        if (!PyDataType_HASFIELDS(saved)) {
+            PyErr_SetString(PyExc_ValueError, "Cannot specify "
+                            "order when the array has no fields.");
+            return NULL;
+        }
+        _numpy_internal = PyImport_ImportModule("numpy.core._internal");
+        if (_numpy_internal == NULL) {
+            return NULL;
+        }
+        new_name = PyObject_CallMethod(_numpy_internal, "_newnames",
+                                       "OO", saved, order);
+        Py_DECREF(_numpy_internal);
+        if (new_name == NULL) {
+            return NULL;
+        }
+        newd = PyArray_DescrNew(saved);
+        Py_DECREF(newd->names);
+        newd->names = new_name;
+        ((PyArrayObject_fields *)self)->descr = newd;
+    }
+
+    ktharray = (PyArrayObject *)PyArray_FromAny(kthobj, NULL, 0, 1,
+                                                NPY_ARRAY_DEFAULT, NULL);
+    if (ktharray == NULL) {
+        res = NULL;
+    }
+    else {
+        res = PyArray_ArgPartition(self, ktharray, axis, sortkind);
+        Py_DECREF(ktharray);
+    }
+
+    if (order != NULL) {
+        Py_XDECREF(PyArray_DESCR(self));
+        ((PyArrayObject_fields *)self)->descr = saved;
+    }
+    return PyArray_Return((PyArrayObject *)res);
+}
+
 static PyObject *
 array_searchsorted(PyArrayObject *self, PyObject *args, PyObject *kwds)
 {
@@ -1692,27 +1841,26 @@ array_setstate(PyArrayObject *self, PyObject *args)
 
     if ((PyArray_FLAGS(self) & NPY_ARRAY_OWNDATA)) {
         if (PyArray_DATA(self) != NULL) {
-            PyDataMem_FREE(PyArray_DATA(self));
+            /* The size of the old data is unknown as the dtype is replaced */
+            npy_data_free(PyArray_DATA(self), 0, fa->mem_handler);
         }
+        fa->mem_handler = NULL;
         PyArray_CLEARFLAGS(self, NPY_ARRAY_OWNDATA);
     }
     Py_XDECREF(PyArray_BASE(self));
 
     PyArray_CLEARFLAGS(self, NPY_ARRAY_UPDATEIFCOPY);
 
-    if (PyArray_DIMS(self) != NULL) {
-        PyDimMem_FREE(PyArray_DIMS(self));
-        fa->dimensions = NULL;
-    }
+    npy_dims_free(fa);
 
     fa->flags = NPY_ARRAY_DEFAULT;
 
     fa->nd = nd;
 
     if (nd > 0) {
-        fa->dimensions = PyDimMem_NEW(3*nd);
-        fa->strides = PyArray_DIMS(self) + nd;
-        fa->maskna_strides = PyArray_DIMS(self) + 2*nd;
+        if (npy_dims_alloc(fa, nd) < 0) {
+            return PyErr_NoMemory();
+        }
         memcpy(PyArray_DIMS(self), dimensions, sizeof(npy_intp)*nd);
         _array_fill_strides(PyArray_STRIDES(self), dimensions, nd,
                                PyArray_DESCR(self)->elsize,
@@ -1732,10 +1880,10 @@ array_setstate(PyArrayObject *self, PyObject *args)
         if (!_IsAligned(self) || swap) {
 #endif
             npy_intp num = PyArray_NBYTES(self);
-            fa->data = PyDataMem_NEW(num);
+            fa->data = npy_data_alloc(num, &fa->mem_handler);
             if (PyArray_DATA(self) == NULL) {
                 fa->nd = 0;
-                PyDimMem_FREE(PyArray_DIMS(self));
+                npy_dims_free(fa);
                 Py_DECREF(rawdata);
                 return PyErr_NoMemory();
             }
@@ -1773,13 +1921,11 @@ array_setstate(PyArrayObject *self, PyObject *args)
         }
     }
     else {
-        fa->data = PyDataMem_NEW(PyArray_NBYTES(self));
+        fa->data = npy_data_alloc(PyArray_NBYTES(self), &fa->mem_handler);
         if (PyArray_DATA(self) == NULL) {
             fa->nd = 0;
             fa->data = PyDataMem_NEW(PyArray_DESCR(self)->elsize);
-            if (PyArray_DIMS(self)) {
-                PyDimMem_FREE(PyArray_DIMS(self));
-            }
+            npy_dims_free(fa);
             return PyErr_NoMemory();
         }
         if (PyDataType_FLAGCHK(PyArray_DESCR(self), NPY_NEEDS_INIT)) {
@@ -2379,6 +2525,9 @@ NPY_NO_EXPORT PyMethodDef array_methods[] = {
     {"argmin",
         (PyCFunction)array_argmin,
         METH_VARARGS | METH_KEYWORDS, NULL},
+    {"argpartition",
+        (PyCFunction)array_argpartition,
+        METH_VARARGS | METH_KEYWORDS, NULL},
     {"argsort",
         (PyCFunction)array_argsort,
         METH_VARARGS | METH_KEYWORDS, NULL},
@@ -2451,6 +2600,9 @@ NPY_NO_EXPORT PyMethodDef array_methods[] = {
     {"nonzero",
         (PyCFunction)array_nonzero,
         METH_VARARGS, NULL},
+    {"partition",
+        (PyCFunction)array_partition,
+        METH_VARARGS | METH_KEYWORDS, NULL},
     {"prod",
         (PyCFunction)array_prod,
         METH_VARARGS | METH_KEYWORDS, NULL},
@@ -35,6 +35,9 @@ NPY_NO_EXPORT int NPY_NUMUSERTYPES = 0;
 #include "arraytypes.h"
 #include "arrayobject.h"
 #include "hashdescr.h"
+#include "hashtable.h"
+#include "alloc.h"
+#include "textreading.h"
 #include "descriptor.h"
 #include "calculation.h"
 #include "number.h"
@@ -54,6 +57,7 @@ NPY_NO_EXPORT int NPY_NUMUSERTYPES = 0;
 #include "na_object.h"
 #include "na_mask.h"
 #include "reduction.h"
+#include "gemm.h"
 
 /* Only here for API compatibility */
 NPY_NO_EXPORT PyTypeObject PyBigArray_Type;
@@ -819,6 +823,75 @@ new_array_for_sum(PyArrayObject *ap1, PyArrayObject *ap2, PyArrayObject* out,
     return ret;
 }
 
+/*
+ * Computes the sum product of ap1 and ap2 into the C contiguous ret with
+ * npy_gemm, summing over the last axis of ap1 and the axis axis2 of ap2,
+ * both of length l. Returns 1 when done and 0 when the product is too
+ * small or of a type npy_gemm does not handle, so that the caller uses the
+ * dotfunc instead.
+ */
+static int
+gemm_sum_product(PyArrayObject *ap1, PyArrayObject *ap2, int axis2,
+                 PyArrayObject *ret, npy_intp l)
+{
+    PyArrayIterObject *it;
+    npy_intp m, n, i, *offsets;
+    npy_ufunc_threads_api *threads;
+    int axis, res;
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!npy_gemm_supported(PyArray_TYPE(ret)) || l == 0) {
+        return 0;
+    }
+    m = PyArray_SIZE(ap1) / l;
+    n = PyArray_SIZE(ap2) / l;
+    /* a single column is streamed faster by the dotfunc than packed */
+    if (n < 2 || m*n*l < NPY_GEMM_MIN_WORK) {
+        return 0;
+    }
+    offsets = PyArray_malloc((m + n)*sizeof(npy_intp));
+    if (offsets == NULL) {
+        return 0;
+    }
+    axis = PyArray_NDIM(ap1) - 1;
+    it = (PyArrayIterObject *)PyArray_IterAllButAxis((PyObject *)ap1, &axis);
+    if (it == NULL) {
+        PyErr_Clear();
+        PyArray_free(offsets);
+        return 0;
+    }
+    for (i = 0; i < m; i++) {
+        offsets[i] = it->dataptr - PyArray_BYTES(ap1);
+        PyArray_ITER_NEXT(it);
+    }
+    Py_DECREF(it);
+    it = (PyArrayIterObject *)PyArray_IterAllButAxis((PyObject *)ap2, &axis2);
+    if (it == NULL) {
+        PyErr_Clear();
+        PyArray_free(offsets);
+        return 0;
+    }
+    for (i = 0; i < n; i++) {
+        offsets[m + i] = it->dataptr - PyArray_BYTES(ap2);
+        PyArray_ITER_NEXT(it);
+    }
+    Py_DECREF(it);
+
+    threads = npy_get_ufunc_threads();
+    memset(PyArray_DATA(ret), 0, m*n*PyArray_ITEMSIZE(ret));
+    NPY_BEGIN_THREADS;
+    res = npy_gemm(PyArray_TYPE(ret), m, n, l, NULL,
+                   PyArray_BYTES(ap1), offsets,
+                   PyArray_STRIDES(ap1)[PyArray_NDIM(ap1) - 1], 0,
+                   PyArray_BYTES(ap2), offsets + m,
+                   PyArray_STRIDES(ap2)[axis2], 0,
+                   PyArray_BYTES(ret), n*PyArray_ITEMSIZE(ret),
+                   PyArray_ITEMSIZE(ret), threads);
+    NPY_END_THREADS;
+    PyArray_free(offsets);
+    return res == 0;
+}
+
 /* Could perhaps be redone to not make contiguous arrays */
 
 /*NUMPY_API
@@ -892,6 +965,11 @@ PyArray_InnerProduct(PyObject *op1, PyObject *op2)
                         "dot not available for this type");
         goto fail;
     }
+    if (gemm_sum_product(ap1, ap2, PyArray_NDIM(ap2) - 1, ret, l)) {
+        Py_DECREF(ap1);
+        Py_DECREF(ap2);
+        return (PyObject *)ret;
+    }
     is1 = PyArray_STRIDES(ap1)[PyArray_NDIM(ap1) - 1];
     is2 = PyArray_STRIDES(ap2)[PyArray_NDIM(ap2) - 1];
     op = PyArray_DATA(ret); os = PyArray_DESCR(ret)->elsize;
@@ -1029,6 +1107,11 @@ PyArray_MatrixProduct2(PyObject *op1, PyObject *op2, PyArrayObject* out)
                         "dot not available for this type");
         goto fail;
     }
+    if (gemm_sum_product(ap1, ap2, matchDim, ret, l)) {
+        Py_DECREF(ap1);
+        Py_DECREF(ap2);
+        return (PyObject *)ret;
+    }
 
     op = PyArray_DATA(ret); os = PyArray_DESCR(ret)->elsize;
     axis = PyArray_NDIM(ap1)-1;
@@ -3782,6 +3865,42 @@ static struct PyMethodDef array_module_methods[] = {
     {"is_busday",
         (PyCFunction)array_is_busday,
         METH_VARARGS | METH_KEYWORDS, NULL},
+    /* Hash tables for the set operations */
+    {"_unique_hash",
+        (PyCFunction)array_unique_hash,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_in1d_hash",
+        (PyCFunction)array_in1d_hash,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    /* The cache and the allocation policy of array data buffers */
+    {"setdatacache",
+        (PyCFunction)array_setdatacache,
+        METH_VARARGS, NULL},
+    {"getdatacache",
+        (PyCFunction)array_getdatacache,
+        METH_VARARGS, NULL},
+    {"datacachestats",
+        (PyCFunction)array_datacachestats,
+        METH_VARARGS, NULL},
+    {"setallocpolicy",
+        (PyCFunction)array_setallocpolicy,
+        METH_VARARGS, NULL},
+    {"getallocpolicy",
+        (PyCFunction)array_getallocpolicy,
+        METH_VARARGS, NULL},
+    {"setdatatrace",
+        (PyCFunction)array_setdatatrace,
+        METH_VARARGS, NULL},
+    {"datatracestats",
+        (PyCFunction)array_datatracestats,
+        METH_VARARGS, NULL},
+    {"getdatahandler",
+        (PyCFunction)array_getdatahandler,
+        METH_VARARGS, NULL},
+    /* The text reader of loadtxt and genfromtxt */
+    {"_loadtxt",
+        (PyCFunction)array_loadtxt,
+        METH_VARARGS | METH_KEYWORDS, NULL},
 #if !defined(NPY_PY3K)
     {"newbuffer",
         (PyCFunction)new_buffer,
@@ -4143,6 +4262,11 @@ PyMODINIT_FUNC initmultiarray(void) {
     PyDict_SetItemString(d, "DATETIMEUNITS", s);
     Py_DECREF(s);
 
+    npy_gemm_init();
+    s = npy_gemm_capsule();
+    PyDict_SetItemString(d, "_GEMM", s);
+    Py_DECREF(s);
+
 #define ADDCONST(NAME)                          \
     s = PyInt_FromLong(NPY_##NAME);             \
     PyDict_SetItemString(d, #NAME, s);          \
@@ -6,6 +6,7 @@
  */
 
 #include "common.c"
+#include "alloc.c"
 
 #include "scalartypes.c"
 #include "scalarapi.c"
@@ -17,6 +18,8 @@
 #include "arraytypes.c"
 
 #include "hashdescr.c"
+#include "hashtable.c"
+#include "textreading.c"
 #include "numpyos.c"
 
 #include "descriptor.c"
@@ -45,6 +48,7 @@
 #include "lowlevel_strided_loops.c"
 #include "dtype_transfer.c"
 #include "einsum.c"
+#include "gemm.c"
 #include "array_assign.c"
 #include "array_assign_scalar.c"
 #include "array_assign_array.c"
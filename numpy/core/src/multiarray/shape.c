@@ -16,6 +16,7 @@
 #include "ctors.h"
 
 #include "shape.h"
+#include "alloc.h"
 
 static int
 _check_ones(PyArrayObject *self, int newnd,
@@ -48,7 +49,6 @@ PyArray_Resize(PyArrayObject *self, PyArray_Dims *newshape, int refcheck,
     npy_intp* new_dimensions=newshape->ptr;
     npy_intp new_strides[NPY_MAXDIMS];
     size_t sd;
-    npy_intp *dimptr;
     char *new_data;
     npy_intp largest;
 
@@ -110,7 +110,8 @@ PyArray_Resize(PyArrayObject *self, PyArray_Dims *newshape, int refcheck,
             sd = newsize*PyArray_DESCR(self)->elsize;
         }
         /* Reallocate space if needed */
-        new_data = PyDataMem_RENEW(PyArray_DATA(self), sd);
+        new_data = npy_data_realloc(PyArray_DATA(self), sd,
+                        ((PyArrayObject_fields *)self)->mem_handler);
         if (new_data == NULL) {
             PyErr_SetString(PyExc_MemoryError,
                     "cannot allocate memory for array");
@@ -142,15 +143,12 @@ PyArray_Resize(PyArrayObject *self, PyArray_Dims *newshape, int refcheck,
         /* Different number of dimensions. */
         ((PyArrayObject_fields *)self)->nd = new_nd;
         /* Need new dimensions and strides arrays */
-        dimptr = PyDimMem_RENEW(PyArray_DIMS(self), 3*new_nd);
-        if (dimptr == NULL) {
+        npy_dims_free((PyArrayObject_fields *)self);
+        if (npy_dims_alloc((PyArrayObject_fields *)self, new_nd) < 0) {
             PyErr_SetString(PyExc_MemoryError,
                     "cannot allocate memory for array");
             return NULL;
         }
-        ((PyArrayObject_fields *)self)->dimensions = dimptr;
-        ((PyArrayObject_fields *)self)->strides = dimptr + new_nd;
-        ((PyArrayObject_fields *)self)->maskna_strides = dimptr + 2*new_nd;
     }
 
     /* make new_strides variable */
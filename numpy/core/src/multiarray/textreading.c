@@ -0,0 +1,1394 @@
+/*
+ * This file implements the text reader behind numpy.loadtxt and the
+ * simple cases of numpy.genfromtxt.
+ *
+ * The text comes from a Python iterator, either in blocks of a file or
+ * line by line. The complete lines of a block are found first, skipping
+ * the leading rows, the comments and the empty lines. Then each line is
+ * split into fields, which are converted straight into its row of the
+ * output buffer, growing as needed. The lines are independent, so that
+ * pass is split over the ufunc thread pool for large blocks.
+ *
+ * With max_rows the reader stops after that many rows and reports the
+ * bytes it used, so that a file can be read block by block into the same
+ * output buffer.
+ *
+ * Numbers with at most 19 digits and a small exponent are parsed here,
+ * exactly, the others by NumPyOS_ascii_strtod. As that needs the GIL, the
+ * threads leave the lines with such numbers to the calling thread.
+ *
+ * See LICENSE.txt for the license.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <float.h>
+
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+#define _MULTIARRAYMODULE
+#include <numpy/arrayobject.h>
+#include <numpy/halffloat.h>
+#include <numpy/npy_math.h>
+
+#include "npy_config.h"
+#include "numpy/npy_3kcompat.h"
+
+#include "common.h"
+#include "numpyos.h"
+#include "textreading.h"
+#include "alloc.h"
+
+/* The size of the blocks of text the lines are found in */
+#define TEXT_BLOCK_SIZE (1 << 20)
+/* The fewest lines per task for splitting a block over the threads */
+#define TEXT_THREAD_MIN_LINES 4096
+
+/*
+ * Multiplying or dividing an integer of at most 53 bits by a power of ten
+ * up to 1e22 rounds once, so gives the correctly rounded value, unless the
+ * intermediate results have excess precision.
+ */
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+#define TEXT_FAST_FLOAT 1
+#else
+#define TEXT_FAST_FLOAT 0
+#endif
+
+#define TEXT_ISSPACE(c) ((c) == ' ' || ((c) >= '\t' && (c) <= '\r'))
+#define TEXT_ISDIGIT(c) ((unsigned char)((c) - '0') < 10)
+
+/* The kinds of columns */
+enum {
+    TEXT_BOOL,
+    TEXT_INT,
+    TEXT_UINT,
+    TEXT_FLOAT,
+    TEXT_COMPLEX,
+    TEXT_STRING
+};
+
+static const char *text_kind_names[] = {
+    "bool", "int", "int", "float", "complex", "string"
+};
+
+/* The results of the conversion of a field or a line */
+enum {
+    TEXT_OK = 0,
+    /* the field is not valid for its column */
+    TEXT_INVALID,
+    /* the field needs NumPyOS_ascii_strtod */
+    TEXT_SLOW,
+    /* the line has the wrong number of fields */
+    TEXT_BADROW
+};
+
+typedef struct {
+    int kind;
+    int itemsize;
+    /* the offset in the row */
+    npy_intp offset;
+    /* the next column which uses the same field, or -1 */
+    int next;
+} text_column;
+
+typedef struct {
+    const char *start, *end;
+    npy_intp lineno;
+    /* the number of fields of a line which is skipped, -1 otherwise */
+    int nfields;
+} text_line;
+
+typedef struct {
+    int status;
+    /* the index of the line, the field and its text */
+    npy_intp line;
+    int field, column, nfields;
+    const char *start, *end;
+} text_error;
+
+typedef struct {
+    /* the options, delimiter is NULL to split at whitespace */
+    const char *delimiter, *comments, *strip;
+    Py_ssize_t delimiter_len, comments_len, strip_len;
+    npy_intp skiprows;
+    int loose;
+    npy_intp *usecols;
+    int nusecols;
+
+    /* the columns, ncolumns is -1 until the first line was seen */
+    PyArray_Descr *dtype;
+    int homogeneous;
+    text_column *columns;
+    int ncolumns;
+    /* the first column of each field of a line, -1 if it is not used */
+    int *field_columns;
+    int nfields;
+    npy_intp rowsize;
+    /* set if the columns do not cover all the bytes of a row */
+    int padded;
+
+    /* the output, fixed if it is the buffer of an array from the caller */
+    char *data;
+    const PyDataMem_Handler *handler;
+    npy_intp nrows, maxrows;
+    int fixed, fixed_ncolumns;
+    /* the most rows to read or -1, more is set if they stopped a block */
+    npy_intp max_rows;
+    int more;
+
+    /* the lines of the current block */
+    text_line *lines;
+    npy_intp nlines, maxlines, lineno;
+} text_reader;
+
+
+/*
+ *****************************************************************************
+ **                            FIELD PARSING                                **
+ *****************************************************************************
+ */
+
+/* Finds the string s of length n in [p, end), returns end if it is not */
+static NPY_INLINE const char *
+text_find(const char *p, const char *end, const char *s, Py_ssize_t n)
+{
+    if (n == 1) {
+        const char *q = memchr(p, s[0], end - p);
+        return q != NULL ? q : end;
+    }
+    while (end - p >= n) {
+        const char *q = memchr(p, s[0], end - p - n + 1);
+        if (q == NULL) {
+            break;
+        }
+        if (memcmp(q, s, n) == 0) {
+            return q;
+        }
+        p = q + 1;
+    }
+    return end;
+}
+
+static const double text_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/*
+ * Parses the decimal number at the start of [p, end) after optional
+ * whitespace. Returns TEXT_SLOW if it can not be computed exactly here,
+ * which includes inf and nan, and sets *endptr after the number.
+ */
+static int
+text_parse_double_fast(const char *p, const char *end, double *value,
+                       const char **endptr)
+{
+    npy_uint64 mantissa = 0;
+    int ndigits = 0, exponent = 0, negative = 0, any = 0;
+
+    while (p < end && TEXT_ISSPACE(*p)) {
+        p++;
+    }
+    if (p < end && (*p == '+' || *p == '-')) {
+        negative = (*p == '-');
+        p++;
+    }
+    for (; p < end && TEXT_ISDIGIT(*p); p++) {
+        any = 1;
+        if (mantissa == 0 && *p == '0') {
+            continue;
+        }
+        if (ndigits == 19) {
+            return TEXT_SLOW;
+        }
+        mantissa = mantissa * 10 + (*p - '0');
+        ndigits++;
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && TEXT_ISDIGIT(*p); p++) {
+            any = 1;
+            exponent--;
+            if (mantissa == 0 && *p == '0') {
+                continue;
+            }
+            if (ndigits == 19) {
+                return TEXT_SLOW;
+            }
+            mantissa = mantissa * 10 + (*p - '0');
+            ndigits++;
+        }
+    }
+    if (!any) {
+        /* maybe inf or nan */
+        return (p < end && (*p == 'i' || *p == 'I' ||
+                            *p == 'n' || *p == 'N')) ? TEXT_SLOW : TEXT_INVALID;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        int e = 0, eneg = 0;
+
+        if (q < end && (*q == '+' || *q == '-')) {
+            eneg = (*q == '-');
+            q++;
+        }
+        if (q < end && TEXT_ISDIGIT(*q)) {
+            for (; q < end && TEXT_ISDIGIT(*q); q++) {
+                if (e < 100000) {
+                    e = e * 10 + (*q - '0');
+                }
+            }
+            exponent += eneg ? -e : e;
+            p = q;
+        }
+    }
+    *endptr = p;
+
+    if (mantissa == 0) {
+        *value = negative ? -0.0 : 0.0;
+        return TEXT_OK;
+    }
+    if (!TEXT_FAST_FLOAT || mantissa > ((npy_uint64)1 << 53) ||
+            exponent < -22 || exponent > 22) {
+        return TEXT_SLOW;
+    }
+    if (exponent < 0) {
+        *value = (double)mantissa / text_pow10[-exponent];
+    }
+    else {
+        *value = (double)mantissa * text_pow10[exponent];
+    }
+    if (negative) {
+        *value = -*value;
+    }
+    return TEXT_OK;
+}
+
+/*
+ * As text_parse_double_fast, falling back to NumPyOS_ascii_strtod if
+ * allow_slow is set.
+ */
+static int
+text_parse_double(const char *p, const char *end, int allow_slow,
+                  double *value, const char **endptr)
+{
+    char buffer[128], *s = buffer, *e;
+    Py_ssize_t n = end - p;
+    int ret = text_parse_double_fast(p, end, value, endptr);
+
+    if (ret != TEXT_SLOW || !allow_slow) {
+        return ret;
+    }
+    if (n >= (Py_ssize_t)sizeof(buffer)) {
+        s = malloc(n + 1);
+        if (s == NULL) {
+            return TEXT_INVALID;
+        }
+    }
+    memcpy(s, p, n);
+    s[n] = '\0';
+    *value = NumPyOS_ascii_strtod(s, &e);
+    *endptr = p + (e - s);
+    ret = (e == s) ? TEXT_INVALID : TEXT_OK;
+    if (s != buffer) {
+        free(s);
+    }
+    return ret;
+}
+
+/* Checks that only whitespace is left of the field */
+static NPY_INLINE int
+text_field_end(const char *p, const char *end)
+{
+    while (p < end && TEXT_ISSPACE(*p)) {
+        p++;
+    }
+    return p == end ? TEXT_OK : TEXT_INVALID;
+}
+
+static int
+text_field_double(const char *p, const char *end, int allow_slow,
+                  double *value)
+{
+    int ret = text_parse_double(p, end, allow_slow, value, &p);
+
+    return ret != TEXT_OK ? ret : text_field_end(p, end);
+}
+
+/*
+ * Parses the imaginary part of a complex number written as a bare "j",
+ * with an optional sign.
+ */
+static int
+text_parse_unit_imag(const char *p, const char *end, double *value,
+                     const char **endptr)
+{
+    double sign = 1.0;
+
+    if (p < end && (*p == '+' || *p == '-')) {
+        sign = (*p == '-') ? -1.0 : 1.0;
+        p++;
+    }
+    if (p < end && (*p == 'j' || *p == 'J')) {
+        *value = sign;
+        *endptr = p + 1;
+        return TEXT_OK;
+    }
+    return TEXT_INVALID;
+}
+
+/* Parses a complex number as accepted by the complex type */
+static int
+text_field_complex(const char *p, const char *end, int allow_slow,
+                   double *real, double *imag)
+{
+    int ret, paren = 0;
+    double x;
+
+    *real = *imag = 0.0;
+    while (p < end && TEXT_ISSPACE(*p)) {
+        p++;
+    }
+    if (p < end && *p == '(') {
+        paren = 1;
+        p++;
+        while (p < end && TEXT_ISSPACE(*p)) {
+            p++;
+        }
+    }
+    if (text_parse_unit_imag(p, end, imag, &p) != TEXT_OK) {
+        ret = text_parse_double(p, end, allow_slow, &x, &p);
+        if (ret != TEXT_OK) {
+            return ret;
+        }
+        if (p < end && (*p == 'j' || *p == 'J')) {
+            *imag = x;
+            p++;
+        }
+        else {
+            *real = x;
+            if (p < end && (*p == '+' || *p == '-') &&
+                    text_parse_unit_imag(p, end, imag, &p) != TEXT_OK) {
+                ret = text_parse_double(p, end, allow_slow, imag, &p);
+                if (ret != TEXT_OK) {
+                    return ret;
+                }
+                if (p == end || (*p != 'j' && *p != 'J')) {
+                    return TEXT_INVALID;
+                }
+                p++;
+            }
+        }
+    }
+    while (p < end && TEXT_ISSPACE(*p)) {
+        p++;
+    }
+    if (paren) {
+        if (p == end || *p != ')') {
+            return TEXT_INVALID;
+        }
+        p++;
+    }
+    return text_field_end(p, end);
+}
+
+/*
+ * Parses an integer into its magnitude and sign. Unless strict, a number
+ * with a fraction or an exponent is truncated like int(float(s)) does.
+ */
+static int
+text_field_integer(const char *p, const char *end, int strict,
+                   int allow_slow, npy_uint64 *magnitude, int *negative)
+{
+    const char *start = p;
+    npy_uint64 m = 0;
+    int any = 0;
+    double x;
+
+    *negative = 0;
+    while (p < end && TEXT_ISSPACE(*p)) {
+        p++;
+    }
+    if (p < end && (*p == '+' || *p == '-')) {
+        *negative = (*p == '-');
+        p++;
+    }
+    for (; p < end && TEXT_ISDIGIT(*p); p++) {
+        npy_uint64 d = *p - '0';
+
+        if (m > (NPY_MAX_ULONGLONG - d) / 10) {
+            return TEXT_INVALID;
+        }
+        m = m * 10 + d;
+        any = 1;
+    }
+    if (any && text_field_end(p, end) == TEXT_OK) {
+        *magnitude = m;
+        return TEXT_OK;
+    }
+    if (strict) {
+        return TEXT_INVALID;
+    }
+    any = text_field_double(start, end, allow_slow, &x);
+    if (any != TEXT_OK) {
+        return any;
+    }
+    /* the range of the 64 bit integers, which nan is not in */
+    if (!(x > -18446744073709551616.0 && x < 18446744073709551616.0)) {
+        return TEXT_INVALID;
+    }
+    *negative = x < 0;
+    *magnitude = (npy_uint64)(x < 0 ? -x : x);
+    return TEXT_OK;
+}
+
+/* Stores the integer v in a column of the given size */
+#define TEXT_STORE_INT(dst, itemsize, v) do {       \
+        switch (itemsize) {                         \
+            case 1: {                               \
+                npy_uint8 t_ = (npy_uint8)(v);      \
+                memcpy(dst, &t_, 1);                \
+                break;                              \
+            }                                       \
+            case 2: {                               \
+                npy_uint16 t_ = (npy_uint16)(v);    \
+                memcpy(dst, &t_, 2);                \
+                break;                              \
+            }                                       \
+            case 4: {                               \
+                npy_uint32 t_ = (npy_uint32)(v);    \
+                memcpy(dst, &t_, 4);                \
+                break;                              \
+            }                                       \
+            default: {                              \
+                npy_uint64 t_ = (npy_uint64)(v);    \
+                memcpy(dst, &t_, 8);                \
+                break;                              \
+            }                                       \
+        }                                           \
+    } while (0)
+
+static void
+text_store_double(char *dst, int itemsize, double value)
+{
+    if (itemsize == 2) {
+        npy_half h = npy_double_to_half(value);
+        memcpy(dst, &h, 2);
+    }
+    else if (itemsize == 4) {
+        npy_float f = (npy_float)value;
+        memcpy(dst, &f, 4);
+    }
+    else if (itemsize == 8) {
+        memcpy(dst, &value, 8);
+    }
+    else {
+        npy_longdouble l = (npy_longdouble)value;
+        memcpy(dst, &l, sizeof(l));
+    }
+}
+
+/*
+ * Converts the field [p, end) into dst. In loose mode a field which is
+ * empty or not valid gets the default value of genfromtxt instead. Like
+ * the converters of loadtxt and genfromtxt, only the booleans and the 64
+ * bit integers refuse a fraction, the other integers truncate it.
+ */
+static int
+text_convert_field(const text_reader *tr, const text_column *col,
+                   const char *p, const char *end, char *dst, int allow_slow)
+{
+    npy_uint64 m;
+    int negative, ret;
+    double x, y;
+
+    switch (col->kind) {
+        case TEXT_BOOL:
+            ret = text_field_integer(p, end, 1, allow_slow,
+                                     &m, &negative);
+            if (ret == TEXT_INVALID && tr->loose) {
+                m = 0;
+                ret = TEXT_OK;
+            }
+            if (ret == TEXT_OK) {
+                dst[col->offset] = (m != 0);
+            }
+            return ret;
+        case TEXT_INT:
+        case TEXT_UINT:
+            ret = text_field_integer(p, end, col->itemsize == 8, allow_slow,
+                                     &m, &negative);
+            if (ret == TEXT_OK) {
+                if (col->kind == TEXT_INT && col->itemsize == 8 &&
+                        m > (negative ? (npy_uint64)1 << 63 :
+                                        ((npy_uint64)1 << 63) - 1)) {
+                    ret = TEXT_INVALID;
+                }
+                else {
+                    m = negative ? (npy_uint64)0 - m : m;
+                    TEXT_STORE_INT(dst + col->offset, col->itemsize, m);
+                }
+            }
+            if (ret == TEXT_INVALID && tr->loose) {
+                TEXT_STORE_INT(dst + col->offset, col->itemsize,
+                               NPY_MAX_ULONGLONG);
+                ret = TEXT_OK;
+            }
+            return ret;
+        case TEXT_FLOAT:
+            ret = text_field_double(p, end, allow_slow, &x);
+            if (ret == TEXT_INVALID && tr->loose) {
+                x = NPY_NAN;
+                ret = TEXT_OK;
+            }
+            if (ret == TEXT_OK) {
+                text_store_double(dst + col->offset, col->itemsize, x);
+            }
+            return ret;
+        case TEXT_COMPLEX:
+            ret = text_field_complex(p, end, allow_slow, &x, &y);
+            if (ret == TEXT_INVALID && tr->loose) {
+                x = NPY_NAN;
+                y = 0.0;
+                ret = TEXT_OK;
+            }
+            if (ret == TEXT_OK) {
+                text_store_double(dst + col->offset, col->itemsize / 2, x);
+                text_store_double(dst + col->offset + col->itemsize / 2,
+                                  col->itemsize / 2, y);
+            }
+            return ret;
+        case TEXT_STRING: {
+            Py_ssize_t n = end - p;
+
+            if (n > col->itemsize) {
+                n = col->itemsize;
+            }
+            memcpy(dst + col->offset, p, n);
+            memset(dst + col->offset + n, 0, col->itemsize - n);
+            return TEXT_OK;
+        }
+    }
+    return TEXT_INVALID;
+}
+
+
+/*
+ *****************************************************************************
+ **                                 LINES                                   **
+ *****************************************************************************
+ */
+
+/*
+ * Finds the next field of the line from *p, returns 0 at the end of the
+ * line. *p is set past the field, or to NULL after the last field of a
+ * delimited line.
+ */
+static NPY_INLINE int
+text_next_field(const text_reader *tr, const char **p, const char *end,
+                const char **fstart, const char **fend)
+{
+    const char *q = *p;
+
+    if (q == NULL) {
+        return 0;
+    }
+    if (tr->delimiter == NULL) {
+        while (q < end && TEXT_ISSPACE(*q)) {
+            q++;
+        }
+        if (q == end) {
+            return 0;
+        }
+        *fstart = q;
+        while (q < end && !TEXT_ISSPACE(*q)) {
+            q++;
+        }
+        *fend = *p = q;
+    }
+    else {
+        *fstart = q;
+        *fend = text_find(q, end, tr->delimiter, tr->delimiter_len);
+        *p = (*fend == end) ? NULL : *fend + tr->delimiter_len;
+    }
+    return 1;
+}
+
+static int
+text_count_fields(const text_reader *tr, const text_line *line)
+{
+    const char *p = line->start, *fstart, *fend;
+    int n = 0;
+
+    while (text_next_field(tr, &p, line->end, &fstart, &fend)) {
+        n++;
+    }
+    return n;
+}
+
+/* Converts a line into its row */
+static int
+text_convert_line(const text_reader *tr, const text_line *line, char *row,
+                  int allow_slow, text_error *err)
+{
+    const char *p = line->start, *fstart, *fend;
+    int ifield = 0, icol, ret;
+
+    if (tr->padded) {
+        memset(row, 0, tr->rowsize);
+    }
+    while (text_next_field(tr, &p, line->end, &fstart, &fend)) {
+        icol = ifield < tr->nfields ? tr->field_columns[ifield] : -1;
+        for (; icol >= 0; icol = tr->columns[icol].next) {
+            ret = text_convert_field(tr, &tr->columns[icol], fstart, fend,
+                                     row, allow_slow);
+            if (ret != TEXT_OK) {
+                err->status = ret;
+                err->field = ifield;
+                err->column = icol;
+                err->start = fstart;
+                err->end = fend;
+                return ret;
+            }
+        }
+        ifield++;
+    }
+    if (tr->usecols == NULL ? ifield != tr->ncolumns : ifield < tr->nfields) {
+        err->status = TEXT_BADROW;
+        err->nfields = ifield;
+        return TEXT_BADROW;
+    }
+    return TEXT_OK;
+}
+
+/*
+ * Converts the lines [first, last) of the block, returns the index of the
+ * line which failed or last. In loose mode lines with the wrong number of
+ * fields are marked instead.
+ */
+static npy_intp
+text_convert_lines(const text_reader *tr, npy_intp first, npy_intp last,
+                   int allow_slow, text_error *err)
+{
+    npy_intp i;
+
+    for (i = first; i < last; i++) {
+        text_line *line = &tr->lines[i];
+        int ret = text_convert_line(tr, line,
+                            tr->data + (tr->nrows + i) * tr->rowsize,
+                            allow_slow, err);
+
+        if (ret == TEXT_BADROW && tr->loose) {
+            line->nfields = err->nfields;
+        }
+        else if (ret != TEXT_OK) {
+            err->line = i;
+            return i;
+        }
+    }
+    return last;
+}
+
+static NPY_INLINE int
+text_isstrip(const text_reader *tr, char c)
+{
+    return memchr(tr->strip, c, tr->strip_len) != NULL;
+}
+
+/*
+ * Finds the lines of data in buf, up to the last newline or to the end if
+ * final is set, and returns the number of bytes they take. It stops before
+ * the line after the last of max_rows.
+ */
+static Py_ssize_t
+text_find_lines(text_reader *tr, const char *buf, Py_ssize_t len, int final)
+{
+    const char *p = buf, *bufend = buf + len;
+
+    tr->nlines = 0;
+    tr->more = 0;
+    while (p < bufend) {
+        const char *nl = memchr(p, '\n', bufend - p), *s = p, *e;
+
+        if (tr->max_rows >= 0 && tr->nrows + tr->nlines >= tr->max_rows) {
+            tr->more = 1;
+            break;
+        }
+        if (nl == NULL && !final) {
+            break;
+        }
+        e = (nl != NULL) ? nl + 1 : bufend;
+        p = e;
+        tr->lineno++;
+        if (tr->skiprows > 0) {
+            tr->skiprows--;
+            continue;
+        }
+        if (tr->comments_len > 0) {
+            e = text_find(s, e, tr->comments, tr->comments_len);
+        }
+        while (e > s && text_isstrip(tr, e[-1])) {
+            e--;
+        }
+        while (s < e && text_isstrip(tr, *s)) {
+            s++;
+        }
+        if (tr->delimiter == NULL) {
+            while (s < e && TEXT_ISSPACE(*s)) {
+                s++;
+            }
+        }
+        if (s == e) {
+            continue;
+        }
+        if (tr->nlines == tr->maxlines) {
+            npy_intp n = tr->maxlines == 0 ? 1024 : 2 * tr->maxlines;
+            text_line *lines = PyArray_realloc(tr->lines,
+                                               n * sizeof(text_line));
+            if (lines == NULL) {
+                return -1;
+            }
+            tr->lines = lines;
+            tr->maxlines = n;
+        }
+        tr->lines[tr->nlines].start = s;
+        tr->lines[tr->nlines].end = e;
+        tr->lines[tr->nlines].lineno = tr->lineno;
+        tr->lines[tr->nlines].nfields = -1;
+        tr->nlines++;
+    }
+    return p - buf;
+}
+
+
+/*
+ *****************************************************************************
+ **                               THE READER                                **
+ *****************************************************************************
+ */
+
+static int
+text_column_init(text_column *col, PyArray_Descr *descr, npy_intp offset)
+{
+    int type_num = descr->type_num;
+
+    if (!PyArray_ISNBO(descr->byteorder)) {
+        type_num = -1;
+    }
+    if (type_num == NPY_BOOL) {
+        col->kind = TEXT_BOOL;
+    }
+    else if (PyTypeNum_ISSIGNED(type_num)) {
+        col->kind = TEXT_INT;
+    }
+    else if (PyTypeNum_ISUNSIGNED(type_num)) {
+        col->kind = TEXT_UINT;
+    }
+    else if (PyTypeNum_ISFLOAT(type_num)) {
+        col->kind = TEXT_FLOAT;
+    }
+    else if (PyTypeNum_ISCOMPLEX(type_num)) {
+        col->kind = TEXT_COMPLEX;
+    }
+    else if (type_num == NPY_STRING && descr->elsize > 0) {
+        col->kind = TEXT_STRING;
+    }
+    else {
+        PyErr_SetString(PyExc_TypeError,
+                "_loadtxt does not support the data type");
+        return -1;
+    }
+    col->itemsize = descr->elsize;
+    col->offset = offset;
+    col->next = -1;
+    return 0;
+}
+
+/* Sets up the columns of the fields once the first line is known */
+static int
+text_setup_fields(text_reader *tr, const text_line *first)
+{
+    int i, nf = text_count_fields(tr, first);
+
+    if (tr->homogeneous) {
+        tr->ncolumns = tr->usecols != NULL ? tr->nusecols : nf;
+        tr->columns = PyArray_malloc((tr->ncolumns + 1) * sizeof(text_column));
+        if (tr->columns == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        for (i = 0; i < tr->ncolumns; i++) {
+            if (text_column_init(&tr->columns[i], tr->dtype,
+                                 i * tr->dtype->elsize) < 0) {
+                return -1;
+            }
+        }
+        tr->rowsize = tr->ncolumns * tr->dtype->elsize;
+    }
+    else if (tr->usecols != NULL && tr->nusecols != tr->ncolumns) {
+        PyErr_Format(PyExc_ValueError,
+                "usecols has %d columns, the dtype %d", tr->nusecols,
+                tr->ncolumns);
+        return -1;
+    }
+
+    if (tr->usecols == NULL) {
+        tr->nfields = tr->ncolumns;
+    }
+    else {
+        tr->nfields = 0;
+        for (i = 0; i < tr->nusecols; i++) {
+            npy_intp c = tr->usecols[i];
+
+            if (c < 0) {
+                c += nf;
+            }
+            if (c < 0) {
+                PyErr_Format(PyExc_ValueError,
+                        "usecols index %ld is out of range, the first line "
+                        "has %d columns", (long)tr->usecols[i], nf);
+                return -1;
+            }
+            tr->usecols[i] = c;
+            if (c >= tr->nfields) {
+                tr->nfields = (int)c + 1;
+            }
+        }
+    }
+    tr->field_columns = PyArray_malloc((tr->nfields + 1) * sizeof(int));
+    if (tr->field_columns == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (i = 0; i < tr->nfields; i++) {
+        tr->field_columns[i] = tr->usecols == NULL ? i : -1;
+    }
+    /* chain the columns of repeated usecols, in order */
+    for (i = (tr->usecols == NULL ? 0 : tr->nusecols) - 1; i >= 0; i--) {
+        npy_intp c = tr->usecols[i];
+
+        tr->columns[i].next = tr->field_columns[c];
+        tr->field_columns[c] = i;
+    }
+    return 0;
+}
+
+static void
+text_set_error(const text_reader *tr, const text_error *err)
+{
+    npy_intp lineno = tr->lines[err->line].lineno;
+
+    if (err->status == TEXT_BADROW) {
+        if (tr->usecols == NULL) {
+            PyErr_Format(PyExc_ValueError,
+                    "wrong number of columns at line %ld, expected %d "
+                    "but got %d", (long)lineno, tr->ncolumns, err->nfields);
+        }
+        else {
+            PyErr_Format(PyExc_ValueError,
+                    "line %ld has %d columns, usecols needs %d",
+                    (long)lineno, err->nfields, tr->nfields);
+        }
+    }
+    else {
+        char text[64];
+        Py_ssize_t n = err->end - err->start;
+
+        if (n > (Py_ssize_t)sizeof(text) - 1) {
+            n = sizeof(text) - 1;
+        }
+        memcpy(text, err->start, n);
+        text[n] = '\0';
+        PyErr_Format(PyExc_ValueError,
+                "could not convert string '%s' to %s at line %ld, "
+                "column %d", text, text_kind_names[tr->columns[err->column].kind],
+                (long)lineno, err->field);
+    }
+}
+
+typedef struct {
+    text_reader *tr;
+    npy_intp chunk;
+    npy_intp *stop;
+    text_error *errs;
+} text_tasks;
+
+static void
+text_convert_task(void *arg, npy_intp itask)
+{
+    text_tasks *tasks = (text_tasks *)arg;
+    npy_intp first = itask * tasks->chunk, last = first + tasks->chunk;
+
+    if (last > tasks->tr->nlines) {
+        last = tasks->tr->nlines;
+    }
+    tasks->stop[itask] = text_convert_lines(tasks->tr, first, last, 0,
+                                            &tasks->errs[itask]);
+}
+
+/*
+ * Converts the lines of the block on the threads. The lines they left,
+ * starting with one which needs NumPyOS_ascii_strtod, are converted
+ * afterwards in this thread.
+ */
+static int
+text_convert_threaded(text_reader *tr, npy_ufunc_threads_api *api,
+                      npy_intp ntasks)
+{
+    text_tasks tasks;
+    text_error err;
+    npy_intp itask;
+    int ret = 0;
+    NPY_BEGIN_THREADS_DEF;
+
+    tasks.tr = tr;
+    tasks.chunk = (tr->nlines + ntasks - 1) / ntasks;
+    tasks.stop = PyArray_malloc(ntasks * sizeof(npy_intp));
+    tasks.errs = PyArray_malloc(ntasks * sizeof(text_error));
+    if (tasks.stop == NULL || tasks.errs == NULL) {
+        PyArray_free(tasks.stop);
+        PyArray_free(tasks.errs);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    NPY_BEGIN_THREADS;
+    api->run_tasks(&text_convert_task, &tasks, ntasks);
+    for (itask = 0; itask < ntasks; itask++) {
+        npy_intp last = (itask + 1) * tasks.chunk;
+
+        if (last > tr->nlines) {
+            last = tr->nlines;
+        }
+        if (tasks.stop[itask] < last &&
+                text_convert_lines(tr, tasks.stop[itask], last,
+                                   1, &err) < last) {
+            ret = -1;
+            break;
+        }
+    }
+    NPY_END_THREADS;
+
+    if (ret < 0) {
+        text_set_error(tr, &err);
+    }
+    PyArray_free(tasks.stop);
+    PyArray_free(tasks.errs);
+    return ret;
+}
+
+/*
+ * Reads the lines of data in buf into rows, returns the number of bytes
+ * used or -1 on error.
+ */
+static Py_ssize_t
+text_read_block(text_reader *tr, const char *buf, Py_ssize_t len,
+                int final, PyObject *invalid)
+{
+    npy_ufunc_threads_api *api = NULL;
+    npy_intp i, j, ntasks = 1;
+    Py_ssize_t used;
+    text_error err;
+    NPY_BEGIN_THREADS_DEF;
+
+    NPY_BEGIN_THREADS;
+    used = text_find_lines(tr, buf, len, final);
+    NPY_END_THREADS;
+    if (used < 0) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (tr->nlines == 0) {
+        return used;
+    }
+    if (tr->ncolumns < 0 || tr->field_columns == NULL) {
+        if (text_setup_fields(tr, &tr->lines[0]) < 0) {
+            return -1;
+        }
+        if (tr->fixed && tr->homogeneous &&
+                tr->ncolumns != tr->fixed_ncolumns) {
+            PyErr_Format(PyExc_ValueError,
+                    "out has %d columns, the lines have %d",
+                    tr->fixed_ncolumns, tr->ncolumns);
+            return -1;
+        }
+    }
+
+    /* max_rows is at most the size of a fixed buffer */
+    if (tr->nrows + tr->nlines > tr->maxrows) {
+        npy_intp n = 2 * tr->maxrows;
+        char *data;
+
+        if (n < tr->nrows + tr->nlines) {
+            n = tr->nrows + tr->nlines;
+        }
+        data = npy_data_realloc(tr->data, n * tr->rowsize + 1, tr->handler);
+        if (data == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        tr->data = data;
+        tr->maxrows = n;
+    }
+
+    if (tr->nlines >= 2 * TEXT_THREAD_MIN_LINES) {
+        api = npy_get_ufunc_threads();
+        if (api != NULL) {
+            ntasks = tr->nlines / TEXT_THREAD_MIN_LINES;
+            if (ntasks > api->get_num_threads()) {
+                ntasks = api->get_num_threads();
+            }
+        }
+    }
+    if (ntasks > 1) {
+        if (text_convert_threaded(tr, api, ntasks) < 0) {
+            return -1;
+        }
+    }
+    else {
+        NPY_BEGIN_THREADS;
+        i = text_convert_lines(tr, 0, tr->nlines, 1, &err);
+        NPY_END_THREADS;
+        if (i < tr->nlines) {
+            text_set_error(tr, &err);
+            return -1;
+        }
+    }
+
+    /* drop the rows of the skipped lines */
+    for (i = j = 0; i < tr->nlines; i++) {
+        if (tr->lines[i].nfields >= 0) {
+            PyObject *item = Py_BuildValue("ni", tr->lines[i].lineno,
+                                           tr->lines[i].nfields);
+            if (item == NULL || PyList_Append(invalid, item) < 0) {
+                Py_XDECREF(item);
+                return -1;
+            }
+            Py_DECREF(item);
+            continue;
+        }
+        if (i != j) {
+            memmove(tr->data + (tr->nrows + j) * tr->rowsize,
+                    tr->data + (tr->nrows + i) * tr->rowsize, tr->rowsize);
+        }
+        j++;
+    }
+    tr->nrows += j;
+    return used;
+}
+
+/* Appends the bytes of a chunk from the iterator to the buffer */
+static int
+text_append_chunk(PyObject *chunk, int lines, char **buf, Py_ssize_t *len,
+                  Py_ssize_t *size)
+{
+    PyObject *bytes = chunk;
+    char *s;
+    Py_ssize_t n;
+
+    if (PyUnicode_Check(chunk)) {
+        bytes = PyUnicode_AsLatin1String(chunk);
+        if (bytes == NULL) {
+            return -1;
+        }
+    }
+    else if (!PyBytes_Check(chunk)) {
+        PyErr_SetString(PyExc_TypeError,
+                "the lines must be byte strings");
+        return -1;
+    }
+    else {
+        Py_INCREF(bytes);
+    }
+    s = PyBytes_AS_STRING(bytes);
+    n = PyBytes_GET_SIZE(bytes);
+    if (*len + n + 1 > *size) {
+        Py_ssize_t newsize = 2 * (*len + n + 1);
+        char *newbuf = PyArray_realloc(*buf, newsize);
+
+        if (newbuf == NULL) {
+            Py_DECREF(bytes);
+            PyErr_NoMemory();
+            return -1;
+        }
+        *buf = newbuf;
+        *size = newsize;
+    }
+    memcpy(*buf + *len, s, n);
+    *len += n;
+    /* every chunk is a line of its own */
+    if (lines && n > 0 && s[n - 1] != '\n') {
+        (*buf)[(*len)++] = '\n';
+    }
+    Py_DECREF(bytes);
+    return 0;
+}
+
+static int
+text_bytes_converter(PyObject *obj, PyObject **out)
+{
+    if (obj == Py_None) {
+        *out = NULL;
+        return 1;
+    }
+    if (!PyBytes_Check(obj)) {
+        PyErr_SetString(PyExc_TypeError, "expected a byte string or None");
+        return 0;
+    }
+    *out = obj;
+    return 1;
+}
+
+NPY_NO_EXPORT PyObject *
+array_loadtxt(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"chunks", "dtype", "columns", "delimiter",
+                             "comments", "skiprows", "usecols", "lines",
+                             "loose", "strip", "max_rows", "out", NULL};
+
+    PyObject *chunks, *columns = Py_None, *usecols = Py_None;
+    PyObject *delimiter = NULL, *comments = NULL, *strip = NULL;
+    PyObject *iter = NULL, *invalid = NULL, *ret = NULL;
+    PyArrayObject *arr = NULL, *out = NULL;
+    PyArray_Descr *dtype = NULL;
+    npy_intp skiprows = 0, max_rows = -1, dims[2];
+    int i, lines = 0, loose = 0, eof = 0;
+    char *buf = NULL;
+    Py_ssize_t len = 0, size = 0, consumed = 0;
+    text_reader tr;
+
+    memset(&tr, 0, sizeof(tr));
+    tr.ncolumns = -1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds,
+                "OO&|OO&O&nOiiO&nO&:_loadtxt", kwlist,
+                &chunks, &PyArray_DescrConverter, &dtype, &columns,
+                &text_bytes_converter, &delimiter,
+                &text_bytes_converter, &comments, &skiprows, &usecols,
+                &lines, &loose, &text_bytes_converter, &strip, &max_rows,
+                &PyArray_OutputConverter, &out)) {
+        Py_XDECREF(dtype);
+        return NULL;
+    }
+    tr.dtype = dtype;
+    tr.skiprows = skiprows;
+    tr.loose = loose;
+    tr.max_rows = max_rows < 0 ? -1 : max_rows;
+    if (delimiter != NULL && PyBytes_GET_SIZE(delimiter) > 0) {
+        tr.delimiter = PyBytes_AS_STRING(delimiter);
+        tr.delimiter_len = PyBytes_GET_SIZE(delimiter);
+    }
+    if (comments != NULL) {
+        tr.comments = PyBytes_AS_STRING(comments);
+        tr.comments_len = PyBytes_GET_SIZE(comments);
+    }
+    if (strip != NULL) {
+        tr.strip = PyBytes_AS_STRING(strip);
+        tr.strip_len = PyBytes_GET_SIZE(strip);
+    }
+    else {
+        tr.strip = "\r\n";
+        tr.strip_len = 2;
+    }
+
+    /* the columns of a structured row, or one type for all of them */
+    if (columns == Py_None) {
+        text_column col;
+
+        tr.homogeneous = 1;
+        if (text_column_init(&col, dtype, 0) < 0) {
+            goto finish;
+        }
+    }
+    else {
+        PyObject *seq = PySequence_Fast(columns, "columns must be a sequence");
+        npy_intp covered = 0;
+
+        if (seq == NULL) {
+            goto finish;
+        }
+        tr.ncolumns = (int)PySequence_Fast_GET_SIZE(seq);
+        tr.columns = PyArray_malloc((tr.ncolumns + 1) * sizeof(text_column));
+        if (tr.columns == NULL) {
+            Py_DECREF(seq);
+            PyErr_NoMemory();
+            goto finish;
+        }
+        for (i = 0; i < tr.ncolumns; i++) {
+            PyArray_Descr *descr = NULL;
+            npy_intp offset;
+
+            if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(seq, i),
+                        "O&n", &PyArray_DescrConverter, &descr, &offset)) {
+                Py_DECREF(seq);
+                goto finish;
+            }
+            if (text_column_init(&tr.columns[i], descr, offset) < 0 ||
+                    offset < 0 || offset + descr->elsize > dtype->elsize) {
+                if (!PyErr_Occurred()) {
+                    PyErr_SetString(PyExc_ValueError,
+                            "column offset out of range");
+                }
+                Py_DECREF(descr);
+                Py_DECREF(seq);
+                goto finish;
+            }
+            covered += descr->elsize;
+            Py_DECREF(descr);
+        }
+        Py_DECREF(seq);
+        tr.rowsize = dtype->elsize;
+        tr.padded = covered != tr.rowsize;
+    }
+
+    if (usecols != Py_None) {
+        PyObject *seq = PySequence_Fast(usecols, "usecols must be a sequence");
+
+        if (seq == NULL) {
+            goto finish;
+        }
+        tr.nusecols = (int)PySequence_Fast_GET_SIZE(seq);
+        tr.usecols = PyArray_malloc((tr.nusecols + 1) * sizeof(npy_intp));
+        if (tr.usecols == NULL) {
+            Py_DECREF(seq);
+            PyErr_NoMemory();
+            goto finish;
+        }
+        for (i = 0; i < tr.nusecols; i++) {
+            tr.usecols[i] = PyArray_PyIntAsIntp(
+                                    PySequence_Fast_GET_ITEM(seq, i));
+            if (error_converting(tr.usecols[i])) {
+                Py_DECREF(seq);
+                goto finish;
+            }
+        }
+        Py_DECREF(seq);
+    }
+
+    /* the rows go straight into out, which limits their number */
+    if (out != NULL) {
+        if (!PyArray_ISCARRAY(out) ||
+                !PyArray_EquivTypes(PyArray_DESCR(out), dtype) ||
+                PyArray_NDIM(out) != (tr.homogeneous ? 2 : 1)) {
+            PyErr_SetString(PyExc_ValueError,
+                    "out must be a writeable C contiguous array of the rows");
+            goto finish;
+        }
+        tr.fixed = 1;
+        tr.data = PyArray_DATA(out);
+        tr.maxrows = PyArray_DIM(out, 0);
+        if (tr.homogeneous) {
+            tr.fixed_ncolumns = (int)PyArray_DIM(out, 1);
+        }
+        if (tr.max_rows < 0 || tr.max_rows > tr.maxrows) {
+            tr.max_rows = tr.maxrows;
+        }
+    }
+    else {
+        tr.data = npy_data_alloc(1, &tr.handler);
+        if (tr.data == NULL) {
+            PyErr_NoMemory();
+            goto finish;
+        }
+    }
+
+    invalid = PyList_New(0);
+    iter = PyObject_GetIter(chunks);
+    if (invalid == NULL || iter == NULL) {
+        goto finish;
+    }
+    while (!eof) {
+        PyObject *chunk;
+
+        if (tr.max_rows >= 0 && tr.nrows >= tr.max_rows) {
+            break;
+        }
+        chunk = PyIter_Next(iter);
+
+        if (chunk == NULL) {
+            if (PyErr_Occurred()) {
+                goto finish;
+            }
+            eof = 1;
+        }
+        else {
+            int r = text_append_chunk(chunk, lines, &buf, &len, &size);
+
+            Py_DECREF(chunk);
+            if (r < 0) {
+                goto finish;
+            }
+        }
+        /* with max_rows the chunks are read as they come, to stop early */
+        if (len >= TEXT_BLOCK_SIZE ||
+                (len > 0 && (eof || tr.max_rows >= 0))) {
+            do {
+                Py_ssize_t used = text_read_block(&tr, buf, len, eof,
+                                                  invalid);
+
+                if (used < 0) {
+                    goto finish;
+                }
+                memmove(buf, buf + used, len - used);
+                len -= used;
+                consumed += used;
+                /* skipped lines may leave rows to fill */
+            } while (tr.more && tr.nrows < tr.max_rows);
+        }
+    }
+
+    /* the rows, which are rows of the homogeneous type */
+    dims[0] = tr.nrows;
+    dims[1] = tr.ncolumns < 0 ? 0 : tr.ncolumns;
+    if (tr.fixed) {
+        if (tr.homogeneous) {
+            dims[1] = tr.fixed_ncolumns;
+        }
+        Py_INCREF(dtype);
+        arr = (PyArrayObject *)PyArray_NewFromDescr(&PyArray_Type, dtype,
+                                    PyArray_NDIM(out), dims, NULL,
+                                    tr.data, NPY_ARRAY_CARRAY, NULL);
+        if (arr == NULL) {
+            goto finish;
+        }
+        Py_INCREF(out);
+        if (PyArray_SetBaseObject(arr, (PyObject *)out) < 0) {
+            goto finish;
+        }
+    }
+    else {
+        if (tr.nrows < tr.maxrows) {
+            char *data = npy_data_realloc(tr.data,
+                                          tr.nrows * tr.rowsize + 1,
+                                          tr.handler);
+            if (data != NULL) {
+                tr.data = data;
+            }
+        }
+        Py_INCREF(dtype);
+        arr = (PyArrayObject *)PyArray_NewFromDescr(&PyArray_Type, dtype,
+                                    tr.homogeneous ? 2 : 1, dims, NULL,
+                                    tr.data, NPY_ARRAY_CARRAY, NULL);
+        if (arr == NULL) {
+            goto finish;
+        }
+        PyArray_ENABLEFLAGS(arr, NPY_ARRAY_OWNDATA);
+        ((PyArrayObject_fields *)arr)->mem_handler = tr.handler;
+    }
+    tr.data = NULL;
+    ret = Py_BuildValue("NOn", arr, invalid, consumed);
+    arr = NULL;
+
+finish:
+    Py_XDECREF(arr);
+    Py_XDECREF(iter);
+    Py_XDECREF(invalid);
+    Py_XDECREF(dtype);
+    if (tr.data != NULL && !tr.fixed) {
+        npy_data_free(tr.data, tr.nrows * tr.rowsize, tr.handler);
+    }
+    PyArray_free(buf);
+    PyArray_free(tr.lines);
+    PyArray_free(tr.columns);
+    PyArray_free(tr.field_columns);
+    PyArray_free(tr.usecols);
+    return ret;
+}
@@ -0,0 +1,11 @@
+#ifndef _NPY_PRIVATE__TEXTREADING_H_
+#define _NPY_PRIVATE__TEXTREADING_H_
+
+/*
+ * This is the '_loadtxt' function exposed for calling
+ * from Python.
+ */
+NPY_NO_EXPORT PyObject *
+array_loadtxt(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds);
+
+#endif
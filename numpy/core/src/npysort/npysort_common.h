@@ -38,6 +38,21 @@
 /* Need this for the argsort functions */
 #define INTP_SWAP(a,b) {npy_intp tmp = (b); (b)=(a); (a) = tmp;}
 
+/*
+ * The depth limit of the introsorts, when the quicksort recursion gets
+ * deeper than twice the log2 of the number of elements the remaining
+ * partition is heapsorted.
+ */
+NPY_INLINE static int
+npy_get_msb(npy_uintp unum)
+{
+    int depth_limit = 0;
+    while (unum >>= 1)  {
+        depth_limit++;
+    }
+    return depth_limit;
+}
+
 /*
  *****************************************************************************
  **                        COMPARISON FUNCTIONS                             **
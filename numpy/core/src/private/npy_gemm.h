@@ -0,0 +1,38 @@
+#ifndef _NPY_PRIVATE_GEMM_H_
+#define _NPY_PRIVATE_GEMM_H_
+
+#include "npy_threads.h"
+
+/*
+ * The matrix multiplication used by dot when there is no cblas lives in the
+ * multiarray module. Other extension modules find it through the _GEMM
+ * capsule of numpy.core.multiarray, which holds a pointer to this struct.
+ */
+
+/*
+ * C += alpha*A*B for the NPY_FLOAT, NPY_DOUBLE, NPY_CFLOAT and NPY_CDOUBLE
+ * types, with A of m x k, B of k x n and C of m x n, all aligned and in the
+ * native byte order. The item (i, p) of A is at a + aoffsets[i] +
+ * p*astride, the item (p, j) of B at b + boffsets[j] + p*bstride and the
+ * item (i, j) of C at c + i*crow + j*ccol. alpha points to an item of the
+ * type, or is NULL for one. conj_a and conj_b conjugate the items of the
+ * complex A and B. The work is split over the threads of threads unless
+ * it is NULL, the GIL need not be held.
+ *
+ * Returns -1 if the type is not supported or memory ran out, before C is
+ * written to, and 0 otherwise. No Python exception is set.
+ */
+typedef int (npy_gemm_func)(int typenum, npy_intp m, npy_intp n, npy_intp k,
+                            const void *alpha,
+                            const char *a, const npy_intp *aoffsets,
+                            npy_intp astride, int conj_a,
+                            const char *b, const npy_intp *boffsets,
+                            npy_intp bstride, int conj_b,
+                            char *c, npy_intp crow, npy_intp ccol,
+                            npy_ufunc_threads_api *threads);
+
+typedef struct {
+    npy_gemm_func *gemm;
+} npy_gemm_api;
+
+#endif
@@ -13,6 +13,8 @@ int mergesort_bool(npy_bool *vec, npy_intp cnt, void *null);
 int aquicksort_bool(npy_bool *vec, npy_intp *ind, npy_intp cnt, void *null);
 int aheapsort_bool(npy_bool *vec, npy_intp *ind, npy_intp cnt, void *null);
 int amergesort_bool(npy_bool *vec, npy_intp *ind, npy_intp cnt, void *null);
+int radixsort_bool(npy_bool *vec, npy_intp cnt, void *null);
+int aradixsort_bool(npy_bool *vec, npy_intp *ind, npy_intp cnt, void *null);
 
 
 int quicksort_byte(npy_byte *vec, npy_intp cnt, void *null);
@@ -21,6 +23,8 @@ int mergesort_byte(npy_byte *vec, npy_intp cnt, void *null);
 int aquicksort_byte(npy_byte *vec, npy_intp *ind, npy_intp cnt, void *null);
 int aheapsort_byte(npy_byte *vec, npy_intp *ind, npy_intp cnt, void *null);
 int amergesort_byte(npy_byte *vec, npy_intp *ind, npy_intp cnt, void *null);
+int radixsort_byte(npy_byte *vec, npy_intp cnt, void *null);
+int aradixsort_byte(npy_byte *vec, npy_intp *ind, npy_intp cnt, void *null);
 
 
 int quicksort_ubyte(npy_ubyte *vec, npy_intp cnt, void *null);
@@ -29,6 +33,8 @@ int mergesort_ubyte(npy_ubyte *vec, npy_intp cnt, void *null);
 int aquicksort_ubyte(npy_ubyte *vec, npy_intp *ind, npy_intp cnt, void *null);
 int aheapsort_ubyte(npy_ubyte *vec, npy_intp *ind, npy_intp cnt, void *null);
 int amergesort_ubyte(npy_ubyte *vec, npy_intp *ind, npy_intp cnt, void *null);
+int radixsort_ubyte(npy_ubyte *vec, npy_intp cnt, void *null);
+int aradixsort_ubyte(npy_ubyte *vec, npy_intp *ind, npy_intp cnt, void *null);
 
 
 int quicksort_short(npy_short *vec, npy_intp cnt, void *null);
@@ -37,6 +43,8 @@ int mergesort_short(npy_short *vec, npy_intp cnt, void *null);
 int aquicksort_short(npy_short *vec, npy_intp *ind, npy_intp cnt, void *null);
 int aheapsort_short(npy_short *vec, npy_intp *ind, npy_intp cnt, void *null);
 int amergesort_short(npy_short *vec, npy_intp *ind, npy_intp cnt, void *null);
+int radixsort_short(npy_short *vec, npy_intp cnt, void *null);
+int aradixsort_short(npy_short *vec, npy_intp *ind, npy_intp cnt, void *null);
 
 
 int quicksort_ushort(npy_ushort *vec, npy_intp cnt, void *null);
@@ -45,6 +53,8 @@ int mergesort_ushort(npy_ushort *vec, npy_intp cnt, void *null);
 int aquicksort_ushort(npy_ushort *vec, npy_intp *ind, npy_intp cnt, void *null);
 int aheapsort_ushort(npy_ushort *vec, npy_intp *ind, npy_intp cnt, void *null);
 int amergesort_ushort(npy_ushort *vec, npy_intp *ind, npy_intp cnt, void *null);
+int radixsort_ushort(npy_ushort *vec, npy_intp cnt, void *null);
+int aradixsort_ushort(npy_ushort *vec, npy_intp *ind, npy_intp cnt, void *null);
 
 
 int quicksort_int(npy_int *vec, npy_intp cnt, void *null);
@@ -53,6 +63,8 @@ int mergesort_int(npy_int *vec, npy_intp cnt, void *null);
 int aquicksort_int(npy_int *vec, npy_intp *ind, npy_intp cnt, void *null);
 int aheapsort_int(npy_int *vec, npy_intp *ind, npy_intp cnt, void *null);
 int amergesort_int(npy_int *vec, npy_intp *ind, npy_intp cnt, void *null);
+int radixsort_int(npy_int *vec, npy_intp cnt, void *null);
+int aradixsort_int(npy_int *vec, npy_intp *ind, npy_intp cnt, void *null);
 
 
 int quicksort_uint(npy_uint *vec, npy_intp cnt, void *null);
@@ -61,6 +73,8 @@ int mergesort_uint(npy_uint *vec, npy_intp cnt, void *null);
 int aquicksort_uint(npy_uint *vec, npy_intp *ind, npy_intp cnt, void *null);
 int aheapsort_uint(npy_uint *vec, npy_intp *ind, npy_intp cnt, void *null);
 int amergesort_uint(npy_uint *vec, npy_intp *ind, npy_intp cnt, void *null);
+int radixsort_uint(npy_uint *vec, npy_intp cnt, void *null);
+int aradixsort_uint(npy_uint *vec, npy_intp *ind, npy_intp cnt, void *null);
 
 
 int quicksort_long(npy_long *vec, npy_intp cnt, void *null);
@@ -69,6 +83,8 @@ int mergesort_long(npy_long *vec, npy_intp cnt, void *null);
 int aquicksort_long(npy_long *vec, npy_intp *ind, npy_intp cnt, void *null);
 int aheapsort_long(npy_long *vec, npy_intp *ind, npy_intp cnt, void *null);
 int amergesort_long(npy_long *vec, npy_intp *ind, npy_intp cnt, void *null);
+int radixsort_long(npy_long *vec, npy_intp cnt, void *null);
+int aradixsort_long(npy_long *vec, npy_intp *ind, npy_intp cnt, void *null);
 
 
 int quicksort_ulong(npy_ulong *vec, npy_intp cnt, void *null);
@@ -77,6 +93,8 @@ int mergesort_ulong(npy_ulong *vec, npy_intp cnt, void *null);
 int aquicksort_ulong(npy_ulong *vec, npy_intp *ind, npy_intp cnt, void *null);
 int aheapsort_ulong(npy_ulong *vec, npy_intp *ind, npy_intp cnt, void *null);
 int amergesort_ulong(npy_ulong *vec, npy_intp *ind, npy_intp cnt, void *null);
+int radixsort_ulong(npy_ulong *vec, npy_intp cnt, void *null);
+int aradixsort_ulong(npy_ulong *vec, npy_intp *ind, npy_intp cnt, void *null);
 
 
 int quicksort_longlong(npy_longlong *vec, npy_intp cnt, void *null);
@@ -85,6 +103,8 @@ int mergesort_longlong(npy_longlong *vec, npy_intp cnt, void *null);
 int aquicksort_longlong(npy_longlong *vec, npy_intp *ind, npy_intp cnt, void *null);
 int aheapsort_longlong(npy_longlong *vec, npy_intp *ind, npy_intp cnt, void *null);
 int amergesort_longlong(npy_longlong *vec, npy_intp *ind, npy_intp cnt, void *null);
+int radixsort_longlong(npy_longlong *vec, npy_intp cnt, void *null);
+int aradixsort_longlong(npy_longlong *vec, npy_intp *ind, npy_intp cnt, void *null);
 
 
 int quicksort_ulonglong(npy_ulonglong *vec, npy_intp cnt, void *null);
@@ -93,6 +113,8 @@ int mergesort_ulonglong(npy_ulonglong *vec, npy_intp cnt, void *null);
 int aquicksort_ulonglong(npy_ulonglong *vec, npy_intp *ind, npy_intp cnt, void *null);
 int aheapsort_ulonglong(npy_ulonglong *vec, npy_intp *ind, npy_intp cnt, void *null);
 int amergesort_ulonglong(npy_ulonglong *vec, npy_intp *ind, npy_intp cnt, void *null);
+int radixsort_ulonglong(npy_ulonglong *vec, npy_intp cnt, void *null);
+int aradixsort_ulonglong(npy_ulonglong *vec, npy_intp *ind, npy_intp cnt, void *null);
 
 
 int quicksort_half(npy_ushort *vec, npy_intp cnt, void *null);
@@ -166,4 +188,79 @@ int aquicksort_unicode(npy_ucs4 *vec, npy_intp *ind, npy_intp cnt, PyArrayObject
 int aheapsort_unicode(npy_ucs4 *vec, npy_intp *ind, npy_intp cnt, PyArrayObject *arr);
 int amergesort_unicode(npy_ucs4 *vec, npy_intp *ind, npy_intp cnt, PyArrayObject *arr);
 
+
+int introselect_bool(npy_bool *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_bool(npy_bool *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_byte(npy_byte *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_byte(npy_byte *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_ubyte(npy_ubyte *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_ubyte(npy_ubyte *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_short(npy_short *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_short(npy_short *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_ushort(npy_ushort *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_ushort(npy_ushort *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_int(npy_int *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_int(npy_int *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_uint(npy_uint *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_uint(npy_uint *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_long(npy_long *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_long(npy_long *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_ulong(npy_ulong *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_ulong(npy_ulong *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_longlong(npy_longlong *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_longlong(npy_longlong *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_ulonglong(npy_ulonglong *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_ulonglong(npy_ulonglong *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_half(npy_ushort *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_half(npy_ushort *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_float(npy_float *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_float(npy_float *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_double(npy_double *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_double(npy_double *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_longdouble(npy_longdouble *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_longdouble(npy_longdouble *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_cfloat(npy_cfloat *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_cfloat(npy_cfloat *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_cdouble(npy_cdouble *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_cdouble(npy_cdouble *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+int introselect_clongdouble(npy_clongdouble *vec, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+int aintroselect_clongdouble(npy_clongdouble *vec, npy_intp *ind, npy_intp cnt, npy_intp *kth, npy_intp nkth, void *null);
+
+
+
+/*
+ * Searches for the keys in the sorted arr as searchsorted does, storing
+ * the insertion indices in ret. The arg version searches arr in the
+ * order given by sorter and returns -1 for an index in sorter which is
+ * out of bounds. The lookups return NULL for types without a search.
+ */
+typedef int (npy_binsearch_func)(void *arr, npy_intp arr_len,
+                                 void *key, npy_intp key_len,
+                                 npy_intp *ret);
+typedef int (npy_argbinsearch_func)(void *arr, npy_intp arr_len,
+                                    void *key, npy_intp key_len,
+                                    npy_intp *sorter, npy_intp *ret);
+
+npy_binsearch_func *
+npy_get_binsearch_func(int typenum, NPY_SEARCHSIDE side);
+npy_argbinsearch_func *
+npy_get_argbinsearch_func(int typenum, NPY_SEARCHSIDE side);
+
 #endif
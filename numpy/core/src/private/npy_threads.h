@@ -0,0 +1,56 @@
+#ifndef _NPY_PRIVATE_THREADS_H_
+#define _NPY_PRIVATE_THREADS_H_
+
+#include "numpy/npy_3kcompat.h"
+
+/*
+ * The thread pool used by the ufuncs lives in the umath module. Other
+ * extension modules find it through the _UFUNC_THREADS capsule of
+ * numpy.core.umath, which holds a pointer to this struct.
+ */
+
+/* A unit of work, called with the index of the task within the run */
+typedef void (npy_ufunc_task_func)(void *data, npy_intp itask);
+
+typedef struct {
+    /* the number of threads set by numpy.setnumthreads */
+    int (*get_num_threads)(void);
+    /*
+     * Runs func(data, itask) for itask in [0, ntasks) and returns when all
+     * tasks are done. Must be called without holding the GIL.
+     */
+    void (*run_tasks)(npy_ufunc_task_func *func, void *data, npy_intp ntasks);
+} npy_ufunc_threads_api;
+
+/*
+ * Finds the thread pool of the umath module, NULL if it is not available.
+ * Must be called with the GIL held.
+ */
+static NPY_INLINE npy_ufunc_threads_api *
+npy_get_ufunc_threads(void)
+{
+    static npy_ufunc_threads_api *api = NULL;
+    PyObject *umath, *capsule;
+
+    if (api != NULL) {
+        return api;
+    }
+    umath = PyImport_ImportModule("numpy.core.umath");
+    if (umath == NULL) {
+        PyErr_Clear();
+        return NULL;
+    }
+    capsule = PyObject_GetAttrString(umath, "_UFUNC_THREADS");
+    Py_DECREF(umath);
+    if (capsule == NULL) {
+        PyErr_Clear();
+        return NULL;
+    }
+    if (NpyCapsule_Check(capsule)) {
+        api = NpyCapsule_AsVoidPtr(capsule);
+    }
+    Py_DECREF(capsule);
+    return api;
+}
+
+#endif
@@ -0,0 +1,387 @@
+/*
+ * This file implements the loop of numpy.evaluate, which computes an
+ * expression of ufuncs in a single pass over its operands.
+ *
+ * The expression comes as a program of ufunc calls, compiled in
+ * numpy.core.numeric. A buffered iterator walks the operands and the
+ * output in blocks of at most bufsize elements, and every call of the
+ * program runs on the block before the iterator moves on. The results of
+ * the calls which are not the output go to buffers of one block, which
+ * stay in the cache, instead of temporary arrays of the full size. All the
+ * calls use the inner loops for a single data type.
+ *
+ * See LICENSE.txt for the license.
+ */
+#define _UMATHMODULE
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+
+#include "Python.h"
+
+#include "npy_config.h"
+#ifdef ENABLE_SEPARATE_COMPILATION
+#define PY_ARRAY_UNIQUE_SYMBOL _npy_umathmodule_ARRAY_API
+#define NO_IMPORT_ARRAY
+#endif
+
+#include "numpy/npy_3kcompat.h"
+
+#include "numpy/arrayobject.h"
+#include "numpy/ufuncobject.h"
+#include "ufunc_threads.h"
+#include "ufunc_evaluate.h"
+
+/* A ufunc call of the program, the slot of its output is the last one */
+typedef struct {
+    PyUFuncGenericFunction innerloop;
+    void *innerloopdata;
+    int nargs;
+    int slots[NPY_MAXARGS];
+} evaluate_call;
+
+/*
+ * The slots 0 to nin - 1 are the inputs, nin is the output and the
+ * slots after it are the intermediate buffers.
+ */
+typedef struct {
+    evaluate_call *calls;
+    int ncalls, nin, ntemps;
+    npy_intp itemsize, buffersize;
+    NpyIter_IterNextFunc *iternext;
+    /* for the threaded loop, the iterators and buffers of the tasks */
+    NpyIter **iters;
+    char *temps;
+} evaluate_program;
+
+/*
+ * Runs the program over the remaining iteration of iter, with the ntemps
+ * buffers of buffersize elements in temps.
+ */
+static void
+evaluate_loop(const evaluate_program *prog, NpyIter *iter,
+                    NpyIter_IterNextFunc *iternext, char *temps)
+{
+    char **dataptr = NpyIter_GetDataPtrArray(iter);
+    npy_intp *stride = NpyIter_GetInnerStrideArray(iter);
+    npy_intp *count_ptr = NpyIter_GetInnerLoopSizePtr(iter);
+    int nop = prog->nin + 1, nslots = nop + prog->ntemps;
+    char *slot_ptrs[2*NPY_MAXARGS];
+    npy_intp slot_steps[2*NPY_MAXARGS];
+    char *args[NPY_MAXARGS];
+    npy_intp steps[NPY_MAXARGS];
+    int i, j, c;
+
+    for (i = nop; i < nslots; ++i) {
+        slot_ptrs[i] = temps + (i - nop) * prog->buffersize * prog->itemsize;
+        slot_steps[i] = prog->itemsize;
+    }
+    do {
+        npy_intp offset, count = *count_ptr;
+
+        /* the iterator should not give more, but the buffers are fixed */
+        for (offset = 0; offset < count; offset += prog->buffersize) {
+            npy_intp n = count - offset;
+
+            if (n > prog->buffersize) {
+                n = prog->buffersize;
+            }
+            for (i = 0; i < nop; ++i) {
+                slot_ptrs[i] = dataptr[i] + offset * stride[i];
+                slot_steps[i] = stride[i];
+            }
+            for (c = 0; c < prog->ncalls; ++c) {
+                const evaluate_call *call = &prog->calls[c];
+
+                for (j = 0; j < call->nargs; ++j) {
+                    args[j] = slot_ptrs[call->slots[j]];
+                    steps[j] = slot_steps[call->slots[j]];
+                }
+                call->innerloop(args, &n, steps, call->innerloopdata);
+            }
+        }
+    } while (iternext(iter));
+}
+
+static void
+evaluate_task(void *arg, npy_intp itask)
+{
+    evaluate_program *prog = (evaluate_program *)arg;
+
+    evaluate_loop(prog, prog->iters[itask], prog->iternext,
+                  prog->temps + itask * prog->ntemps *
+                                prog->buffersize * prog->itemsize);
+}
+
+/*
+ * Splits the iteration into ntasks ranges like the threaded ufunc loop,
+ * each task gets its own intermediate buffers.
+ */
+static int
+evaluate_threaded(evaluate_program *prog, NpyIter *iter, npy_intp ntasks)
+{
+    npy_intp itask, ncopies = 0, size = NpyIter_GetIterSize(iter), chunk;
+    npy_intp tempsize = prog->ntemps * prog->buffersize * prog->itemsize;
+    int ret = -1;
+
+    NPY_BEGIN_THREADS_DEF;
+
+    chunk = (size + ntasks - 1) / ntasks;
+    chunk = (chunk + 63) & ~(npy_intp)63;
+    ntasks = (size + chunk - 1) / chunk;
+
+    prog->iters = (NpyIter **)PyArray_malloc(ntasks * sizeof(NpyIter *));
+    prog->temps = PyArray_malloc(ntasks * tempsize + 1);
+    if (prog->iters == NULL || prog->temps == NULL) {
+        PyErr_NoMemory();
+        goto finish;
+    }
+    prog->iters[0] = iter;
+    for (ncopies = 1; ncopies < ntasks; ++ncopies) {
+        prog->iters[ncopies] = NpyIter_Copy(iter);
+        if (prog->iters[ncopies] == NULL) {
+            goto finish;
+        }
+    }
+    for (itask = 0; itask < ntasks; ++itask) {
+        npy_intp end = (itask + 1) * chunk;
+        if (NpyIter_ResetToIterIndexRange(prog->iters[itask], itask * chunk,
+                                end < size ? end : size, NULL) != NPY_SUCCEED) {
+            goto finish;
+        }
+    }
+
+    NPY_BEGIN_THREADS;
+    npy_ufunc_run_tasks(&evaluate_task, prog, ntasks);
+    NPY_END_THREADS;
+    ret = 0;
+
+finish:
+    while (--ncopies > 0) {
+        NpyIter_Deallocate(prog->iters[ncopies]);
+    }
+    PyArray_free(prog->iters);
+    PyArray_free(prog->temps);
+    prog->iters = NULL;
+    prog->temps = NULL;
+    return ret;
+}
+
+/*
+ * Fills in the call from a (ufunc, slots) tuple of the program, with the
+ * inner loop of the ufunc for dtype.
+ */
+static int
+evaluate_parse_call(PyObject *item, PyArray_Descr *dtype, int nin,
+                    evaluate_call *call, int *ntemps, int *needs_api)
+{
+    PyUFuncObject *ufunc;
+    PyObject *slots;
+    PyArray_Descr *dtypes[NPY_MAXARGS];
+    int i, api = 0;
+
+    if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2 ||
+            !PyObject_TypeCheck(PyTuple_GET_ITEM(item, 0), &PyUFunc_Type) ||
+            !PyTuple_Check(PyTuple_GET_ITEM(item, 1))) {
+        PyErr_SetString(PyExc_TypeError,
+                "program items must be (ufunc, slots) tuples");
+        return -1;
+    }
+    ufunc = (PyUFuncObject *)PyTuple_GET_ITEM(item, 0);
+    slots = PyTuple_GET_ITEM(item, 1);
+    if (ufunc->nout != 1 || ufunc->core_enabled ||
+            ufunc->legacy_inner_loop_selector == NULL) {
+        PyErr_Format(PyExc_TypeError,
+                "ufunc '%s' can not be evaluated, only element-wise "
+                "ufuncs with one output are supported",
+                ufunc->name ? ufunc->name : "<unnamed>");
+        return -1;
+    }
+    call->nargs = ufunc->nargs;
+    if (PyTuple_GET_SIZE(slots) != call->nargs) {
+        PyErr_Format(PyExc_ValueError,
+                "ufunc '%s' takes %d slots",
+                ufunc->name ? ufunc->name : "<unnamed>", call->nargs);
+        return -1;
+    }
+    for (i = 0; i < call->nargs; ++i) {
+        long slot = PyInt_AsLong(PyTuple_GET_ITEM(slots, i));
+
+        if (slot == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        /* the inputs are only read */
+        if (slot < 0 || slot >= nin + 1 + NPY_EVALUATE_MAX_TEMPS ||
+                (i == call->nargs - 1 && slot < nin)) {
+            PyErr_Format(PyExc_ValueError,
+                    "slot %ld out of range", slot);
+            return -1;
+        }
+        if (slot - nin > *ntemps) {
+            *ntemps = slot - nin;
+        }
+        call->slots[i] = (int)slot;
+        dtypes[i] = dtype;
+    }
+
+    if (ufunc->legacy_inner_loop_selector(ufunc, dtypes,
+                    &call->innerloop, &call->innerloopdata, &api) < 0) {
+        return -1;
+    }
+    *needs_api |= api;
+    return 0;
+}
+
+NPY_NO_EXPORT PyObject *
+ufunc_evaluate(PyObject *NPY_UNUSED(dummy), PyObject *args)
+{
+    PyObject *program, *operands, *out = Py_None, *errobj = NULL;
+    PyArray_Descr *dtype = NULL;
+    PyArrayObject *op[NPY_MAXARGS];
+    PyArray_Descr *op_dtypes[NPY_MAXARGS];
+    npy_uint32 op_flags[NPY_MAXARGS];
+    evaluate_program prog;
+    NpyIter *iter = NULL;
+    PyArrayObject *ret = NULL;
+    int i, nop = 0, needs_api = 0, buffersize = 0, errormask = 0, first = 1;
+
+    NPY_BEGIN_THREADS_DEF;
+
+    memset(&prog, 0, sizeof(prog));
+    if (!PyArg_ParseTuple(args, "O!O!O&|O:_evaluate",
+                &PyTuple_Type, &program, &PyTuple_Type, &operands,
+                &PyArray_DescrConverter, &dtype, &out)) {
+        return NULL;
+    }
+    if (PyDataType_REFCHK(dtype) || PyDataType_ISFLEXIBLE(dtype)) {
+        PyErr_SetString(PyExc_TypeError,
+                "evaluate does not support object or flexible types");
+        goto finish;
+    }
+    if (out != Py_None && !PyArray_Check(out)) {
+        PyErr_SetString(PyExc_TypeError, "out must be an array");
+        goto finish;
+    }
+
+    prog.nin = (int)PyTuple_GET_SIZE(operands);
+    if (prog.nin >= NPY_MAXARGS) {
+        PyErr_Format(PyExc_ValueError,
+                "too many operands, at most %d are supported",
+                NPY_MAXARGS - 1);
+        goto finish;
+    }
+    for (nop = 0; nop < prog.nin; ++nop) {
+        op[nop] = (PyArrayObject *)PyArray_FromAny(
+                                    PyTuple_GET_ITEM(operands, nop),
+                                    NULL, 0, 0, 0, NULL);
+        if (op[nop] == NULL) {
+            goto finish;
+        }
+        op_flags[nop] = NPY_ITER_READONLY | NPY_ITER_ALIGNED;
+        op_dtypes[nop] = dtype;
+    }
+    op[nop] = (PyArrayObject *)(out == Py_None ? NULL : out);
+    Py_XINCREF(op[nop]);
+    op_flags[nop] = NPY_ITER_WRITEONLY | NPY_ITER_ALIGNED |
+                    NPY_ITER_ALLOCATE | NPY_ITER_NO_BROADCAST |
+                    NPY_ITER_NO_SUBTYPE;
+    op_dtypes[nop] = dtype;
+    nop++;
+
+    prog.ncalls = (int)PyTuple_GET_SIZE(program);
+    prog.calls = (evaluate_call *)PyArray_malloc(
+                            (prog.ncalls + 1) * sizeof(evaluate_call));
+    if (prog.calls == NULL) {
+        PyErr_NoMemory();
+        goto finish;
+    }
+    for (i = 0; i < prog.ncalls; ++i) {
+        if (evaluate_parse_call(PyTuple_GET_ITEM(program, i), dtype,
+                    prog.nin, &prog.calls[i], &prog.ntemps, &needs_api) < 0) {
+            goto finish;
+        }
+    }
+
+    if (PyUFunc_GetPyValues("evaluate",
+                            &buffersize, &errormask, &errobj) < 0) {
+        goto finish;
+    }
+
+    iter = NpyIter_AdvancedNew(nop, op,
+                        NPY_ITER_EXTERNAL_LOOP|
+                        NPY_ITER_ZEROSIZE_OK|
+                        NPY_ITER_BUFFERED|
+                        NPY_ITER_DELAY_BUFALLOC|
+                        (needs_api ? 0 : NPY_ITER_RANGED),
+                        NPY_KEEPORDER, NPY_SAME_KIND_CASTING,
+                        op_flags, op_dtypes,
+                        0, NULL, NULL, buffersize);
+    if (iter == NULL) {
+        goto finish;
+    }
+    ret = NpyIter_GetOperandArray(iter)[prog.nin];
+    Py_INCREF(ret);
+
+    if (NpyIter_GetIterSize(iter) != 0) {
+        npy_intp ntasks = 1;
+
+        if (NpyIter_Reset(iter, NULL) != NPY_SUCCEED) {
+            goto fail;
+        }
+        prog.iternext = NpyIter_GetIterNext(iter, NULL);
+        if (prog.iternext == NULL) {
+            goto fail;
+        }
+        prog.itemsize = dtype->elsize;
+        prog.buffersize = NpyIter_GetBufferSize(iter);
+        if (prog.buffersize <= 0) {
+            prog.buffersize = buffersize;
+        }
+        if (!needs_api && !npy_ufunc_operands_overlap(op, prog.nin, nop)) {
+            ntasks = npy_ufunc_num_tasks(NpyIter_GetIterSize(iter));
+        }
+
+        PyUFunc_clearfperr();
+        if (ntasks > 1) {
+            if (evaluate_threaded(&prog, iter, ntasks) < 0) {
+                goto fail;
+            }
+        }
+        else {
+            char *temps = PyArray_malloc(
+                    prog.ntemps * prog.buffersize * prog.itemsize + 1);
+
+            if (temps == NULL) {
+                PyErr_NoMemory();
+                goto fail;
+            }
+            if (!needs_api) {
+                NPY_BEGIN_THREADS;
+            }
+            evaluate_loop(&prog, iter, prog.iternext, temps);
+            if (!needs_api) {
+                NPY_END_THREADS;
+            }
+            PyArray_free(temps);
+            if (needs_api && PyErr_Occurred()) {
+                goto fail;
+            }
+        }
+        if (PyUFunc_checkfperr(errormask, errobj, &first) < 0) {
+            goto fail;
+        }
+    }
+    goto finish;
+
+fail:
+    Py_CLEAR(ret);
+finish:
+    if (iter != NULL) {
+        NpyIter_Deallocate(iter);
+    }
+    for (i = 0; i < nop; ++i) {
+        Py_XDECREF(op[i]);
+    }
+    PyArray_free(prog.calls);
+    Py_XDECREF(errobj);
+    Py_XDECREF(dtype);
+    return (PyObject *)ret;
+}
@@ -0,0 +1,18 @@
+#ifndef _NPY_UMATH_UFUNC_EVALUATE_H_
+#define _NPY_UMATH_UFUNC_EVALUATE_H_
+
+/*
+ * Largest number of intermediate buffers a program of _evaluate can use,
+ * the slots of the operands and the buffers together are at most twice
+ * NPY_MAXARGS.
+ */
+#define NPY_EVALUATE_MAX_TEMPS NPY_MAXARGS
+
+/*
+ * This is the '_evaluate' function exposed for calling from Python,
+ * see numpy.core.numeric.evaluate for the program it runs.
+ */
+NPY_NO_EXPORT PyObject *
+ufunc_evaluate(PyObject *NPY_UNUSED(dummy), PyObject *args);
+
+#endif
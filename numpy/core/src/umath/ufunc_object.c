@@ -42,6 +42,7 @@
 #include "ufunc_type_resolution.h"
 
 #include "ufunc_object.h"
+#include "ufunc_threads.h"
 
 /********** PRINTF DEBUG TRACING **************/
 #define NPY_UF_DBG_TRACING 0
@@ -1084,10 +1085,78 @@ check_for_trivial_loop(PyUFuncObject *ufunc,
     return 1;
 }
 
+/* The trivial loop split into tasks of 'chunk' elements */
+typedef struct {
+    PyUFuncGenericFunction innerloop;
+    void *innerloopdata;
+    int nop;
+    char *data[NPY_MAXARGS];
+    npy_intp stride[NPY_MAXARGS];
+    npy_intp count, chunk;
+} trivial_loop_tasks;
+
+static void
+trivial_loop_task(void *arg, npy_intp itask)
+{
+    trivial_loop_tasks *tasks = (trivial_loop_tasks *)arg;
+    npy_intp start = itask * tasks->chunk;
+    npy_intp count[NPY_MAXARGS];
+    char *data[NPY_MAXARGS];
+    int iop;
+
+    for (iop = 0; iop < tasks->nop; ++iop) {
+        data[iop] = tasks->data[iop] + start * tasks->stride[iop];
+        count[iop] = tasks->count - start;
+        if (count[iop] > tasks->chunk) {
+            count[iop] = tasks->chunk;
+        }
+    }
+    tasks->innerloop(data, count, tasks->stride, tasks->innerloopdata);
+}
+
+/*
+ * Runs the inner loop of a trivial iteration, split over the ufunc
+ * threads if it is large enough and the outputs don't overlap with the
+ * inputs. A loop which uses the arrays as its data sees the whole
+ * arrays, so it is never split. Called without the GIL.
+ */
+static void
+run_trivial_loop(PyArrayObject **op, int nin, int nop,
+                    char **data, npy_intp *count, npy_intp *stride,
+                    PyUFuncGenericFunction innerloop,
+                    void *innerloopdata, int uses_arrays)
+{
+    npy_intp ntasks = npy_ufunc_num_tasks(count[0]);
+
+    if (ntasks > 1 && !uses_arrays &&
+                !npy_ufunc_operands_overlap(op, nin, nop)) {
+        trivial_loop_tasks tasks;
+        int iop;
+
+        tasks.innerloop = innerloop;
+        tasks.innerloopdata = innerloopdata;
+        tasks.nop = nop;
+        for (iop = 0; iop < nop; ++iop) {
+            tasks.data[iop] = data[iop];
+            tasks.stride[iop] = stride[iop];
+        }
+        tasks.count = count[0];
+        /* whole cache lines for each task */
+        tasks.chunk = (count[0] + ntasks - 1) / ntasks;
+        tasks.chunk = (tasks.chunk + 63) & ~(npy_intp)63;
+        ntasks = (count[0] + tasks.chunk - 1) / tasks.chunk;
+
+        npy_ufunc_run_tasks(&trivial_loop_task, &tasks, ntasks);
+    }
+    else {
+        innerloop(data, count, stride, innerloopdata);
+    }
+}
+
 static void
 trivial_two_operand_loop(PyArrayObject **op,
                     PyUFuncGenericFunction innerloop,
-                    void *innerloopdata)
+                    void *innerloopdata, int uses_arrays)
 {
     char *data[2];
     npy_intp count[2], stride[2];
@@ -1106,19 +1175,19 @@ trivial_two_operand_loop(PyArrayObject **op,
 
     if (!needs_api) {
         NPY_BEGIN_THREADS;
-    }
-
-    innerloop(data, count, stride, innerloopdata);
-
-    if (!needs_api) {
+        run_trivial_loop(op, 1, 2, data, count, stride,
+                            innerloop, innerloopdata, uses_arrays);
         NPY_END_THREADS;
     }
+    else {
+        innerloop(data, count, stride, innerloopdata);
+    }
 }
 
 static void
 trivial_three_operand_loop(PyArrayObject **op,
                     PyUFuncGenericFunction innerloop,
-                    void *innerloopdata)
+                    void *innerloopdata, int uses_arrays)
 {
     char *data[3];
     npy_intp count[3], stride[3];
@@ -1139,13 +1208,13 @@ trivial_three_operand_loop(PyArrayObject **op,
 
     if (!needs_api) {
         NPY_BEGIN_THREADS;
-    }
-
-    innerloop(data, count, stride, innerloopdata);
-
-    if (!needs_api) {
+        run_trivial_loop(op, 2, 3, data, count, stride,
+                            innerloop, innerloopdata, uses_arrays);
         NPY_END_THREADS;
     }
+    else {
+        innerloop(data, count, stride, innerloopdata);
+    }
 }
 
 /*
@@ -1211,6 +1280,89 @@ prepare_ufunc_output(PyUFuncObject *ufunc,
     return 0;
 }
 
+/*
+ * Each task runs its own copy of the iterator, reset to a range of the
+ * iteration indices.
+ */
+typedef struct {
+    PyUFuncGenericFunction innerloop;
+    void *innerloopdata;
+    NpyIter_IterNextFunc *iternext;
+    NpyIter **iters;
+} iterator_loop_tasks;
+
+static void
+iterator_loop_task(void *arg, npy_intp itask)
+{
+    iterator_loop_tasks *tasks = (iterator_loop_tasks *)arg;
+    NpyIter *iter = tasks->iters[itask];
+    char **dataptr = NpyIter_GetDataPtrArray(iter);
+    npy_intp *stride = NpyIter_GetInnerStrideArray(iter);
+    npy_intp *count_ptr = NpyIter_GetInnerLoopSizePtr(iter);
+
+    do {
+        tasks->innerloop(dataptr, count_ptr, stride, tasks->innerloopdata);
+    } while (tasks->iternext(iter));
+}
+
+/*
+ * Splits the iteration of a ranged iterator into ntasks ranges and runs
+ * them on the ufunc threads. The copies of the iterator are made and
+ * reset while still holding the GIL.
+ */
+static int
+run_iterator_loop_threaded(NpyIter *iter, npy_intp ntasks,
+                    NpyIter_IterNextFunc *iternext,
+                    PyUFuncGenericFunction innerloop,
+                    void *innerloopdata)
+{
+    npy_intp itask, ncopies, size = NpyIter_GetIterSize(iter), chunk;
+    iterator_loop_tasks tasks;
+    int ret = -1;
+
+    NPY_BEGIN_THREADS_DEF;
+
+    chunk = (size + ntasks - 1) / ntasks;
+    chunk = (chunk + 63) & ~(npy_intp)63;
+    ntasks = (size + chunk - 1) / chunk;
+
+    tasks.iters = (NpyIter **)PyArray_malloc(ntasks * sizeof(NpyIter *));
+    if (tasks.iters == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    tasks.iters[0] = iter;
+    for (ncopies = 1; ncopies < ntasks; ++ncopies) {
+        tasks.iters[ncopies] = NpyIter_Copy(iter);
+        if (tasks.iters[ncopies] == NULL) {
+            goto finish;
+        }
+    }
+    for (itask = 0; itask < ntasks; ++itask) {
+        npy_intp end = (itask + 1) * chunk;
+        if (NpyIter_ResetToIterIndexRange(tasks.iters[itask], itask * chunk,
+                                end < size ? end : size, NULL) != NPY_SUCCEED) {
+            goto finish;
+        }
+    }
+    tasks.innerloop = innerloop;
+    tasks.innerloopdata = innerloopdata;
+    tasks.iternext = iternext;
+
+    NPY_BEGIN_THREADS;
+    npy_ufunc_run_tasks(&iterator_loop_task, &tasks, ntasks);
+    NPY_END_THREADS;
+    ret = 0;
+
+finish:
+    /* The first iterator is the caller's */
+    for (itask = 1; itask < ncopies; ++itask) {
+        NpyIter_Deallocate(tasks.iters[itask]);
+    }
+    PyArray_free(tasks.iters);
+    return ret;
+}
+
 static int
 iterator_loop(PyUFuncObject *ufunc,
                     PyArrayObject **op,
@@ -1220,7 +1372,8 @@ iterator_loop(PyUFuncObject *ufunc,
                     PyObject **arr_prep,
                     PyObject *arr_prep_args,
                     PyUFuncGenericFunction innerloop,
-                    void *innerloopdata)
+                    void *innerloopdata,
+                    int uses_arrays)
 {
     npy_intp i, nin = ufunc->nin, nout = ufunc->nout;
     npy_intp nop = nin + nout;
@@ -1228,6 +1381,8 @@ iterator_loop(PyUFuncObject *ufunc,
     NpyIter *iter;
     char *baseptrs[NPY_MAXARGS];
     int needs_api;
+    int ranged = npy_ufunc_get_num_threads() > 1;
+    npy_intp ntasks;
 
     NpyIter_IterNextFunc *iternext;
     char **dataptr;
@@ -1254,7 +1409,8 @@ iterator_loop(PyUFuncObject *ufunc,
     /*
      * Allocate the iterator.  Because the types of the inputs
      * were already checked, we use the casting rule 'unsafe' which
-     * is faster to calculate.
+     * is faster to calculate. It is ranged so that the loop can be
+     * split over threads.
      */
     iter = NpyIter_AdvancedNew(nop, op,
                         NPY_ITER_EXTERNAL_LOOP|
@@ -1262,7 +1418,8 @@ iterator_loop(PyUFuncObject *ufunc,
                         NPY_ITER_ZEROSIZE_OK|
                         NPY_ITER_BUFFERED|
                         NPY_ITER_GROWINNER|
-                        NPY_ITER_DELAY_BUFALLOC,
+                        NPY_ITER_DELAY_BUFALLOC|
+                        (ranged ? NPY_ITER_RANGED : 0),
                         order, NPY_UNSAFE_CASTING,
                         op_flags, dtype,
                         0, NULL, NULL, buffersize);
@@ -1315,18 +1472,36 @@ iterator_loop(PyUFuncObject *ufunc,
         stride = NpyIter_GetInnerStrideArray(iter);
         count_ptr = NpyIter_GetInnerLoopSizePtr(iter);
 
-        if (!needs_api) {
-            NPY_BEGIN_THREADS;
+        ntasks = 1;
+        if (ranged && !needs_api && !uses_arrays &&
+                !npy_ufunc_operands_overlap(op, nin, nop)) {
+            ntasks = npy_ufunc_num_tasks(NpyIter_GetIterSize(iter));
         }
 
-        /* Execute the loop */
-        do {
-            NPY_UF_DBG_PRINT1("iterator loop count %d\n", (int)*count_ptr);
-            innerloop(dataptr, count_ptr, stride, innerloopdata);
-        } while (iternext(iter));
+        if (ntasks > 1) {
+            NPY_UF_DBG_PRINT1("threaded iterator loop tasks %d\n",
+                                                        (int)ntasks);
+            if (run_iterator_loop_threaded(iter, ntasks, iternext,
+                                    innerloop, innerloopdata) < 0) {
+                NpyIter_Deallocate(iter);
+                return -1;
+            }
+        }
+        else {
+            if (!needs_api) {
+                NPY_BEGIN_THREADS;
+            }
 
-        if (!needs_api) {
-            NPY_END_THREADS;
+            /* Execute the loop */
+            do {
+                NPY_UF_DBG_PRINT1("iterator loop count %d\n",
+                                                    (int)*count_ptr);
+                innerloop(dataptr, count_ptr, stride, innerloopdata);
+            } while (iternext(iter));
+
+            if (!needs_api) {
+                NPY_END_THREADS;
+            }
         }
     }
 
@@ -1358,14 +1533,15 @@ execute_legacy_ufunc_loop(PyUFuncObject *ufunc,
     npy_intp nin = ufunc->nin, nout = ufunc->nout;
     PyUFuncGenericFunction innerloop;
     void *innerloopdata;
-    int needs_api = 0;
+    int needs_api = 0, uses_arrays;
 
     if (ufunc->legacy_inner_loop_selector(ufunc, dtypes,
                     &innerloop, &innerloopdata, &needs_api) < 0) {
         return -1;
     }
     /* If the loop wants the arrays, provide them. */
-    if (_does_loop_use_arrays(innerloopdata)) {
+    uses_arrays = _does_loop_use_arrays(innerloopdata);
+    if (uses_arrays) {
         innerloopdata = (void*)op;
     }
 
@@ -1392,7 +1568,8 @@ execute_legacy_ufunc_loop(PyUFuncObject *ufunc,
                 }
 
                 NPY_UF_DBG_PRINT("trivial 1 input with allocated output\n");
-                trivial_two_operand_loop(op, innerloop, innerloopdata);
+                trivial_two_operand_loop(op, innerloop, innerloopdata,
+                                            uses_arrays);
 
                 return 0;
             }
@@ -1407,7 +1584,8 @@ execute_legacy_ufunc_loop(PyUFuncObject *ufunc,
                 }
 
                 NPY_UF_DBG_PRINT("trivial 1 input\n");
-                trivial_two_operand_loop(op, innerloop, innerloopdata);
+                trivial_two_operand_loop(op, innerloop, innerloopdata,
+                                            uses_arrays);
 
                 return 0;
             }
@@ -1444,7 +1622,8 @@ execute_legacy_ufunc_loop(PyUFuncObject *ufunc,
                 }
 
                 NPY_UF_DBG_PRINT("trivial 2 input with allocated output\n");
-                trivial_three_operand_loop(op, innerloop, innerloopdata);
+                trivial_three_operand_loop(op, innerloop, innerloopdata,
+                                            uses_arrays);
 
                 return 0;
             }
@@ -1460,7 +1639,8 @@ execute_legacy_ufunc_loop(PyUFuncObject *ufunc,
                 }
 
                 NPY_UF_DBG_PRINT("trivial 2 input\n");
-                trivial_three_operand_loop(op, innerloop, innerloopdata);
+                trivial_three_operand_loop(op, innerloop, innerloopdata,
+                                            uses_arrays);
 
                 return 0;
             }
@@ -1475,7 +1655,7 @@ execute_legacy_ufunc_loop(PyUFuncObject *ufunc,
     NPY_UF_DBG_PRINT("iterator loop\n");
     if (iterator_loop(ufunc, op, dtypes, order,
                     buffersize, arr_prep, arr_prep_args,
-                    innerloop, innerloopdata) < 0) {
+                    innerloop, innerloopdata, uses_arrays) < 0) {
         return -1;
     }
 
@@ -1774,9 +1954,11 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
     PyArray_Descr *dtypes[NPY_MAXARGS];
 
     /* Use remapped axes for generalized ufunc */
-    int broadcast_ndim, op_ndim;
+    int broadcast_ndim, iter_ndim;
     int op_axes_arrays[NPY_MAXARGS][NPY_MAXDIMS];
     int *op_axes[NPY_MAXARGS];
+    npy_intp iter_shape[NPY_MAXDIMS];
+    npy_intp core_dim_sizes[NPY_MAXDIMS];
 
     npy_uint32 op_flags[NPY_MAXARGS];
 
@@ -1795,8 +1977,8 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
     /* The strides which get passed to the inner loop */
     npy_intp *inner_strides = NULL;
 
-    npy_intp *inner_strides_tmp, *ax_strides_tmp[NPY_MAXDIMS];
-    int core_dim_ixs_size, *core_dim_ixs;
+    npy_intp *inner_strides_tmp;
+    int core_dim_ixs_size, *core_dim_ixs, j;
     int use_maskna = 0;
 
     /* The __array_prepare__ function to call for each output */
@@ -1857,8 +2039,11 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
             broadcast_ndim = n;
         }
     }
-    op_ndim = broadcast_ndim + ufunc->core_num_dim_ix;
-    if (op_ndim > NPY_MAXDIMS) {
+    iter_ndim = broadcast_ndim;
+    for (i = nin; i < nop; ++i) {
+        iter_ndim += ufunc->core_num_dims[i];
+    }
+    if (iter_ndim > NPY_MAXDIMS) {
         PyErr_Format(PyExc_ValueError,
                     "too many dimensions for generalized ufunc %s",
                     ufunc_name);
@@ -1866,7 +2051,70 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
         goto fail;
     }
 
-    /* Fill in op_axes for all the operands */
+    /*
+     * Find the sizes of the core dimensions. The core dimensions of the
+     * inputs broadcast like the others, while the outputs must match.
+     * They are not iterated over, the loop gets them from the operands,
+     * so that a dimension may appear more than once in an operand.
+     */
+    for (i = 0; i < ufunc->core_num_dim_ix; ++i) {
+        core_dim_sizes[i] = -1;
+    }
+    core_dim_ixs = ufunc->core_dim_ixs;
+    for (i = 0; i < nop; ++i) {
+        int n;
+
+        if (op[i] == NULL) {
+            core_dim_ixs += ufunc->core_num_dims[i];
+            continue;
+        }
+        n = PyArray_NDIM(op[i]) - ufunc->core_num_dims[i];
+        if (i >= nin && n < 0) {
+            PyErr_Format(PyExc_ValueError,
+                    "%s: output operand %d has fewer dimensions than the "
+                    "%d core dimensions of its signature %s",
+                    ufunc_name, i - nin, ufunc->core_num_dims[i],
+                    ufunc->core_signature);
+            retval = -1;
+            goto fail;
+        }
+        for (idim = 0; idim < ufunc->core_num_dims[i]; ++idim) {
+            npy_intp *core_size = &core_dim_sizes[core_dim_ixs[idim]];
+            npy_intp size;
+
+            /* a missing dimension of an input broadcasts */
+            if (n + idim < 0) {
+                continue;
+            }
+            size = PyArray_DIM(op[i], n + idim);
+            if (*core_size == -1 || *core_size == 1) {
+                *core_size = size;
+            }
+            else if (size != *core_size && (size != 1 || i >= nin)) {
+                PyErr_Format(PyExc_ValueError,
+                        "%s: operand %d has a mismatch in its core "
+                        "dimension %d, with signature %s (size %"
+                        NPY_INTP_FMT " is different from %" NPY_INTP_FMT ")",
+                        ufunc_name, i, idim, ufunc->core_signature,
+                        size, *core_size);
+                retval = -1;
+                goto fail;
+            }
+        }
+        core_dim_ixs += ufunc->core_num_dims[i];
+    }
+    /* a dimension only in outputs that get allocated */
+    for (i = 0; i < ufunc->core_num_dim_ix; ++i) {
+        if (core_dim_sizes[i] == -1) {
+            core_dim_sizes[i] = 1;
+        }
+    }
+
+    /*
+     * Fill in op_axes for all the operands: the iterator has the broadcast
+     * dimensions, followed by the core dimensions of each output in turn.
+     */
+    j = broadcast_ndim;
     core_dim_ixs_size = 0;
     core_dim_ixs = ufunc->core_dim_ixs;
     for (i = 0; i < nop; ++i) {
@@ -1889,24 +2137,31 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
             else {
                 op_axes_arrays[i][idim] = -1;
             }
+            iter_shape[idim] = -1;
         }
-        /* Use the signature information for the rest */
-        for (idim = broadcast_ndim; idim < op_ndim; ++idim) {
+        for (idim = broadcast_ndim; idim < iter_ndim; ++idim) {
             op_axes_arrays[i][idim] = -1;
         }
-        for (idim = 0; idim < ufunc->core_num_dims[i]; ++idim) {
-            if (n + idim >= 0) {
-                op_axes_arrays[i][broadcast_ndim + core_dim_ixs[idim]] =
-                                                                    n + idim;
-            }
-            else {
-                op_axes_arrays[i][broadcast_ndim + core_dim_ixs[idim]] = -1;
+        /* The core dimensions of an output, for allocating it */
+        if (i >= nin) {
+            for (idim = 0; idim < ufunc->core_num_dims[i]; ++idim, ++j) {
+                iter_shape[j] = core_dim_sizes[core_dim_ixs[idim]];
+                op_axes_arrays[i][j] = n + idim;
             }
         }
         core_dim_ixs_size += ufunc->core_num_dims[i];
         core_dim_ixs += ufunc->core_num_dims[i];
         op_axes[i] = op_axes_arrays[i];
     }
+    /* The iterator needs a dimension for op_axes, add one of size 1 */
+    if (iter_ndim == 0) {
+        for (i = 0; i < nop; ++i) {
+            op_axes_arrays[i][0] = -1;
+        }
+        iter_shape[0] = 1;
+        iter_ndim = 1;
+        broadcast_ndim = 1;
+    }
 
     /* Get the buffersize, errormask, and error object globals */
     if (extobj == NULL) {
@@ -2014,9 +2269,10 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
     /* Create the iterator */
     iter = NpyIter_AdvancedNew(nop, op, NPY_ITER_MULTI_INDEX|
                                       NPY_ITER_REFS_OK|
-                                      NPY_ITER_REDUCE_OK,
+                                      NPY_ITER_REDUCE_OK|
+                                      NPY_ITER_ZEROSIZE_OK,
                            order, NPY_UNSAFE_CASTING, op_flags,
-                           dtypes, op_ndim, op_axes, NULL, 0);
+                           dtypes, iter_ndim, op_axes, iter_shape, 0);
     if (iter == NULL) {
         retval = -1;
         goto fail;
@@ -2033,43 +2289,69 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
     /*
      * Set up the inner strides array. Because we're not doing
      * buffering, the strides are fixed throughout the looping.
+     * The core strides come from the operands the iterator uses, which
+     * may be copies, and are 0 for the broadcast core dimensions.
      */
     inner_strides = (npy_intp *)PyArray_malloc(
                         NPY_SIZEOF_INTP * (nop+core_dim_ixs_size));
+    if (inner_strides == NULL) {
+        PyErr_NoMemory();
+        retval = -1;
+        goto fail;
+    }
     /* The strides after the first nop match core_dim_ixs */
     core_dim_ixs = ufunc->core_dim_ixs;
     inner_strides_tmp = inner_strides + nop;
-    for (idim = 0; idim < ufunc->core_num_dim_ix; ++idim) {
-        ax_strides_tmp[idim] = NpyIter_GetAxisStrideArray(iter,
-                                                broadcast_ndim+idim);
-        if (ax_strides_tmp[idim] == NULL) {
-            retval = -1;
-            goto fail;
-        }
-    }
     for (i = 0; i < nop; ++i) {
+        PyArrayObject *op_it = NpyIter_GetOperandArray(iter)[i];
+        int n = PyArray_NDIM(op_it) - ufunc->core_num_dims[i];
+
         for (idim = 0; idim < ufunc->core_num_dims[i]; ++idim) {
-            inner_strides_tmp[idim] = ax_strides_tmp[core_dim_ixs[idim]][i];
+            if (n + idim >= 0 && PyArray_DIM(op_it, n + idim) ==
+                                    core_dim_sizes[core_dim_ixs[idim]]) {
+                inner_strides_tmp[idim] = PyArray_STRIDE(op_it, n + idim);
+            }
+            else {
+                inner_strides_tmp[idim] = 0;
+            }
         }
 
         core_dim_ixs += ufunc->core_num_dims[i];
         inner_strides_tmp += ufunc->core_num_dims[i];
     }
 
-    /* Set up the inner dimensions array */
-    if (NpyIter_GetShape(iter, inner_dimensions) != NPY_SUCCEED) {
-        retval = -1;
-        goto fail;
-    }
-    /* Move the core dimensions to start at the second element */
-    memmove(&inner_dimensions[1], &inner_dimensions[broadcast_ndim],
+    /* Set up the inner dimensions array, the core dimensions follow */
+    memcpy(&inner_dimensions[1], core_dim_sizes,
                         NPY_SIZEOF_INTP * ufunc->core_num_dim_ix);
 
-    /* Remove all the core dimensions from the iterator */
-    for (i = 0; i < ufunc->core_num_dim_ix; ++i) {
-        if (NpyIter_RemoveAxis(iter, broadcast_ndim) != NPY_SUCCEED) {
-            retval = -1;
-            goto fail;
+    /*
+     * Remove the core dimensions of the outputs from the iterator. A
+     * zero-sized one can't be removed and leaves nothing to iterate,
+     * which is only right when every output is empty.
+     */
+    for (i = broadcast_ndim; i < iter_ndim; ++i) {
+        if (iter_shape[i] == 0) {
+            break;
+        }
+    }
+    if (i < iter_ndim) {
+        for (i = nin; i < nop; ++i) {
+            if (PyArray_SIZE(op[i]) != 0) {
+                PyErr_Format(PyExc_ValueError,
+                        "%s: an output has a zero-sized core dimension "
+                        "while output %d is not empty",
+                        ufunc_name, i - nin);
+                retval = -1;
+                goto fail;
+            }
+        }
+    }
+    else {
+        for (i = broadcast_ndim; i < iter_ndim; ++i) {
+            if (NpyIter_RemoveAxis(iter, broadcast_ndim) != NPY_SUCCEED) {
+                retval = -1;
+                goto fail;
+            }
         }
     }
     if (NpyIter_RemoveMultiIndex(iter) != NPY_SUCCEED) {
@@ -2586,36 +2868,20 @@ assign_reduce_identity_one(PyArrayObject *result, int preservena, void *data)
     return PyArray_AssignOne(result, NULL, preservena, NULL);
 }
 
-static int
-reduce_loop(NpyIter *iter, char **dataptrs, npy_intp *strides,
+/*
+ * Runs the inner loop over the whole iteration of a reduction, skipping
+ * the first-visit elements which were copied into the result. Only uses
+ * the Python API if the inner loop does.
+ */
+static void
+reduce_inner_loops(NpyIter *iter, char **dataptrs, npy_intp *strides,
             npy_intp *countptr, NpyIter_IterNextFunc *iternext,
-            int needs_api, npy_intp skip_first_count, void *data)
+            npy_intp skip_first_count,
+            PyUFuncGenericFunction innerloop, void *innerloopdata)
 {
-    PyArray_Descr *dtypes[3], **iter_dtypes;
-    PyUFuncObject *ufunc = (PyUFuncObject *)data;
     char *dataptrs_copy[3];
     npy_intp strides_copy[3];
 
-    /* The normal selected inner loop */
-    PyUFuncGenericFunction innerloop = NULL;
-    void *innerloopdata = NULL;
-
-    NPY_BEGIN_THREADS_DEF;
-
-    /* Get the inner loop */
-    iter_dtypes = NpyIter_GetDescrArray(iter);
-    dtypes[0] = iter_dtypes[0];
-    dtypes[1] = iter_dtypes[1];
-    dtypes[2] = iter_dtypes[0];
-    if (ufunc->legacy_inner_loop_selector(ufunc, dtypes,
-                            &innerloop, &innerloopdata, &needs_api) < 0) {
-        return -1;
-    }
-
-    if (!needs_api) {
-        NPY_BEGIN_THREADS;
-    }
-
     if (skip_first_count > 0) {
         do {
             npy_intp count = *countptr;
@@ -2649,7 +2915,7 @@ reduce_loop(NpyIter *iter, char **dataptrs, npy_intp *strides,
                     break;
                 }
                 else {
-                    goto finish_loop;
+                    return;
                 }
             }
         } while (iternext(iter));
@@ -2665,8 +2931,39 @@ reduce_loop(NpyIter *iter, char **dataptrs, npy_intp *strides,
         innerloop(dataptrs_copy, countptr,
                     strides_copy, innerloopdata);
     } while (iternext(iter));
+}
+
+static int
+reduce_loop(NpyIter *iter, char **dataptrs, npy_intp *strides,
+            npy_intp *countptr, NpyIter_IterNextFunc *iternext,
+            int needs_api, npy_intp skip_first_count, void *data)
+{
+    PyArray_Descr *dtypes[3], **iter_dtypes;
+    PyUFuncObject *ufunc = (PyUFuncObject *)data;
+
+    /* The normal selected inner loop */
+    PyUFuncGenericFunction innerloop = NULL;
+    void *innerloopdata = NULL;
+
+    NPY_BEGIN_THREADS_DEF;
+
+    /* Get the inner loop */
+    iter_dtypes = NpyIter_GetDescrArray(iter);
+    dtypes[0] = iter_dtypes[0];
+    dtypes[1] = iter_dtypes[1];
+    dtypes[2] = iter_dtypes[0];
+    if (ufunc->legacy_inner_loop_selector(ufunc, dtypes,
+                            &innerloop, &innerloopdata, &needs_api) < 0) {
+        return -1;
+    }
+
+    if (!needs_api) {
+        NPY_BEGIN_THREADS;
+    }
+
+    reduce_inner_loops(iter, dataptrs, strides, countptr, iternext,
+                        skip_first_count, innerloop, innerloopdata);
 
-finish_loop:
     if (!needs_api) {
         NPY_END_THREADS;
     }
@@ -2727,57 +3024,306 @@ masked_reduce_loop(NpyIter *iter, char **dataptrs, npy_intp *strides,
                 }
             }
 
-            /* Turn the two items into three for the inner loop */
-            dataptrs_copy[0] = dataptrs[0];
-            dataptrs_copy[1] = dataptrs[1];
-            dataptrs_copy[2] = dataptrs[0];
-            strides_copy[0] = strides[0];
-            strides_copy[1] = strides[1];
-            strides_copy[2] = strides[0];
-            /*
-             * If skipna=True, this masks based on the mask in 'arr',
-             * otherwise it masks based on the mask in 'result'
-             */
-            innerloop(dataptrs_copy, strides_copy,
-                        dataptrs[2], strides[2],
-                        count, innerloopdata);
+            /* Turn the two items into three for the inner loop */
+            dataptrs_copy[0] = dataptrs[0];
+            dataptrs_copy[1] = dataptrs[1];
+            dataptrs_copy[2] = dataptrs[0];
+            strides_copy[0] = strides[0];
+            strides_copy[1] = strides[1];
+            strides_copy[2] = strides[0];
+            /*
+             * If skipna=True, this masks based on the mask in 'arr',
+             * otherwise it masks based on the mask in 'result'
+             */
+            innerloop(dataptrs_copy, strides_copy,
+                        dataptrs[2], strides[2],
+                        count, innerloopdata);
+
+            /* Jump to the faster loop when skipping is done */
+            if (skip_first_count == 0) {
+                if (iternext(iter)) {
+                    break;
+                }
+                else {
+                    goto finish_loop;
+                }
+            }
+        } while (iternext(iter));
+    }
+    do {
+        /* Turn the two items into three for the inner loop */
+        dataptrs_copy[0] = dataptrs[0];
+        dataptrs_copy[1] = dataptrs[1];
+        dataptrs_copy[2] = dataptrs[0];
+        strides_copy[0] = strides[0];
+        strides_copy[1] = strides[1];
+        strides_copy[2] = strides[0];
+        /*
+         * If skipna=True, this masks based on the mask in 'arr',
+         * otherwise it masks based on the mask in 'result'
+         */
+        innerloop(dataptrs_copy, strides_copy,
+                    dataptrs[2], strides[2],
+                    *countptr, innerloopdata);
+    } while (iternext(iter));
+
+finish_loop:
+    if (!needs_api) {
+        NPY_END_THREADS;
+    }
+
+    NPY_AUXDATA_FREE(innerloopdata);
+
+    return (needs_api && PyErr_Occurred()) ? -1 : 0;
+}
+
+/*
+ * A threaded reduction splits the operand along one of the reduction
+ * axes. PyArray_ReduceWrapper sets up the reduction of each piece into
+ * its own slot of a temporary array, but with reduce_capture_loop as the
+ * loop, which only keeps a copy of the iterator. Those loops then run on
+ * the ufunc threads, and reducing the temporary array gives the result.
+ */
+typedef struct {
+    NpyIter *iter;
+    NpyIter_IterNextFunc *iternext;
+    npy_intp skip_first_count;
+} reduce_task;
+
+typedef struct {
+    reduce_task *tasks;
+    PyUFuncGenericFunction innerloop;
+    void *innerloopdata;
+} reduce_tasks;
+
+static int
+reduce_capture_loop(NpyIter *iter, char **NPY_UNUSED(dataptrs),
+            npy_intp *NPY_UNUSED(strides), npy_intp *NPY_UNUSED(countptr),
+            NpyIter_IterNextFunc *NPY_UNUSED(iternext),
+            int NPY_UNUSED(needs_api), npy_intp skip_first_count, void *data)
+{
+    reduce_task *task = (reduce_task *)data;
+
+    task->iter = NpyIter_Copy(iter);
+    task->skip_first_count = skip_first_count;
+    return (task->iter == NULL) ? -1 : 0;
+}
+
+static void
+reduce_task_run(void *arg, npy_intp itask)
+{
+    reduce_tasks *tasks = (reduce_tasks *)arg;
+    reduce_task *task = &tasks->tasks[itask];
+
+    if (task->iter != NULL) {
+        reduce_inner_loops(task->iter, NpyIter_GetDataPtrArray(task->iter),
+                            NpyIter_GetInnerStrideArray(task->iter),
+                            NpyIter_GetInnerLoopSizePtr(task->iter),
+                            task->iternext, task->skip_first_count,
+                            tasks->innerloop, tasks->innerloopdata);
+    }
+}
+
+/* A view of arr with the range [start, end) of axis 'axis' */
+static PyArrayObject *
+axis_range_view(PyArrayObject *arr, int axis, npy_intp start, npy_intp end,
+                    int flags)
+{
+    npy_intp shape[NPY_MAXDIMS];
+    PyArrayObject *ret;
+
+    memcpy(shape, PyArray_DIMS(arr), PyArray_NDIM(arr) * sizeof(npy_intp));
+    shape[axis] = end - start;
+
+    Py_INCREF(PyArray_DESCR(arr));
+    ret = (PyArrayObject *)PyArray_NewFromDescr(&PyArray_Type,
+                            PyArray_DESCR(arr),
+                            PyArray_NDIM(arr), shape, PyArray_STRIDES(arr),
+                            PyArray_BYTES(arr) +
+                                        start * PyArray_STRIDE(arr, axis),
+                            flags, NULL);
+    if (ret == NULL) {
+        return NULL;
+    }
+    Py_INCREF(arr);
+    if (PyArray_SetBaseObject(ret, (PyObject *)arr) < 0) {
+        Py_DECREF(ret);
+        return NULL;
+    }
+    return ret;
+}
+
+/*
+ * Does the reduction on the ufunc threads if it is large enough.
+ *
+ * Returns 1 and the result in *out_result if it did, 0 if the reduction
+ * should run serially, and -1 on error.
+ */
+static int
+threaded_reduce(PyUFuncObject *ufunc, PyArrayObject *arr, PyArrayObject *out,
+        npy_bool *axis_flags, PyArray_Descr *dtype, int reorderable,
+        int skipna, int keepdims,
+        PyArray_AssignReduceIdentityFunc *assign_identity,
+        int buffersize, char *ufunc_name, PyArrayObject **out_result)
+{
+    int idim, ndim = PyArray_NDIM(arr), split = -1, needs_api = 0;
+    npy_intp size = PyArray_SIZE(arr), outsize = 1, len, ntasks, itask;
+    npy_intp shape[NPY_MAXDIMS];
+    PyArray_Descr *dtypes[3], **iter_dtypes = NULL;
+    PyArrayObject *partial = NULL, *result = NULL, *op[2];
+    reduce_tasks tasks;
+
+    NPY_BEGIN_THREADS_DEF;
+
+    /* Only the reorderable reductions of plain arrays */
+    if (npy_ufunc_get_num_threads() < 2 || !reorderable ||
+            PyArray_HASMASKNA(arr) ||
+            (out != NULL && PyArray_HASMASKNA(out)) ||
+            PyDataType_REFCHK(dtype) ||
+            PyDataType_REFCHK(PyArray_DESCR(arr))) {
+        return 0;
+    }
+    /* An out overlapping arr is reduced serially, like the other loops */
+    op[0] = arr;
+    op[1] = out;
+    if (npy_ufunc_operands_overlap(op, 1, 2)) {
+        return 0;
+    }
+
+    /* Split the reduction axis which is outermost in memory */
+    for (idim = 0; idim < ndim; ++idim) {
+        if (!axis_flags[idim]) {
+            outsize *= PyArray_DIM(arr, idim);
+        }
+        else if (PyArray_DIM(arr, idim) > 1 && (split < 0 ||
+                    npy_fabs((double)PyArray_STRIDE(arr, idim)) >
+                    npy_fabs((double)PyArray_STRIDE(arr, split)))) {
+            split = idim;
+        }
+    }
+    if (split < 0) {
+        return 0;
+    }
+    len = PyArray_DIM(arr, split);
+    ntasks = npy_ufunc_num_tasks(size);
+    if (ntasks > len) {
+        ntasks = len;
+    }
+    /* The final reduction over the partial results has to be cheap */
+    if (ntasks * outsize > size / 8) {
+        ntasks = size / 8 / outsize;
+    }
+    if (ntasks < 2) {
+        return 0;
+    }
+
+    /* The partial results, with the split axis holding one per task */
+    for (idim = 0; idim < ndim; ++idim) {
+        shape[idim] = axis_flags[idim] ? 1 : PyArray_DIM(arr, idim);
+    }
+    shape[split] = ntasks;
+    Py_INCREF(dtype);
+    partial = (PyArrayObject *)PyArray_NewFromDescr(&PyArray_Type, dtype,
+                                    ndim, shape, NULL, NULL, 0, NULL);
+    if (partial == NULL) {
+        return -1;
+    }
+    tasks.tasks = (reduce_task *)PyArray_malloc(ntasks * sizeof(reduce_task));
+    if (tasks.tasks == NULL) {
+        Py_DECREF(partial);
+        PyErr_NoMemory();
+        return -1;
+    }
+    memset(tasks.tasks, 0, ntasks * sizeof(reduce_task));
+
+    for (itask = 0; itask < ntasks; ++itask) {
+        PyArrayObject *piece, *slot, *res;
+
+        piece = axis_range_view(arr, split, itask * len / ntasks,
+                                (itask + 1) * len / ntasks, 0);
+        slot = axis_range_view(partial, split, itask, itask + 1,
+                                NPY_ARRAY_WRITEABLE);
+        if (piece == NULL || slot == NULL) {
+            Py_XDECREF(piece);
+            Py_XDECREF(slot);
+            goto fail;
+        }
+        res = PyArray_ReduceWrapper(piece, slot, NULL, dtype, dtype,
+                                NPY_UNSAFE_CASTING,
+                                axis_flags, reorderable,
+                                skipna, NULL, 1, 0,
+                                assign_identity,
+                                reduce_capture_loop,
+                                NULL,
+                                NULL,
+                                &tasks.tasks[itask], buffersize, ufunc_name);
+        Py_DECREF(piece);
+        Py_DECREF(slot);
+        if (res == NULL) {
+            goto fail;
+        }
+        Py_DECREF(res);
+
+        if (tasks.tasks[itask].iter != NULL) {
+            iter_dtypes = NpyIter_GetDescrArray(tasks.tasks[itask].iter);
+            tasks.tasks[itask].iternext = NpyIter_GetIterNext(
+                                            tasks.tasks[itask].iter, NULL);
+            if (tasks.tasks[itask].iternext == NULL) {
+                goto fail;
+            }
+        }
+    }
+
+    /* All the pieces use the same inner loop */
+    if (iter_dtypes != NULL) {
+        dtypes[0] = iter_dtypes[0];
+        dtypes[1] = iter_dtypes[1];
+        dtypes[2] = iter_dtypes[0];
+        if (ufunc->legacy_inner_loop_selector(ufunc, dtypes,
+                        &tasks.innerloop, &tasks.innerloopdata,
+                        &needs_api) < 0) {
+            goto fail;
+        }
 
-            /* Jump to the faster loop when skipping is done */
-            if (skip_first_count == 0) {
-                if (iternext(iter)) {
-                    break;
-                }
-                else {
-                    goto finish_loop;
-                }
+        if (!needs_api) {
+            NPY_BEGIN_THREADS;
+            npy_ufunc_run_tasks(&reduce_task_run, &tasks, ntasks);
+            NPY_END_THREADS;
+        }
+        else {
+            for (itask = 0; itask < ntasks; ++itask) {
+                reduce_task_run(&tasks, itask);
             }
-        } while (iternext(iter));
+            if (PyErr_Occurred()) {
+                goto fail;
+            }
+        }
     }
-    do {
-        /* Turn the two items into three for the inner loop */
-        dataptrs_copy[0] = dataptrs[0];
-        dataptrs_copy[1] = dataptrs[1];
-        dataptrs_copy[2] = dataptrs[0];
-        strides_copy[0] = strides[0];
-        strides_copy[1] = strides[1];
-        strides_copy[2] = strides[0];
-        /*
-         * If skipna=True, this masks based on the mask in 'arr',
-         * otherwise it masks based on the mask in 'result'
-         */
-        innerloop(dataptrs_copy, strides_copy,
-                    dataptrs[2], strides[2],
-                    *countptr, innerloopdata);
-    } while (iternext(iter));
 
-finish_loop:
-    if (!needs_api) {
-        NPY_END_THREADS;
-    }
+    result = PyArray_ReduceWrapper(partial, out, NULL, dtype, dtype,
+                                NPY_UNSAFE_CASTING,
+                                axis_flags, reorderable,
+                                skipna, NULL, keepdims, 0,
+                                assign_identity,
+                                reduce_loop,
+                                masked_reduce_loop,
+                                NULL,
+                                ufunc, buffersize, ufunc_name);
 
-    NPY_AUXDATA_FREE(innerloopdata);
+fail:
+    for (itask = 0; itask < ntasks; ++itask) {
+        if (tasks.tasks[itask].iter != NULL) {
+            NpyIter_Deallocate(tasks.tasks[itask].iter);
+        }
+    }
+    PyArray_free(tasks.tasks);
+    Py_DECREF(partial);
 
-    return (needs_api && PyErr_Occurred()) ? -1 : 0;
+    if (result == NULL) {
+        return -1;
+    }
+    *out_result = result;
+    return 1;
 }
 
 /*
@@ -2859,7 +3405,11 @@ PyUFunc_Reduce(PyUFuncObject *ufunc, PyArrayObject *arr, PyArrayObject *out,
         return NULL;
     }
 
-    result = PyArray_ReduceWrapper(arr, out, NULL, dtype, dtype,
+    switch (threaded_reduce(ufunc, arr, out, axis_flags, dtype, reorderable,
+                            skipna, keepdims, assign_identity,
+                            buffersize, ufunc_name, &result)) {
+        case 0:
+            result = PyArray_ReduceWrapper(arr, out, NULL, dtype, dtype,
                                 NPY_UNSAFE_CASTING,
                                 axis_flags, reorderable,
                                 skipna, NULL, keepdims, 0,
@@ -2868,6 +3418,11 @@ PyUFunc_Reduce(PyUFuncObject *ufunc, PyArrayObject *arr, PyArrayObject *out,
                                 masked_reduce_loop,
                                 NULL,
                                 ufunc, buffersize, ufunc_name);
+            break;
+        case -1:
+            result = NULL;
+            break;
+    }
 
     Py_DECREF(dtype);
     Py_XDECREF(errobj);
@@ -3627,6 +4182,254 @@ fail:
 }
 
 
+/*
+ * Reduces the elements of the 1-d array arr which have the same label in
+ * labels, the result for label i is element i of the output. The labels
+ * must be non-negative and are validated here.
+ *
+ * Like the segments of reduceat, a run of consecutive elements with the
+ * same label is reduced with a single call of the inner loop, so for
+ * sorted labels every group takes one call. Labels without elements get
+ * the identity of the ufunc, or keep their value in out if it is given.
+ */
+static PyObject *
+PyUFunc_Reduceby(PyUFuncObject *ufunc, PyArrayObject *arr,
+                 PyArrayObject *labels, PyArrayObject *out,
+                 npy_intp minlength, int otype)
+{
+    PyArrayObject *values = NULL, *ret = NULL;
+    PyArray_Descr *op_dtype = NULL;
+    npy_intp *lab, nlab, nout, maxlab = -1, i, start, end;
+    npy_intp itemsize, stride;
+    npy_bool *seen = NULL;
+    int needs_api;
+
+    /* The selected inner loop */
+    PyUFuncGenericFunction innerloop = NULL;
+    void *innerloopdata = NULL;
+
+    char *ufunc_name = ufunc->name ? ufunc->name : "(unknown)";
+    char *opname = "reduceby";
+
+    NPY_BEGIN_THREADS_DEF;
+
+    nlab = PyArray_DIM(labels, 0);
+    if (PyArray_NDIM(arr) != 1 || PyArray_DIM(arr, 0) != nlab) {
+        PyErr_Format(PyExc_ValueError,
+                "%s.%s needs a 1-d array of the same length as labels",
+                ufunc_name, opname);
+        return NULL;
+    }
+    lab = (npy_intp *)PyArray_DATA(labels);
+    for (i = 0; i < nlab; ++i) {
+        if (lab[i] < 0) {
+            PyErr_Format(PyExc_ValueError,
+                    "negative label in %s.%s", ufunc_name, opname);
+            return NULL;
+        }
+        if (lab[i] > maxlab) {
+            maxlab = lab[i];
+        }
+    }
+
+    if (get_binary_op_function(ufunc, &otype,
+                                &innerloop, &innerloopdata) < 0) {
+        PyArray_Descr *dtype = PyArray_DescrFromType(otype);
+        PyErr_Format(PyExc_ValueError,
+                     "could not find a matching type for %s.%s, "
+                     "requested type has type code '%c'",
+                            ufunc_name, opname, dtype ? dtype->type : '-');
+        Py_XDECREF(dtype);
+        return NULL;
+    }
+
+    /* Keep the descriptor of arr, with its datetime unit, for its type */
+    if (PyArray_DESCR(arr)->type_num == otype) {
+        if (PyArray_ISNBO(PyArray_DESCR(arr)->byteorder)) {
+            op_dtype = PyArray_DESCR(arr);
+            Py_INCREF(op_dtype);
+        }
+        else {
+            op_dtype = PyArray_DescrNewByteorder(PyArray_DESCR(arr),
+                                                 NPY_NATIVE);
+        }
+    }
+    else {
+        op_dtype = PyArray_DescrFromType(otype);
+    }
+    if (op_dtype == NULL) {
+        return NULL;
+    }
+
+    Py_INCREF(op_dtype);
+    values = (PyArrayObject *)PyArray_FromArray(arr, op_dtype,
+                                NPY_ARRAY_ALIGNED | NPY_ARRAY_FORCECAST);
+    if (values == NULL) {
+        goto fail;
+    }
+
+    if (out != NULL) {
+        if (PyArray_NDIM(out) != 1 || PyArray_DIM(out, 0) <= maxlab) {
+            PyErr_Format(PyExc_ValueError,
+                    "out of %s.%s must be 1-d with an element for "
+                    "each label", ufunc_name, opname);
+            goto fail;
+        }
+        Py_INCREF(op_dtype);
+        ret = (PyArrayObject *)PyArray_FromArray(out, op_dtype,
+                                NPY_ARRAY_CARRAY | NPY_ARRAY_UPDATEIFCOPY |
+                                NPY_ARRAY_FORCECAST);
+        if (ret == NULL) {
+            goto fail;
+        }
+        nout = PyArray_DIM(ret, 0);
+    }
+    else {
+        nout = (maxlab < minlength) ? minlength : maxlab + 1;
+        Py_INCREF(op_dtype);
+        ret = (PyArrayObject *)PyArray_Zeros(1, &nout, op_dtype, 0);
+        if (ret == NULL) {
+            goto fail;
+        }
+        seen = (npy_bool *)PyArray_malloc(nout);
+        if (seen == NULL) {
+            PyErr_NoMemory();
+            goto fail;
+        }
+        memset(seen, 0, nout);
+    }
+
+    itemsize = PyArray_DESCR(ret)->elsize;
+    stride = PyArray_STRIDE(values, 0);
+    needs_api = PyDataType_REFCHK(PyArray_DESCR(ret));
+
+    if (!needs_api) {
+        NPY_BEGIN_THREADS;
+    }
+
+    for (start = 0; start < nlab; start = end) {
+        npy_intp label = lab[start], count;
+        char *dataptr[3];
+        npy_intp strides[3];
+
+        for (end = start + 1; end < nlab && lab[end] == label; ++end) {
+        }
+        count = end - start;
+
+        dataptr[0] = PyArray_BYTES(ret) + label * itemsize;
+        dataptr[1] = PyArray_BYTES(values) + start * stride;
+        dataptr[2] = dataptr[0];
+        strides[0] = 0;
+        strides[1] = stride;
+        strides[2] = 0;
+
+        /* Copy the first element to start the reduction */
+        if (seen != NULL && !seen[label]) {
+            seen[label] = 1;
+            if (otype == NPY_OBJECT) {
+                Py_XDECREF(*(PyObject **)dataptr[0]);
+                *(PyObject **)dataptr[0] = *(PyObject **)dataptr[1];
+                Py_XINCREF(*(PyObject **)dataptr[0]);
+            }
+            else {
+                memcpy(dataptr[0], dataptr[1], itemsize);
+            }
+            dataptr[1] += stride;
+            --count;
+        }
+        if (count > 0) {
+            innerloop(dataptr, &count, strides, innerloopdata);
+        }
+        if (needs_api && PyErr_Occurred()) {
+            goto fail;
+        }
+    }
+
+    if (!needs_api) {
+        NPY_END_THREADS;
+    }
+
+    /* The labels without elements */
+    if (seen != NULL) {
+        PyObject *identity = NULL;
+
+        for (i = 0; i < nout; ++i) {
+            if (seen[i]) {
+                continue;
+            }
+            if (identity == NULL) {
+                if (ufunc->identity == PyUFunc_Zero) {
+                    identity = PyInt_FromLong(0);
+                }
+                else if (ufunc->identity == PyUFunc_One) {
+                    identity = PyInt_FromLong(1);
+                }
+                else {
+                    PyErr_Format(PyExc_ValueError,
+                            "label %d has no elements, and %s has no "
+                            "identity for %s", (int)i, ufunc_name, opname);
+                    goto fail;
+                }
+                if (identity == NULL) {
+                    goto fail;
+                }
+            }
+            if (PyArray_SETITEM(ret, PyArray_BYTES(ret) + i * itemsize,
+                                identity) < 0) {
+                Py_DECREF(identity);
+                goto fail;
+            }
+        }
+        Py_XDECREF(identity);
+        PyArray_free(seen);
+    }
+    Py_DECREF(values);
+    Py_DECREF(op_dtype);
+
+    if (out != NULL) {
+        /* writes back a copy through UPDATEIFCOPY */
+        Py_DECREF(ret);
+        Py_INCREF(out);
+        return (PyObject *)out;
+    }
+    return (PyObject *)ret;
+
+fail:
+    PyArray_free(seen);
+    Py_XDECREF(values);
+    Py_XDECREF(ret);
+    Py_XDECREF(op_dtype);
+    return NULL;
+}
+
+/*
+ * The type of a reduction without a dtype or out parameter. For integer
+ * types make sure at least a long is used for add and multiply reduction
+ * to avoid overflow.
+ */
+static int
+reduction_default_type(PyUFuncObject *ufunc, PyArrayObject *mp)
+{
+    int typenum = PyArray_TYPE(mp);
+
+    if ((PyTypeNum_ISBOOL(typenum) || PyTypeNum_ISINTEGER(typenum))
+        && ((strcmp(ufunc->name,"add") == 0)
+            || (strcmp(ufunc->name,"multiply") == 0))) {
+        if (PyTypeNum_ISBOOL(typenum)) {
+            typenum = NPY_LONG;
+        }
+        else if ((size_t)PyArray_DESCR(mp)->elsize < sizeof(long)) {
+            if (PyTypeNum_ISUNSIGNED(typenum)) {
+                typenum = NPY_ULONG;
+            }
+            else {
+                typenum = NPY_LONG;
+            }
+        }
+    }
+    return typenum;
+}
+
 /*
  * This code handles reduce, reduceat, and accumulate
  * (accumulate and reduce are special cases of the more general reduceat
@@ -3859,27 +4662,7 @@ PyUFunc_GenericReduction(PyUFuncObject *ufunc, PyObject *args,
         Py_INCREF(otype);
     }
     if (otype == NULL) {
-        /*
-         * For integer types --- make sure at least a long
-         * is used for add and multiply reduction to avoid overflow
-         */
-        int typenum = PyArray_TYPE(mp);
-        if ((PyTypeNum_ISBOOL(typenum) || PyTypeNum_ISINTEGER(typenum))
-            && ((strcmp(ufunc->name,"add") == 0)
-                || (strcmp(ufunc->name,"multiply") == 0))) {
-            if (PyTypeNum_ISBOOL(typenum)) {
-                typenum = NPY_LONG;
-            }
-            else if ((size_t)PyArray_DESCR(mp)->elsize < sizeof(long)) {
-                if (PyTypeNum_ISUNSIGNED(typenum)) {
-                    typenum = NPY_ULONG;
-                }
-                else {
-                    typenum = NPY_LONG;
-                }
-            }
-        }
-        otype = PyArray_DescrFromType(typenum);
+        otype = PyArray_DescrFromType(reduction_default_type(ufunc, mp));
     }
 
 
@@ -4765,6 +5548,79 @@ ufunc_reduceat(PyUFuncObject *ufunc, PyObject *args, PyObject *kwds)
     return PyUFunc_GenericReduction(ufunc, args, kwds, UFUNC_REDUCEAT);
 }
 
+static PyObject *
+ufunc_reduceby(PyUFuncObject *ufunc, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"array", "labels", "minlength",
+                                "dtype", "out", NULL};
+    PyObject *op, *obj_labels, *ret;
+    PyArrayObject *mp, *labels;
+    PyArray_Descr *otype = NULL;
+    PyArrayObject *out = NULL;
+    Py_ssize_t minlength = 0;
+    int typenum;
+
+    if (ufunc->core_enabled) {
+        PyErr_Format(PyExc_RuntimeError,
+                     "Reduction not defined on ufunc with signature");
+        return NULL;
+    }
+    if (ufunc->nin != 2 || ufunc->nout != 1) {
+        PyErr_SetString(PyExc_ValueError,
+                     "reduceby only supported for binary functions "
+                     "returning a single value");
+        return NULL;
+    }
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|nO&O&", kwlist,
+                                    &op,
+                                    &obj_labels,
+                                    &minlength,
+                                    PyArray_DescrConverter2, &otype,
+                                    PyArray_OutputConverter, &out)) {
+        Py_XDECREF(otype);
+        return NULL;
+    }
+    mp = (PyArrayObject *)PyArray_FromAny(op, NULL, 1, 1, 0, NULL);
+    if (mp == NULL) {
+        Py_XDECREF(otype);
+        return NULL;
+    }
+    labels = (PyArrayObject *)PyArray_FromAny(obj_labels,
+                                PyArray_DescrFromType(NPY_INTP),
+                                1, 1, NPY_ARRAY_CARRAY, NULL);
+    if (labels == NULL) {
+        Py_XDECREF(otype);
+        Py_DECREF(mp);
+        return NULL;
+    }
+    if (PyArray_ISFLEXIBLE(mp) ||
+        (otype && PyTypeNum_ISFLEXIBLE(otype->type_num))) {
+        PyErr_SetString(PyExc_TypeError,
+                     "cannot perform reduceby with flexible type");
+        Py_XDECREF(otype);
+        Py_DECREF(mp);
+        Py_DECREF(labels);
+        return NULL;
+    }
+
+    /* If out is specified it determines otype unless that is given */
+    if (otype != NULL) {
+        typenum = otype->type_num;
+    }
+    else if (out != NULL) {
+        typenum = PyArray_TYPE(out);
+    }
+    else {
+        typenum = reduction_default_type(ufunc, mp);
+    }
+    Py_XDECREF(otype);
+
+    ret = PyUFunc_Reduceby(ufunc, mp, labels, out, minlength, typenum);
+    Py_DECREF(mp);
+    Py_DECREF(labels);
+    return ret;
+}
+
 
 static struct PyMethodDef ufunc_methods[] = {
     {"reduce",
@@ -4776,6 +5632,9 @@ static struct PyMethodDef ufunc_methods[] = {
     {"reduceat",
         (PyCFunction)ufunc_reduceat,
         METH_VARARGS | METH_KEYWORDS, NULL },
+    {"reduceby",
+        (PyCFunction)ufunc_reduceby,
+        METH_VARARGS | METH_KEYWORDS, NULL },
     {"outer",
         (PyCFunction)ufunc_outer,
         METH_VARARGS | METH_KEYWORDS, NULL},
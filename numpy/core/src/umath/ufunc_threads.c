@@ -0,0 +1,335 @@
+/*
+ * This file implements the thread pool used to split large ufunc loops
+ * and reductions over several cores.
+ *
+ * Threading is opt-in, numpy.setnumthreads sets the number of threads
+ * for the whole process and the default of 1 runs every loop in the
+ * calling thread as before. The workers are started on first use and then
+ * wait for work, only one thread at a time can hand out tasks to them,
+ * a concurrent caller just runs its tasks itself.
+ *
+ * See LICENSE.txt for the license.
+ */
+#define _UMATHMODULE
+#define NPY_NO_DEPRECATED_API NPY_API_VERSION
+
+#include "Python.h"
+
+#include "npy_config.h"
+#ifdef ENABLE_SEPARATE_COMPILATION
+#define PY_ARRAY_UNIQUE_SYMBOL _npy_umathmodule_ARRAY_API
+#define NO_IMPORT_ARRAY
+#endif
+
+#include "numpy/npy_3kcompat.h"
+
+#include "numpy/arrayobject.h"
+#include "numpy/ufuncobject.h"
+#include "numpy/npy_math.h"
+#include "ufunc_threads.h"
+
+#if NPY_ALLOW_THREADS && !defined(_WIN32)
+#define NPY_HAVE_UFUNC_THREADS
+#include <pthread.h>
+#endif
+
+/* Set by setnumthreads, only changed while holding the GIL */
+static int npy_ufunc_num_threads = 1;
+
+NPY_NO_EXPORT int
+npy_ufunc_get_num_threads(void)
+{
+    return npy_ufunc_num_threads;
+}
+
+NPY_NO_EXPORT npy_intp
+npy_ufunc_num_tasks(npy_intp size)
+{
+    npy_intp ntasks = size / NPY_UFUNC_THREAD_MIN_SIZE;
+
+    if (ntasks > npy_ufunc_num_threads) {
+        ntasks = npy_ufunc_num_threads;
+    }
+    return ntasks < 1 ? 1 : ntasks;
+}
+
+/* Raises the UFUNC_FPE_* flags in status in the calling thread */
+static void
+raise_fpe_status(int status)
+{
+    if (status & UFUNC_FPE_DIVIDEBYZERO) {
+        npy_set_floatstatus_divbyzero();
+    }
+    if (status & UFUNC_FPE_OVERFLOW) {
+        npy_set_floatstatus_overflow();
+    }
+    if (status & UFUNC_FPE_UNDERFLOW) {
+        npy_set_floatstatus_underflow();
+    }
+    if (status & UFUNC_FPE_INVALID) {
+        npy_set_floatstatus_invalid();
+    }
+}
+
+#ifdef NPY_HAVE_UFUNC_THREADS
+
+static struct {
+    /* protects all the fields below */
+    pthread_mutex_t lock;
+    /* signalled when tasks are handed out, and when all of them are done */
+    pthread_cond_t work;
+    pthread_cond_t done;
+    /* held by the thread whose tasks the pool is running */
+    pthread_mutex_t owner;
+    int nworkers;
+    npy_ufunc_task_func *func;
+    void *data;
+    npy_intp ntasks, next, pending;
+    /* the floating point exceptions raised by the tasks */
+    int fpe_status;
+} pool = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+          PTHREAD_COND_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+          0, NULL, NULL, 0, 0, 0, 0};
+
+/*
+ * Runs the next task, called and returning with pool.lock held.
+ * Reading the status clears it, so each task reports only its own
+ * exceptions.
+ */
+static void
+pool_run_next_task(void)
+{
+    npy_ufunc_task_func *func = pool.func;
+    void *data = pool.data;
+    npy_intp itask = pool.next++;
+    int status;
+
+    pthread_mutex_unlock(&pool.lock);
+    func(data, itask);
+    UFUNC_CHECK_STATUS(status);
+    pthread_mutex_lock(&pool.lock);
+
+    pool.fpe_status |= status;
+    if (--pool.pending == 0) {
+        pthread_cond_signal(&pool.done);
+    }
+}
+
+static void *
+pool_worker(void *NPY_UNUSED(arg))
+{
+    int status;
+
+    /* start from a clean floating point status */
+    UFUNC_CHECK_STATUS(status);
+    (void)status;
+    pthread_mutex_lock(&pool.lock);
+    for (;;) {
+        while (pool.next >= pool.ntasks) {
+            pthread_cond_wait(&pool.work, &pool.lock);
+        }
+        pool_run_next_task();
+    }
+    return NULL;
+}
+
+/*
+ * A forked child only has the thread which called fork, start over
+ * with no workers and unlocked mutexes.
+ */
+static void
+pool_atfork_child(void)
+{
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_mutex_init(&pool.owner, NULL);
+    pthread_cond_init(&pool.work, NULL);
+    pthread_cond_init(&pool.done, NULL);
+    pool.nworkers = 0;
+    pool.ntasks = pool.next = pool.pending = 0;
+}
+
+/* Starts workers up to n, called with pool.lock held */
+static void
+pool_start_workers(int n)
+{
+    static int atfork_registered = 0;
+    pthread_attr_t attr;
+
+    if (pool.nworkers >= n) {
+        return;
+    }
+    if (!atfork_registered) {
+        if (pthread_atfork(NULL, NULL, &pool_atfork_child) != 0) {
+            return;
+        }
+        atfork_registered = 1;
+    }
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    while (pool.nworkers < n) {
+        pthread_t thread;
+        if (pthread_create(&thread, &attr, &pool_worker, NULL) != 0) {
+            break;
+        }
+        pool.nworkers++;
+    }
+    pthread_attr_destroy(&attr);
+}
+
+#endif
+
+NPY_NO_EXPORT void
+npy_ufunc_run_tasks(npy_ufunc_task_func *func, void *data, npy_intp ntasks)
+{
+    npy_intp itask;
+
+#ifdef NPY_HAVE_UFUNC_THREADS
+    if (ntasks > 1 && pthread_mutex_trylock(&pool.owner) == 0) {
+        int nthreads = npy_ufunc_num_threads, status;
+
+        pthread_mutex_lock(&pool.lock);
+        pool_start_workers((ntasks < nthreads ? (int)ntasks : nthreads) - 1);
+        if (pool.nworkers > 0) {
+            pool.func = func;
+            pool.data = data;
+            pool.next = 0;
+            pool.ntasks = ntasks;
+            pool.pending = ntasks;
+            pool.fpe_status = 0;
+            pthread_cond_broadcast(&pool.work);
+
+            /* take part in the work, then wait for the rest */
+            while (pool.next < pool.ntasks) {
+                pool_run_next_task();
+            }
+            while (pool.pending > 0) {
+                pthread_cond_wait(&pool.done, &pool.lock);
+            }
+            status = pool.fpe_status;
+            pthread_mutex_unlock(&pool.lock);
+            pthread_mutex_unlock(&pool.owner);
+
+            raise_fpe_status(status);
+            return;
+        }
+        pthread_mutex_unlock(&pool.lock);
+        pthread_mutex_unlock(&pool.owner);
+    }
+#endif
+
+    for (itask = 0; itask < ntasks; ++itask) {
+        func(data, itask);
+    }
+}
+
+/* The range of bytes the elements of arr occupy */
+static void
+get_array_extents(PyArrayObject *arr, npy_uintp *out_start, npy_uintp *out_end)
+{
+    int idim, ndim = PyArray_NDIM(arr);
+    npy_intp *dims = PyArray_DIMS(arr), *strides = PyArray_STRIDES(arr);
+    npy_intp lower = 0, upper = 0;
+
+    for (idim = 0; idim < ndim; ++idim) {
+        if (dims[idim] == 0) {
+            *out_start = *out_end = (npy_uintp)PyArray_DATA(arr);
+            return;
+        }
+        if (strides[idim] > 0) {
+            upper += (dims[idim] - 1) * strides[idim];
+        }
+        else {
+            lower += (dims[idim] - 1) * strides[idim];
+        }
+    }
+    *out_start = (npy_uintp)PyArray_DATA(arr) + lower;
+    *out_end = (npy_uintp)PyArray_DATA(arr) + upper +
+               PyArray_DESCR(arr)->elsize;
+}
+
+static int
+arrays_identical(PyArrayObject *a, PyArrayObject *b)
+{
+    return PyArray_DATA(a) == PyArray_DATA(b) &&
+           PyArray_NDIM(a) == PyArray_NDIM(b) &&
+           PyArray_CompareLists(PyArray_DIMS(a), PyArray_DIMS(b),
+                                PyArray_NDIM(a)) &&
+           PyArray_CompareLists(PyArray_STRIDES(a), PyArray_STRIDES(b),
+                                PyArray_NDIM(a)) &&
+           PyArray_DESCR(a)->elsize == PyArray_DESCR(b)->elsize;
+}
+
+NPY_NO_EXPORT int
+npy_ufunc_operands_overlap(PyArrayObject **op, int nin, int nop)
+{
+    int iop, jop, idim;
+
+    for (iop = nin; iop < nop; ++iop) {
+        npy_uintp start1, end1;
+
+        if (op[iop] == NULL) {
+            continue;
+        }
+        /* an output which writes some elements more than once */
+        for (idim = 0; idim < PyArray_NDIM(op[iop]); ++idim) {
+            if (PyArray_STRIDE(op[iop], idim) == 0 &&
+                                PyArray_DIM(op[iop], idim) > 1) {
+                return 1;
+            }
+        }
+        get_array_extents(op[iop], &start1, &end1);
+        for (jop = 0; jop < nop; ++jop) {
+            npy_uintp start2, end2;
+
+            if (jop == iop || op[jop] == NULL ||
+                            arrays_identical(op[iop], op[jop])) {
+                continue;
+            }
+            get_array_extents(op[jop], &start2, &end2);
+            if (start1 < end2 && start2 < end1) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+static npy_ufunc_threads_api threads_api = {
+    &npy_ufunc_get_num_threads,
+    &npy_ufunc_run_tasks
+};
+
+NPY_NO_EXPORT PyObject *
+npy_ufunc_threads_capsule(void)
+{
+    return NpyCapsule_FromVoidPtr((void *)&threads_api, NULL);
+}
+
+NPY_NO_EXPORT PyObject *
+ufunc_setnumthreads(PyObject *NPY_UNUSED(dummy), PyObject *args)
+{
+    int nthreads, old = npy_ufunc_num_threads;
+
+    if (!PyArg_ParseTuple(args, "i", &nthreads)) {
+        return NULL;
+    }
+    if (nthreads < 1 || nthreads > NPY_UFUNC_MAX_THREADS) {
+        PyErr_Format(PyExc_ValueError,
+                "number of threads must be between 1 and %d",
+                NPY_UFUNC_MAX_THREADS);
+        return NULL;
+    }
+#ifdef NPY_HAVE_UFUNC_THREADS
+    npy_ufunc_num_threads = nthreads;
+#endif
+    return PyInt_FromLong(old);
+}
+
+NPY_NO_EXPORT PyObject *
+ufunc_getnumthreads(PyObject *NPY_UNUSED(dummy), PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return NULL;
+    }
+    return PyInt_FromLong(npy_ufunc_num_threads);
+}
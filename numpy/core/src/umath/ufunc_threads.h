@@ -0,0 +1,62 @@
+#ifndef _NPY_UMATH_UFUNC_THREADS_H_
+#define _NPY_UMATH_UFUNC_THREADS_H_
+
+#include "npy_threads.h"
+
+/*
+ * Below this many elements per thread a loop is not worth splitting,
+ * the time to wake up the workers dominates.
+ */
+#define NPY_UFUNC_THREAD_MIN_SIZE 32768
+
+/* Upper limit for the number of threads set by setnumthreads */
+#define NPY_UFUNC_MAX_THREADS 256
+
+
+/*
+ * The number of threads the ufunc loops may use, 1 if threading is
+ * disabled or not supported on this platform.
+ */
+NPY_NO_EXPORT int
+npy_ufunc_get_num_threads(void);
+
+/*
+ * Number of tasks to split 'size' elements into, at most the number of
+ * threads, so that each task gets at least NPY_UFUNC_THREAD_MIN_SIZE
+ * elements. Returns 1 if the loop should not be split.
+ */
+NPY_NO_EXPORT npy_intp
+npy_ufunc_num_tasks(npy_intp size);
+
+/*
+ * Runs func(data, itask) for itask in [0, ntasks) on the worker threads
+ * and the calling thread, and returns when all tasks are done. The
+ * floating point exceptions raised by the tasks are raised again in the
+ * calling thread. Must be called without holding the GIL, the tasks may
+ * not use the Python API.
+ */
+NPY_NO_EXPORT void
+npy_ufunc_run_tasks(npy_ufunc_task_func *func, void *data, npy_intp ntasks);
+
+/*
+ * Returns 1 if an output array may overlap with any other operand in
+ * a way that makes the result depend on the order of the iteration,
+ * outputs which are identical to an input are fine.
+ */
+NPY_NO_EXPORT int
+npy_ufunc_operands_overlap(PyArrayObject **op, int nin, int nop);
+
+/*
+ * Returns a new capsule holding the npy_ufunc_threads_api of the pool,
+ * for use by the other extension modules.
+ */
+NPY_NO_EXPORT PyObject *
+npy_ufunc_threads_capsule(void);
+
+NPY_NO_EXPORT PyObject *
+ufunc_setnumthreads(PyObject *NPY_UNUSED(dummy), PyObject *args);
+
+NPY_NO_EXPORT PyObject *
+ufunc_getnumthreads(PyObject *NPY_UNUSED(dummy), PyObject *args);
+
+#endif
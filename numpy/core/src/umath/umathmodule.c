@@ -40,6 +40,8 @@
 #include "loops.h"
 #include "ufunc_object.h"
 #include "ufunc_type_resolution.h"
+#include "ufunc_threads.h"
+#include "ufunc_evaluate.h"
 #include "__umath_generated.c"
 #include "__ufunc_api.c"
 
@@ -301,6 +303,15 @@ static struct PyMethodDef methods[] = {
     {"geterrobj",
         (PyCFunction) ufunc_geterr,
         METH_VARARGS, NULL},
+    {"setnumthreads",
+        (PyCFunction) ufunc_setnumthreads,
+        METH_VARARGS, NULL},
+    {"getnumthreads",
+        (PyCFunction) ufunc_getnumthreads,
+        METH_VARARGS, NULL},
+    {"_evaluate",
+        (PyCFunction) ufunc_evaluate,
+        METH_VARARGS, NULL},
     {NULL, NULL, 0, NULL}                /* sentinel */
 };
 
@@ -358,6 +369,9 @@ PyMODINIT_FUNC initumath(void)
     if (PyType_Ready(&PyUFunc_Type) < 0)
         return RETVAL;
 
+    /* Select the vectorized loops for this cpu */
+    npy_umath_init_simd();
+
     /* Add some symbolic constants to the module */
     d = PyModule_GetDict(m);
 
@@ -371,6 +385,16 @@ PyMODINIT_FUNC initumath(void)
         goto err;
     }
 
+    c_api = npy_ufunc_threads_capsule();
+    if (c_api == NULL) {
+        goto err;
+    }
+    PyDict_SetItemString(d, "_UFUNC_THREADS", c_api);
+    Py_DECREF(c_api);
+    if (PyErr_Occurred()) {
+        goto err;
+    }
+
     s = PyString_FromString("0.4.0");
     PyDict_SetItemString(d, "__version__", s);
     Py_DECREF(s);
@@ -2,4 +2,6 @@
 
 #include "ufunc_object.c"
 #include "ufunc_type_resolution.c"
+#include "ufunc_threads.c"
+#include "ufunc_evaluate.c"
 #include "umathmodule.c"
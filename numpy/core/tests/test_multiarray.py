@@ -74,6 +74,19 @@ class TestAttributes(TestCase):
         assert_equal(self.two.itemsize, self.two.dtype.itemsize)
         assert_equal(self.two.base, arange(20))
 
+    def test_set_shape_ndim(self):
+        # The dimensions move in and out of the array object
+        x = arange(64.)
+        for shape in [(2,)*6, (4, 16), (2,)*6, (64,)]:
+            x.shape = shape
+            assert_equal(x.shape, shape)
+            assert_equal(x.strides[-1], 8)
+            assert_equal(x.ravel(), arange(64.))
+        x = zeros((2, 3), dtype='f8')
+        x.dtype = dtype(('i1', (2, 2, 2)))
+        assert_equal(x.shape, (2, 3, 2, 2, 2))
+        assert_equal(x.strides, (24, 8, 4, 2, 1))
+
     def test_dtypeattr(self):
         assert_equal(self.one.dtype, dtype(int_))
         assert_equal(self.three.dtype, dtype(float_))
@@ -371,6 +384,182 @@ class TestCreation(TestCase):
         assert_(a.dtype == np.dtype(object))
         assert_raises(ValueError, np.array, [Fail()])
 
+    def test_zeros(self):
+        types = np.typecodes['All'].replace('O', '') + 'V'
+        for t in types:
+            d = np.dtype(t)
+            if d.itemsize == 0:
+                d = np.dtype((t, 4))
+            a = np.zeros((3, 5), dtype=d)
+            assert_equal(a.tostring(), asbytes('\0') * a.nbytes,
+                         err_msg=str(d))
+        a = np.zeros(3, dtype=[('x', 'f8'), ('y', object)])
+        assert_equal(a['y'].tolist(), [0, 0, 0])
+        # Buffers left dirty in the data cache are not handed out
+        old = np.setdatacache(1 << 22)
+        try:
+            a = np.ones(20000)
+            del a
+            b = np.zeros(20000)
+            assert_equal(b, 0)
+            assert_equal(np.datacachestats()['nblocks'], 1)
+        finally:
+            np.setdatacache(old)
+
+
+class TestDataCache(TestCase):
+    def setUp(self):
+        self.old = np.setdatacache(1 << 22)
+
+    def tearDown(self):
+        np.setdatacache(self.old)
+
+    def test_reuse(self):
+        a = np.arange(20000.)
+        del a
+        stats = np.datacachestats()
+        assert_equal(stats['nblocks'], 1)
+        assert_equal(stats['nbytes'], 160000)
+        # Buffers of the same and slightly smaller size classes are reused
+        for n in [20000, 18000, 15000]:
+            hits = np.datacachestats()['hits']
+            b = np.arange(float(n))
+            assert_equal(np.datacachestats()['hits'], hits + 1)
+            assert_equal(b, np.arange(float(n)))
+            del b
+        # Larger arrays and small ones are not served from the cache
+        hits = np.datacachestats()['hits']
+        b = np.empty(40000)
+        c = np.empty(1000)
+        assert_equal(np.datacachestats()['hits'], hits)
+
+    def test_limit(self):
+        arrays = [np.ones(100000) for i in range(10)]
+        del arrays
+        stats = np.datacachestats()
+        assert_(stats['nbytes'] <= 1 << 22)
+        assert_equal(stats['nblocks'], 5)
+        assert_(stats['evictions'] >= 5)
+        assert_equal(np.setdatacache(0), 1 << 22)
+        stats = np.datacachestats()
+        assert_equal(stats['nbytes'], 0)
+        assert_equal(stats['nblocks'], 0)
+        assert_equal(np.getdatacache(), 0)
+        assert_raises(ValueError, np.setdatacache, -1)
+
+    def test_object(self):
+        # Object arrays are cleared even when their buffer is reused
+        a = np.empty(20000, dtype=object)
+        a[...] = 1.5
+        del a
+        b = np.empty(20000, dtype=object)
+        assert_(all(x is None for x in b))
+
+
+class TestAllocPolicy(TestCase):
+    def setUp(self):
+        if sys.platform == 'win32':
+            raise SkipTest("no posix_memalign")
+        self.old = np.setallocpolicy()
+
+    def tearDown(self):
+        np.setallocpolicy(**self.old)
+
+    def test_align(self):
+        np.setallocpolicy(align=64)
+        for dt in ['b', 'i2', 'f8', 'c16', 'S3', object]:
+            for n in [0, 1, 7, 1000, 100000]:
+                a = np.zeros(n, dtype=dt)
+                assert_equal(a.ctypes.data % 64, 0)
+                assert_(a.flags.aligned)
+        # Views keep the alignment of their item
+        a = np.zeros(100, dtype='f8')
+        assert_(a[1:].flags.aligned)
+        assert_(not a.view('i1')[1:-7].view('f8').flags.aligned)
+
+    def test_cache(self):
+        old = np.setdatacache(1 << 22)
+        try:
+            np.setallocpolicy(align=0)
+            a = np.empty(20000)
+            unaligned = a.ctypes.data % 4096 != 0
+            del a
+            np.setallocpolicy(align=4096)
+            b = np.empty(20000)
+            assert_equal(b.ctypes.data % 4096, 0)
+            if unaligned:
+                assert_equal(np.datacachestats()['nblocks'], 1)
+        finally:
+            np.setdatacache(old)
+
+    def test_hugepages(self):
+        np.setallocpolicy(align=64, hugepage_min=1 << 22)
+        a = np.ones(1 << 19)
+        assert_equal(a.ctypes.data % (1 << 21), 0)
+        assert_equal(a.sum(), 1 << 19)
+        b = np.ones((1 << 19) - 1)
+        assert_equal(b.ctypes.data % 64, 0)
+
+    def test_context(self):
+        np.setallocpolicy(align=0, hugepage_min=0)
+        ctx = np.allocpolicy(align=128)
+        ctx.__enter__()
+        try:
+            assert_equal(np.getallocpolicy(),
+                         {'align': 128, 'hugepage_min': 0})
+            assert_equal(np.empty(3).ctypes.data % 128, 0)
+        finally:
+            ctx.__exit__(None, None, None)
+        assert_equal(np.getallocpolicy(), {'align': 0, 'hugepage_min': 0})
+
+    def test_invalid(self):
+        assert_raises(ValueError, np.setallocpolicy, align=48)
+        assert_raises(ValueError, np.setallocpolicy, align=2)
+        assert_raises(ValueError, np.setallocpolicy, align=1 << 22)
+        assert_raises(ValueError, np.setallocpolicy, hugepage_min=-1)
+        assert_equal(np.getallocpolicy(), self.old)
+
+
+class TestDataTrace(TestCase):
+    def setUp(self):
+        self.old = np.setdatatrace(True)
+
+    def tearDown(self):
+        np.setdatatrace(self.old)
+
+    def test_sites(self):
+        frame = sys._getframe()
+        a = np.empty(1000); site = (frame.f_code.co_filename, frame.f_lineno)
+        b = np.fromiter(iter(range(100)), dtype='f8')
+        stats = np.datatracestats()
+        assert_equal(stats['sites'][site], (1, 8000, 8000, 8000))
+        assert_(stats['current'] >= 8800)
+        del a
+        stats = np.datatracestats()
+        assert_equal(stats['sites'][site], (1, 8000, 0, 8000))
+        assert_(stats['peak'] >= stats['current'] + 8000)
+
+    def test_stop(self):
+        assert_equal(np.getdatahandler(), 'tracing_allocator')
+        a = np.arange(100.)
+        assert_(np.setdatatrace(False))
+        assert_equal(np.getdatahandler(), 'default_allocator')
+        # Buffers allocated while tracing are freed by the allocator below
+        current = np.datatracestats()['current']
+        del a
+        assert_equal(np.datatracestats()['current'], current - 800)
+        b = np.arange(100.)
+        assert_equal(np.datatracestats()['current'], current - 800)
+        np.setdatatrace(True)
+        assert_equal(np.datatracestats()['peak'], current - 800)
+
+    def test_resize(self):
+        a = np.zeros(10)
+        current = np.datatracestats()['current']
+        a.resize(1000)
+        assert_equal(np.datatracestats()['current'], current + 7920)
+        assert_equal(a[-10:], 0)
+
 
 class TestStructured(TestCase):
     def test_subarray_field_access(self):
@@ -492,7 +681,7 @@ class TestMethods(TestCase):
         # sort for small arrays.
         a = np.arange(100)
         b = a[::-1].copy()
-        for kind in ['q','m','h'] :
+        for kind in ['q','m','h','r'] :
             msg = "scalar sort, kind=%s" % kind
             c = a.copy();
             c.sort(kind=kind)
@@ -501,6 +690,23 @@ class TestMethods(TestCase):
             c.sort(kind=kind)
             assert_equal(c, a, msg)
 
+        # the radix sorts depend on the size and signedness of the type
+        rand = np.random.RandomState(1)
+        for dt in np.typecodes['AllInteger'] + '?':
+            x = rand.randint(-120, 120, 1000).astype(dt)
+            for kind in ['q','h','r'] :
+                msg = "integer sort, kind=%s, dtype=%s" % (kind, dt)
+                assert_equal(np.sort(x, kind=kind), np.sort(x, kind='m'), msg)
+
+        # the depth limit of quicksort guards against inputs which make
+        # the median of three pivot degenerate
+        x = np.zeros(10000, dtype=int)
+        k = len(x) // 2
+        x[0:k:2] = np.arange(1, k + 1, 2)
+        x[1:k:2] = k + np.arange(1, k + 1, 2)
+        x[k:] = 2 * np.arange(1, k + 1)
+        assert_equal(np.sort(x, kind='q'), np.sort(x, kind='m'))
+
         # test complex sorts. These use the same code as the scalars
         # but the compare fuction differs.
         ai = a*1j + 1
@@ -614,7 +820,7 @@ class TestMethods(TestCase):
         # sort for small arrays.
         a = np.arange(100)
         b = a[::-1].copy()
-        for kind in ['q','m','h'] :
+        for kind in ['q','m','h','r'] :
             msg = "scalar argsort, kind=%s" % kind
             assert_equal(a.copy().argsort(kind=kind), a, msg)
             assert_equal(b.copy().argsort(kind=kind), b, msg)
@@ -674,6 +880,14 @@ class TestMethods(TestCase):
         # scalars
         a = np.zeros(100)
         assert_equal(a.argsort(kind='m'), r)
+        # integers, also with unequal keys and the radix sort
+        a = np.zeros(100, dtype=np.int16)
+        assert_equal(a.argsort(kind='r'), r)
+        a = np.arange(1000) % 7 - 3
+        for dt in np.typecodes['AllInteger']:
+            msg = "stable argsort, dtype=%s" % dt
+            assert_equal(a.astype(dt).argsort(kind='r'),
+                         a.astype(dt).argsort(kind='m'), msg)
         # complex
         a = np.zeros(100, dtype=np.complex)
         assert_equal(a.argsort(kind='m'), r)
@@ -684,6 +898,98 @@ class TestMethods(TestCase):
         a = np.array(['aaaaaaaaa' for i in range(100)], dtype=np.unicode)
         assert_equal(a.argsort(kind='m'), r)
 
+    def assert_partitioned(self, d, kth):
+        # everything left of a kth is <= it, everything right of it >=
+        prev = 0
+        for k in np.sort(kth):
+            assert_((d[prev:k] <= d[k]).all(), msg="kth %d" % k)
+            assert_((d[k:] >= d[k]).all(), msg="kth %d" % k)
+            prev = k + 1
+
+    def test_partition(self):
+        # all numeric types against sort
+        rng = np.random.RandomState(1)
+        a = rng.randint(-50, 50, size=257)
+        for dt in np.typecodes['AllInteger'] + np.typecodes['AllFloat'] + '?':
+            d = a.astype(dt)
+            s = np.sort(d)
+            for k in [0, 1, 128, 255, 256, -1, -257]:
+                msg = "dtype %s, kth %d" % (dt, k)
+                p = np.partition(d, k)
+                assert_equal(p[k], s[k], msg)
+                assert_equal(np.sort(p), s, msg)
+                self.assert_partitioned(p, [k % d.size])
+            # several kth at once
+            p = np.partition(d, [3, 100, 101, -1])
+            assert_equal(p[[3, 100, 101, -1]], s[[3, 100, 101, -1]])
+            self.assert_partitioned(p, [3, 100, 101, 256])
+        # small arrays, duplicates and all equal elements
+        for n in range(1, 20):
+            d = np.arange(n)[::-1] // 2
+            for k in range(n):
+                assert_equal(np.partition(d, k)[k], np.sort(d)[k])
+            assert_equal(np.partition(np.ones(n), n // 2), np.ones(n))
+        # nans go to the end, as with sort
+        d = np.array([np.nan, 3, np.nan, 1, 2, 0])
+        assert_equal(np.partition(d, 2)[2], 2)
+        assert_(np.isnan(np.partition(d, 4)[4]))
+        # in place method
+        d = np.arange(10)[::-1].copy()
+        assert_(d.partition(5) is None)
+        assert_equal(d[5], 5)
+        self.assert_partitioned(d, [5])
+
+    def test_partition_median_of_medians(self):
+        # patterns which defeat the median of three pivots and force the
+        # switch to median of medians
+        n = 1000
+        for d in [np.arange(n)[::-1],
+                  np.tile(np.arange(n // 2), 2),
+                  np.arange(n) % 7,
+                  np.concatenate((np.arange(0, n, 2), np.arange(1, n, 2)))]:
+            s = np.sort(d)
+            for k in [0, 1, n // 3, n // 2, n - 2, n - 1]:
+                p = np.partition(d, k)
+                assert_equal(p[k], s[k])
+                self.assert_partitioned(p, [k])
+                ap = np.argpartition(d, k)
+                assert_equal(d[ap[k]], s[k])
+                self.assert_partitioned(d[ap], [k])
+
+    def test_partition_axis(self):
+        d = np.arange(60).reshape(3, 4, 5)[:, ::-1, ::-1]
+        for axis in [0, 1, 2, -1]:
+            p = np.partition(d, 1, axis=axis)
+            assert_equal(np.sort(p, axis=axis), np.sort(d, axis=axis))
+            assert_equal(p.take([1], axis=axis),
+                         np.sort(d, axis=axis).take([1], axis=axis))
+            ap = np.argpartition(d, 1, axis=axis)
+            assert_equal(ap.take([1], axis=axis),
+                         np.argsort(d, axis=axis).take([1], axis=axis))
+        assert_equal(np.partition(d, 30, axis=None)[30], 30)
+        # the methods flatten with axis=None alike
+        c = d.copy()
+        c.partition(30, axis=None)
+        assert_equal(c.ravel()[30], 30)
+        assert_equal(d.argpartition(30, axis=None).shape, (60,))
+        assert_raises(ValueError, d.partition, 30, axis=None)
+        # non numeric types are sorted
+        d = np.array(['c', 'a', 'd', 'b'])
+        assert_equal(np.partition(d, 1), ['a', 'b', 'c', 'd'])
+        assert_equal(np.argpartition(d, 1), [1, 3, 0, 2])
+        d = np.array([('b', 1), ('a', 2)], dtype=[('x', 'S1'), ('y', int)])
+        assert_equal(np.partition(d, 0, order='y')['y'], [1, 2])
+
+    def test_partition_errors(self):
+        d = np.arange(10)
+        assert_raises(ValueError, np.partition, d, 10)
+        assert_raises(ValueError, np.partition, d, -11)
+        assert_raises(ValueError, np.argpartition, d, [1, 10])
+        assert_raises(ValueError, d.partition, 1, kind='quicksort')
+        assert_raises(ValueError, np.array(1).partition, 0)
+        assert_raises(ValueError, np.partition, np.ones((2, 2)), 0, axis=2)
+        assert_raises(ValueError, np.partition, d, True)
+
     def test_searchsorted(self):
         # test for floats and complex containing nans. The logic is the
         # same for all float types so only test double types for now.
@@ -770,6 +1076,41 @@ class TestMethods(TestCase):
         assert_equal(a.searchsorted(k, side='l', sorter=s), [0, 20, 40, 60, 80])
         assert_equal(a.searchsorted(k, side='r', sorter=s), [20, 40, 60, 80, 100])
 
+    def test_searchsorted_types(self):
+        # the type specific searches against a search with python compares
+        def search(a, keys, side):
+            res = []
+            for k in keys:
+                if side == 'left':
+                    res.append(sum(1 for x in a if x < k))
+                else:
+                    res.append(sum(1 for x in a if x <= k))
+            return res
+
+        rng = np.random.RandomState(7)
+        for dt in np.typecodes['AllInteger'] + 'efdg?':
+            for n in [0, 1, 2, 5, 17, 64]:
+                a = np.sort((rng.randn(n) * 20).astype(dt))
+                k = (rng.randn(30) * 25).astype(dt)
+                for keys in [k, np.sort(k), a]:
+                    for side in ['left', 'right']:
+                        msg = "dtype %s, n %d, side %s" % (dt, n, side)
+                        r = search(a.tolist(), keys.tolist(), side)
+                        assert_equal(a.searchsorted(keys, side=side), r, msg)
+                        p = rng.permutation(n)
+                        assert_equal(a[p].searchsorted(keys, side=side,
+                                                       sorter=np.argsort(p)),
+                                     r, msg)
+
+    def test_searchsorted_sorted_keys(self):
+        # sorted keys are searched from the previous result
+        a = np.repeat(np.arange(0, 1000, 3), 3).astype(float)
+        a[-10:] = np.nan
+        keys = np.concatenate(([-1], np.arange(-1, 1001, 0.5), [np.nan]))
+        for side in ['left', 'right']:
+            unsorted = a.searchsorted(keys[::-1], side=side)[::-1]
+            assert_equal(a.searchsorted(keys, side=side), unsorted)
+
     def test_flatten(self):
         x0 = np.array([[1,2,3],[4,5,6]], np.int32)
         x1 = np.array([[[1,2],[3,4]],[[5,6],[7,8]]], np.int32)
@@ -841,6 +1182,79 @@ class TestMethods(TestCase):
         a.setasflat(b)
         assert_equal(a.ravel(), b.ravel())
 
+class TestSortLanes(TestCase):
+    """Sorts along any axis, with copied lanes and split over threads,
+    must give the results of the single threaded sort."""
+
+    def setUp(self):
+        self.oldthreads = np.setnumthreads(4)
+
+    def tearDown(self):
+        np.setnumthreads(self.oldthreads)
+
+    def _serial(self, func, *args, **kwargs):
+        np.setnumthreads(1)
+        try:
+            return func(*args, **kwargs)
+        finally:
+            np.setnumthreads(4)
+
+    def _check(self, a, axis, kind):
+        msg = "dtype %s, shape %s, axis %d, kind %s" % (a.dtype, a.shape,
+                                                         axis, kind)
+        s = self._serial(np.sort, a, axis=axis, kind=kind)
+        assert_equal(np.sort(a, axis=axis, kind=kind), s, msg)
+        i = np.argsort(a, axis=axis, kind=kind)
+        if kind == 'mergesort':
+            assert_equal(i, self._serial(np.argsort, a, axis=axis,
+                                         kind=kind), msg)
+        # the indices sort the lanes
+        j = np.ix_(*[np.arange(n) for n in a.shape])
+        j = j[:axis] + (i,) + j[axis + 1:]
+        assert_equal(a[j], s, msg)
+        if s.dtype.kind != 'c':
+            assert_((np.diff(s, axis=axis) >= 0).all(), msg)
+
+    def test_lanes(self):
+        rng = np.random.RandomState(3)
+        for dt in ['i2', '>i4', 'f8', '>f8', 'c8']:
+            for shape in [(400, 3), (3, 400), (20, 30, 40), (131072, 2)]:
+                a = (rng.randn(*shape) * 100).astype(dt)
+                for axis in range(a.ndim):
+                    for kind in ['quicksort', 'mergesort']:
+                        self._check(a, axis, kind)
+                self._check(a[::2], 0, 'mergesort')
+
+    def test_single_lane(self):
+        # a lane much longer than the others is split over the threads
+        rng = np.random.RandomState(4)
+        for dt in ['i8', 'f4', 'S4']:
+            a = rng.randint(0, 100, size=300001).astype(dt)
+            for kind in ['quicksort', 'mergesort', 'heapsort']:
+                if dt == 'S4' and kind != 'quicksort':
+                    continue
+                s = np.sort(a, kind=kind)
+                assert_(s.tolist() == sorted(a.tolist()))
+                i = np.argsort(a, kind=kind)
+                assert_(a[i].tolist() == s.tolist())
+            # the merges are stable
+            i = np.argsort(a[:, None], axis=0, kind='mergesort')
+            assert_equal(i, self._serial(np.argsort, a[:, None], axis=0,
+                                         kind='mergesort'))
+        a = rng.rand(2, 300001)
+        a[:, ::7] = np.nan
+        assert_equal(np.sort(a, axis=1), self._serial(np.sort, a, axis=1))
+
+    def test_partition(self):
+        rng = np.random.RandomState(5)
+        a = rng.rand(300, 1000)
+        for axis in [0, 1]:
+            p = np.partition(a, [10, 200], axis=axis)
+            s = self._serial(np.sort, a, axis=axis)
+            assert_equal(p.take([10, 200], axis=axis),
+                         s.take([10, 200], axis=axis))
+
+
 class TestSubscripting(TestCase):
     def test_test_zero_rank(self):
         x = array([1,2,3])
@@ -1560,6 +1974,14 @@ class TestResize(TestCase):
         assert_array_equal(x[0], np.eye(3))
         assert_array_equal(x[1], np.zeros((3,3)))
 
+    def test_many_dims(self):
+        x = np.arange(4.)
+        x.resize(2, 1, 2, 1, 1, 2)
+        assert_equal(x.strides, (32, 32, 16, 16, 16, 8))
+        assert_array_equal(x.ravel(), [0, 1, 2, 3, 0, 0, 0, 0])
+        x.resize(2, 2)
+        assert_array_equal(x, [[0, 1], [2, 3]])
+
 
 class TestRecord(TestCase):
     def test_field_rename(self):
@@ -1736,6 +2158,45 @@ class TestDot(TestCase):
         r = np.empty((1024, 32), dtype=int)
         assert_raises(ValueError, dot, f, v, r)
 
+    def test_dot_blocked(self):
+        # large float and complex products go through a blocked matrix
+        # multiplication, compare with the sums of the dotfunc
+        from numpy.core.multiarray import dot, inner
+
+        np.random.seed(3)
+        for dt in 'fdFD':
+            for m, k, n in [(3, 700, 5), (17, 33, 29), (130, 257, 70),
+                            (300, 5, 300), (1, 4100, 3)]:
+                a = np.random.randn(m, k) + np.random.randn(m, k)*1j
+                b = np.random.randn(k, n) + np.random.randn(k, n)*1j
+                if dt in 'fd':
+                    a, b = a.real, b.real
+                a, b = a.astype(dt), b.astype(dt)
+                r = np.array([[np.sum(x*y) for y in b.T] for x in a])
+                rtol = 1e-4 if dt in 'fF' else 1e-12
+                atol = rtol*k
+                assert_allclose(dot(a, b), r, rtol=rtol, atol=atol)
+                assert_allclose(dot(a.T.copy().T, b[::-1][::-1]), r,
+                                rtol=rtol, atol=atol)
+                assert_allclose(inner(a, b.T), r, rtol=rtol, atol=atol)
+        a = np.random.randn(3, 4, 20, 60)
+        b = np.random.randn(2, 60, 70)
+        assert_allclose(dot(a, b), np.einsum('abij,cjk->abick', a, b))
+        assert_allclose(inner(a, b.swapaxes(1, 2)), dot(a, b))
+
+    def test_dot_threads(self):
+        from numpy.core.multiarray import dot
+
+        a = np.random.randn(300, 200)
+        b = np.random.randn(200, 350) + 1j
+        r = dot(a, b)
+        old = np.setnumthreads(4)
+        try:
+            assert_array_equal(dot(a, b), r)
+            assert_array_equal(dot(b.T, a.T), r.T)
+        finally:
+            np.setnumthreads(old)
+
 
 class TestSummarization(TestCase):
     def test_1d(self):
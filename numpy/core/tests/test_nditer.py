@@ -1393,6 +1393,11 @@ def test_iter_remove_axis():
     i.remove_axis(0)
     assert_equal([x for x in i], a[0,:,:].ravel())
 
+    # An empty axis can't be removed
+    a = np.zeros((3,0))
+    i = nditer(a, ['multi_index','zerosize_ok'])
+    assert_raises(ValueError, i.remove_axis, 1)
+
 def test_iter_remove_multi_index_inner_loop():
     # Check that removing multi-index support works
 
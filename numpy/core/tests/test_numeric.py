@@ -1545,6 +1545,50 @@ class TestCorrelateNew(_TestCorrelate):
         z = np.correlate(y, x, 'full', old_behavior=self.old_behavior)
         assert_array_almost_equal(z, r_z)
 
+class TestFFTConvolve(TestCase):
+    """The FFT method must give the direct sums, up to rounding."""
+    def _check(self, a, v):
+        for mode in ('valid', 'same', 'full'):
+            for f in (np.convolve, np.correlate):
+                d = f(a, v, mode, method='direct')
+                z = f(a, v, mode, method='fft')
+                msg = "%s %s, %d %d" % (f.__name__, mode, len(a), len(v))
+                assert_equal(z.dtype, d.dtype, msg)
+                assert_equal(z.shape, d.shape, msg)
+                assert_almost_equal(z, d, err_msg=msg)
+
+    def test_lengths(self):
+        for n, m in [(1, 1), (5, 3), (3, 5), (10, 4), (4, 10), (7, 7),
+                     (300, 17), (17, 300), (2, 9)]:
+            self._check(rand(n), rand(m))
+
+    def test_complex(self):
+        for n, m in [(8, 3), (3, 8), (6, 6)]:
+            self._check(rand(n) + 1j*rand(n), rand(m) - 2j*rand(m))
+
+    def test_blocks(self):
+        # a short kernel splits the long sequence into blocks
+        a, v = rand(20000), rand(40)
+        assert_(np.core.numeric._fft_plan(20000, 40, np.inf) < 20039)
+        self._check(a, v)
+
+    def test_integer(self):
+        a, v = np.arange(1000) % 7, np.arange(50) % 5
+        assert_equal(np.convolve(a, v, method='fft'), np.convolve(a, v))
+        assert_equal(np.convolve(a, v, method='fft').dtype, a.dtype)
+
+    def test_auto(self):
+        a, v = rand(4000), rand(4000)
+        assert_almost_equal(np.convolve(a, v), np.convolve(a, v, 'full',
+                                                           'direct'))
+        assert_(np.core.numeric._fft_method(a[:10], v[:3], 2, 'auto')
+                is None)
+        assert_(np.core.numeric._fft_method(a, v, 2, 'auto') is not None)
+
+    def test_bad_method(self):
+        assert_raises(ValueError, np.convolve, [1, 2], [1], method='fast')
+        assert_raises(TypeError, np.convolve, [True], [False], method='fft')
+
 class TestArgwhere(object):
     def test_2D(self):
         x = np.arange(6).reshape((2, 3))
@@ -1570,5 +1614,78 @@ class TestStringFunction(object):
         np.set_string_function(None, repr=False)
         assert_equal(str(a), "[1]")
 
+class TestEvaluate(TestCase):
+    def test_arithmetic(self):
+        a, b, c = rand(3, 1000)
+        assert_almost_equal(np.evaluate("a*b + c*b - a/c"), a*b + c*b - a/c)
+        assert_almost_equal(np.evaluate("-a + abs(b - 1)**2"),
+                            -a + abs(b - 1)**2)
+        assert_almost_equal(np.evaluate("2*sin(a) + maximum(b, 0.5)"),
+                            2*np.sin(a) + np.maximum(b, 0.5))
+        assert_equal(np.evaluate("(a + b) * (a + b)"), (a + b) * (a + b))
+
+    def test_blocks(self):
+        # several blocks, a broadcast and a strided operand
+        a = rand(100, 37)
+        b = rand(37)
+        c = rand(100, 74)[:, ::2]
+        old = np.setbufsize(64)
+        try:
+            assert_almost_equal(np.evaluate("a*b + c*(a - b)"),
+                                a*b + c*(a - b))
+        finally:
+            np.setbufsize(old)
+
+    def test_threads(self):
+        a, b = rand(2, 100000)
+        old = np.setnumthreads(4)
+        try:
+            assert_almost_equal(np.evaluate("a*b - b/2"), a*b - b/2)
+        finally:
+            np.setnumthreads(old)
+
+    def test_dtype(self):
+        a = np.arange(10, dtype=np.float32)
+        i = np.arange(10)
+        assert_equal(np.evaluate("a*2 + 1").dtype, np.float32)
+        assert_equal(np.evaluate("i*3 + 1 & 6"), (i*3 + 1) & 6)
+        assert_equal(np.evaluate("i + a").dtype, np.float64)
+        assert_equal(np.evaluate("i + a", dtype=np.float32).dtype, np.float32)
+        assert_raises(TypeError, np.evaluate, "i + a", locals(), dtype=int)
+
+    def test_out(self):
+        a = np.arange(6.).reshape(2, 3)
+        out = np.zeros((2, 3))
+        assert_(np.evaluate("a*a + 1", out=out) is out)
+        assert_equal(out, a*a + 1)
+        np.evaluate("a + a*a", out=a)
+        assert_equal(a, out - 1 + np.arange(6.).reshape(2, 3))
+        assert_raises(ValueError, np.evaluate, "a + 1", locals(),
+                      out=np.zeros(4))
+
+    def test_names(self):
+        a = np.arange(4.)
+        assert_equal(np.evaluate("x + y", {'x': a, 'y': 1}), a + 1)
+        assert_equal(np.evaluate("a"), a)
+        assert_(type(np.evaluate("2.0 * 3")) is np.float64)
+        assert_raises(NameError, np.evaluate, "a + undefined_name", locals())
+        assert_raises(TypeError, np.evaluate, "modf(a)", locals())
+
+    def test_unsupported(self):
+        a, b = np.arange(4.), np.ones(4)
+        for ex in ["a < b", "a <= 1", "a > b", "2 >= a", "a == b", "a != b",
+                   "0 < a < 3"]:
+            assert_raises(TypeError, np.evaluate, ex, locals())
+        for ex in ["a and b", "a or b", "not a", "a + (b or 1)"]:
+            assert_raises(TypeError, np.evaluate, ex, locals())
+
+    def test_fperr(self):
+        a = np.zeros(3)
+        err = np.seterr(divide='raise')
+        try:
+            assert_raises(FloatingPointError, np.evaluate, "1/a", locals())
+        finally:
+            np.seterr(**err)
+
 if __name__ == "__main__":
     run_module_suite()
@@ -35,6 +35,25 @@ class TestTypes(TestCase):
                            "error with types (%d/'%c' + %d/'%c')" %
                             (k,np.dtype(atype).char,l,np.dtype(btype).char))
 
+    def test_reuse(self):
+        # Freed scalars are reused without keeping old values
+        for atype in types[1:] + [np.half]:
+            a = [atype(i) for i in range(100)]
+            del a
+            b = [atype(i) + atype(1) for i in range(100)]
+            assert_equal(b, range(1, 101))
+        for atype in [np.datetime64, np.timedelta64]:
+            a = [atype(i, 'D') for i in range(300)]
+            del a
+            assert_equal(atype(1, 's').dtype, np.dtype(atype.__name__ + '[s]'))
+
+        class MyDouble(np.double):
+            pass
+        a = [MyDouble(i) for i in range(300)]
+        a[0].attr = 1
+        del a
+        assert_equal(np.double(2.5) * 2, 5.0)
+
     def test_type_create(self, level=1):
         for k, atype in enumerate(types):
             a = np.array([1,2,3],atype)
@@ -21,6 +21,49 @@ class TestUfunc(TestCase):
         idx = np.array(zip(np.arange(L-2), np.arange(L-2)+2)).ravel()
         assert_array_equal(np.add.reduceat(x,idx)[::2], [1,3,5,7])
 
+    def test_reduceby(self):
+        a = np.array([5, 1, 4, 2, 8, 3, 7])
+        labels = np.array([3, 0, 3, 1, 0, 3, 1])
+        assert_equal(np.add.reduceby(a, labels), [9, 9, 0, 12])
+        assert_equal(np.add.reduceby(a, labels, minlength=6),
+                     [9, 9, 0, 12, 0, 0])
+        assert_equal(np.multiply.reduceby(a, labels), [8, 14, 1, 60])
+        assert_equal(np.maximum.reduceby(a, labels % 3), [8, 7])
+        assert_raises(ValueError, np.maximum.reduceby, a, labels)
+        assert_raises(ValueError, np.add.reduceby, a, -labels)
+        assert_raises(ValueError, np.add.reduceby, a, labels[:-1])
+        assert_raises(TypeError, np.add.reduceby, a, labels + 0.5)
+
+        out = np.repeat(np.inf, 5)
+        res = np.minimum.reduceby(a, labels, out=out)
+        assert_(res is out)
+        assert_equal(out, [1, 2, np.inf, 3, np.inf])
+        # out with a different type than the reduction
+        out = np.zeros(4, dtype=np.float32)
+        np.add.reduceby(a, labels, out=out)
+        assert_equal(out, [9, 9, 0, 12])
+
+        # timedeltas keep their unit
+        t = a.astype('m8[s]')
+        res = np.add.reduceby(t, labels)
+        assert_equal(res.dtype, np.dtype('m8[s]'))
+        assert_equal(res, np.array([9, 9, 0, 12], dtype='m8[s]'))
+        res = np.minimum.reduceby(t, labels % 3)
+        assert_equal(res, np.array([1, 2], dtype='m8[s]'))
+
+        # the same as a reduce over each label, sorted or not
+        rng = np.random.RandomState(1)
+        for dt in '?bBhHiIlLqQefdgFDGO':
+            a = rng.randint(0, 10, 200).astype(dt)
+            labels = rng.randint(0, 7, 200)
+            for lab in [labels, np.sort(labels)]:
+                for ufunc in [np.add, np.maximum]:
+                    res = ufunc.reduceby(a, lab)
+                    exp = [ufunc.reduce(a[lab == i]) for i in range(7)]
+                    assert_equal(res.dtype,
+                                 ufunc.reduce(a[:, None], axis=1).dtype)
+                    assert_equal(res, exp, err_msg=dt)
+
     def test_generic_loops(self) :
         """Test generic loops.
 
@@ -423,6 +466,16 @@ class TestUfunc(TestCase):
         w = np.arange(300,324).reshape((2,3,4))
         assert_array_equal(umt.innerwt(a,b,w), np.sum(a*b*w,axis=-1))
 
+    def test_zero_size_core(self):
+        # a zero-sized core dimension only of the inputs sums nothing
+        a = np.ones((2, 3, 0))
+        b = np.ones((2, 0, 4))
+        assert_array_equal(umt.matrix_multiply(a, b), np.zeros((2, 3, 4)))
+        assert_array_equal(umt.inner1d(a, a), np.zeros((2, 3)))
+        # and one of the outputs leaves nothing to compute
+        assert_equal(umt.matrix_multiply(b, np.ones((2, 4, 5))).shape,
+                     (2, 0, 5))
+
     def test_matrix_multiply(self):
         self.compare_matrix_multiply_results(np.long)
         self.compare_matrix_multiply_results(np.double)
@@ -652,6 +652,171 @@ class TestSign(TestCase):
             np.seterr(**olderr)
 
 
+def _strided(x):
+    """Copy of x which is not contiguous and so uses the scalar loops."""
+    y = np.empty(2*len(x), dtype=x.dtype)
+    y[::2] = x
+    return y[::2]
+
+
+def _raises_fpe(f, *args):
+    olderr = np.seterr(all='raise')
+    try:
+        try:
+            f(*args)
+        except FloatingPointError:
+            return True
+        return False
+    finally:
+        np.seterr(**olderr)
+
+
+class TestSIMDLoops(TestCase):
+    """The vectorized loops for contiguous, scalar broadcast and in place
+    operands must give the same results as the scalar loops."""
+
+    specials = [np.nan, -np.nan, np.inf, -np.inf, 0., -0., 1e-310, -1.]
+    sizes = list(range(1, 40)) + [255, 256, 257, 1023]
+
+    def _data(self, dt, n, offset):
+        x = np.empty(n + offset, dtype=dt)[offset:]
+        x[:] = np.linspace(-20, 20, n)
+        x[::7] = np.array(self.specials * (n//7 + 1), dtype=dt)[:len(x[::7])]
+        return x
+
+    def test_binary(self):
+        olderr = np.seterr(all='ignore')
+        try:
+            for dt in [np.float32, np.float64]:
+                for n in self.sizes:
+                    for offset in range(3):
+                        a = self._data(dt, n, offset)
+                        b = self._data(dt, n, 2 - offset)[::-1].copy()
+                        for f in [np.add, np.subtract, np.multiply,
+                                  np.divide, np.true_divide]:
+                            tgt = f(_strided(a), _strided(b))
+                            assert_equal(f(a, b), tgt)
+                            s = dt(3.5)
+                            assert_equal(f(a, s), f(_strided(a), s))
+                            assert_equal(f(s, b), f(s, _strided(b)))
+                            c = a.copy()
+                            f(c, b, out=c)
+                            assert_equal(c, tgt)
+        finally:
+            np.seterr(**olderr)
+
+    def test_unary(self):
+        olderr = np.seterr(all='ignore')
+        try:
+            for dt in [np.float32, np.float64]:
+                for n in self.sizes:
+                    for offset in range(3):
+                        a = self._data(dt, n, offset)
+                        for f in [np.sqrt, np.absolute, np.negative,
+                                  np.square, np.reciprocal]:
+                            tgt = f(_strided(a))
+                            res = f(a)
+                            assert_equal(res, tgt)
+                            assert_equal(np.signbit(res), np.signbit(tgt))
+                            f(a, out=a)
+                            assert_equal(a, tgt)
+        finally:
+            np.seterr(**olderr)
+
+    def test_overlap(self):
+        # partially overlapping operands must behave like the scalar loop
+        for dt in [np.float32, np.float64]:
+            for shift in [1, 3, 8, 17]:
+                a = np.arange(100, dtype=dt)
+                tgt = a.copy()
+                for i in range(len(tgt) - shift):
+                    tgt[i + shift] = tgt[i + shift] + tgt[i]
+                np.add(a[shift:], a[:-shift], out=a[shift:])
+                assert_equal(a, tgt)
+
+                a = np.arange(100, dtype=dt)
+                tgt = a.copy()
+                for i in range(len(tgt) - shift):
+                    tgt[i + shift] = -tgt[i]
+                np.negative(a[:-shift], out=a[shift:])
+                assert_equal(a, tgt)
+
+            # broadcast scalar which is part of the output
+            a = np.arange(1, 50, dtype=dt)
+            tgt = a.copy()
+            for i in range(len(tgt)):
+                tgt[i] = tgt[i] * tgt[5]
+            np.multiply(a, np.lib.stride_tricks.as_strided(a[5:], (49,), (0,)),
+                        out=a)
+            assert_equal(a, tgt)
+
+    def test_fpe(self):
+        # the floating point errors raised must not depend on the loop
+        for dt in [np.float32, np.float64]:
+            for pos in [0, 1, 5, 16, 33, 99]:
+                a = np.ones(100, dtype=dt)
+                b = np.ones(100, dtype=dt)
+                b[pos] = 0
+                assert_(_raises_fpe(np.divide, a, b))
+                assert_(_raises_fpe(np.divide, _strided(a), _strided(b)))
+                a[pos] = -1
+                assert_(_raises_fpe(np.sqrt, a))
+                assert_(_raises_fpe(np.sqrt, _strided(a)))
+                a[pos] = np.finfo(dt).max
+                assert_(_raises_fpe(np.multiply, a, dt(2)))
+                assert_(_raises_fpe(np.multiply, _strided(a), dt(2)))
+                a[pos] = np.nan
+                assert_equal(_raises_fpe(np.absolute, a),
+                             _raises_fpe(np.absolute, _strided(a)))
+                assert_equal(_raises_fpe(np.add, a, b),
+                             _raises_fpe(np.add, _strided(a), _strided(b)))
+            assert_(not _raises_fpe(np.add, np.ones(100, dtype=dt), dt(1)))
+
+    def test_reduce(self):
+        # pairwise sum and product and the vectorized maximum and minimum
+        # reductions must not depend on the memory layout
+        olderr = np.seterr(all='ignore')
+        try:
+            for dt in [np.float32, np.float64, np.longdouble]:
+                for n in self.sizes + [4097]:
+                    for offset in range(3):
+                        a = self._data(dt, n, offset)
+                        p = (1 + a / 1000).astype(dt)
+                        for f, x in [(np.add, a), (np.multiply, p),
+                                     (np.maximum, a), (np.minimum, a)]:
+                            assert_equal(f.reduce(x), f.reduce(_strided(x)))
+                            y = np.abs(x)
+                            assert_equal(f.reduce(y), f.reduce(_strided(y)))
+        finally:
+            np.seterr(**olderr)
+
+    def test_reduce_nan_zero(self):
+        # the first nan and the first signed zero are kept
+        for dt in [np.float32, np.float64]:
+            for n in [7, 64, 100, 1023]:
+                for pos in [0, n//2, n - 1]:
+                    a = np.arange(n, dtype=dt)
+                    a[pos] = np.nan
+                    assert_(np.isnan(np.maximum.reduce(a)))
+                    assert_(np.isnan(np.minimum.reduce(a)))
+                    assert_equal(_raises_fpe(np.maximum.reduce, a),
+                                 _raises_fpe(np.maximum.reduce, _strided(a)))
+                for sign in [1, -1]:
+                    z = np.zeros(n, dtype=dt) * -sign
+                    z[0] *= -1
+                    assert_equal(np.signbit(np.maximum.reduce(z)), sign < 0)
+                    assert_equal(np.signbit(np.minimum.reduce(z)), sign < 0)
+
+    def test_sum_accuracy(self):
+        # pairwise summation keeps the error of large float32 sums small
+        for n in [1000, 8000, 100000]:
+            for a in [np.ones(n, dtype=np.float32),
+                      _strided(np.ones(n, dtype=np.float32))]:
+                a *= np.float32(0.1)
+                tgt = np.float32(0.1) * np.float64(n)
+                assert_(abs(a.sum() - tgt) / tgt < 1e-6)
+
+
 class TestSpecialMethods(TestCase):
     def test_wrap(self):
         class with_wrap(object):
@@ -811,6 +976,78 @@ class TestSpecialMethods(TestCase):
         assert_equal(ncu.maximum(a, C()), 0)
 
 
+class TestThreads(TestCase):
+    """Loops split over several threads must give the results of the
+    single threaded loops."""
+
+    def setUp(self):
+        self.oldthreads = np.setnumthreads(4)
+
+    def tearDown(self):
+        np.setnumthreads(self.oldthreads)
+
+    def _serial(self, func, *args, **kwargs):
+        np.setnumthreads(1)
+        try:
+            return func(*args, **kwargs)
+        finally:
+            np.setnumthreads(4)
+
+    def test_elementwise(self):
+        a = np.linspace(-10, 10, 300001)
+        b = a[::-1].copy()
+        m = a[:300000].reshape(600, 500)
+        for func, args in [(np.add, (a, b)), (np.sin, (a,)),
+                           (np.multiply, (m, b[:500])),
+                           (np.add, (m.T, m.T)),
+                           (np.add, (a.astype(np.float32), b)),
+                           (np.less, (a, 1.5))]:
+            assert_equal(func(*args), self._serial(func, *args))
+
+    def test_reduce(self):
+        a = np.linspace(-10, 10, 600000).reshape(600, 1000)
+        for f in [np.maximum, np.minimum, np.add]:
+            for x, axis in [(a.ravel(), 0), (a, 0), (a, 1), (a.T, 0)]:
+                assert_almost_equal(f.reduce(x, axis=axis),
+                                    self._serial(f.reduce, x, axis=axis))
+        assert_equal(np.arange(10**6).sum(), 10**6 * (10**6 - 1) // 2)
+        assert_almost_equal(a.sum(axis=0, keepdims=True),
+                            self._serial(a.sum, axis=0, keepdims=True))
+        out = np.empty(1000)
+        np.add.reduce(a, axis=0, out=out)
+        assert_almost_equal(out, self._serial(a.sum, axis=0))
+
+    def test_fpe(self):
+        a = np.ones(10**6)
+        a[-3] = 0
+        olderr = np.seterr(divide='raise')
+        try:
+            assert_raises(FloatingPointError, np.divide, 1., a)
+        finally:
+            np.seterr(**olderr)
+
+    def test_overlap(self):
+        a = np.arange(10**6, dtype=float)
+        tgt = a.copy()
+        self._serial(np.add, tgt[1:], tgt[:-1], tgt[1:])
+        np.add(a[1:], a[:-1], a[1:])
+        assert_equal(a, tgt)
+        # a reduction into a part of its input
+        for axis, out in [(0, lambda d: d[0]), (1, lambda d: d[:, 0])]:
+            d = np.ones((1000, 2000))
+            tgt = np.ones((1000, 2000))
+            self._serial(np.add.reduce, tgt, axis=axis, out=out(tgt))
+            np.add.reduce(d, axis=axis, out=out(d))
+            assert_equal(d, tgt)
+
+    def test_setnumthreads(self):
+        assert_equal(np.getnumthreads(), 4)
+        assert_raises(ValueError, np.setnumthreads, 0)
+        assert_raises(ValueError, np.setnumthreads, 1000)
+        assert_equal(np.setnumthreads(2), 4)
+        assert_equal(np.getnumthreads(), 2)
+
+
 class TestChoose(TestCase):
     def test_mixed(self):
         c = np.array([True,True])
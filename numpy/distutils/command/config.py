@@ -15,7 +15,8 @@ from distutils.ccompiler import CompileError, LinkError
 import distutils
 from numpy.distutils.exec_command import exec_command
 from numpy.distutils.mingw32ccompiler import generate_manifest
-from numpy.distutils.command.autodist import check_inline, check_compiler_gcc4
+from numpy.distutils.command.autodist import check_inline, check_compiler_gcc4, \
+        check_gcc_function_attribute_with_intrinsics
 from numpy.distutils.compat import get_exception
 
 LANG_EXT['f77'] = '.f'
@@ -398,6 +399,13 @@ int main ()
         """Return True if the C compiler is gcc >= 4."""
         return check_compiler_gcc4(self)
 
+    def check_gcc_function_attribute_with_intrinsics(self, attribute, name,
+                                                     code, include):
+        """Return True if the C compiler accepts the function attribute and
+        the intrinsics in `code` inside a function declared with it."""
+        return check_gcc_function_attribute_with_intrinsics(self, attribute,
+                name, code, include)
+
     def get_output(self, body, headers=None, include_dirs=None,
                    libraries=None, library_dirs=None,
                    lang="c"):
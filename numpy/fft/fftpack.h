@@ -15,14 +15,48 @@ extern "C" {
 #define Treal float
 #endif
 
-extern void cfftf(int N, Treal data[], const Treal wrk[]);
-extern void cfftb(int N, Treal data[], const Treal wrk[]);
+/*
+ * The scratch space of cfftf, cfftb, rfftf and rfftb is the start of wrk,
+ * so a work array may only be used by one transform at a time.
+ */
+extern void cfftf(int N, Treal data[], Treal wrk[]);
+extern void cfftb(int N, Treal data[], Treal wrk[]);
 extern void cffti(int N, Treal wrk[]);
 
-extern void rfftf(int N, Treal data[], const Treal wrk[]);
-extern void rfftb(int N, Treal data[], const Treal wrk[]);
+extern void rfftf(int N, Treal data[], Treal wrk[]);
+extern void rfftb(int N, Treal data[], Treal wrk[]);
 extern void rffti(int N, Treal wrk[]);
 
+/*
+ * The same transforms with the scratch space ch, of the size of data, given
+ * apart. They only read wrk, which threads can then share.
+ */
+extern void cfftf_r(int N, Treal data[], Treal ch[], const Treal wrk[]);
+extern void cfftb_r(int N, Treal data[], Treal ch[], const Treal wrk[]);
+extern void rfftf_r(int N, Treal data[], Treal ch[], const Treal wrk[]);
+extern void rfftb_r(int N, Treal data[], Treal ch[], const Treal wrk[]);
+
+/*
+ * The number of sequences the batch transforms run at once, as the lanes
+ * of vectors where the compiler has vector extensions.
+ */
+#if (defined(__GNUC__) && (__GNUC__ > 4 || \
+        (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))) || defined(__clang__)
+#define FFTPACK_BATCH 2
+#else
+#define FFTPACK_BATCH 1
+#endif
+
+/*
+ * The _r transforms of FFTPACK_BATCH sequences of the same size, which are
+ * interleaved: item i of sequence j is data[i*FFTPACK_BATCH + j]. ch is
+ * the scratch space of the size of data.
+ */
+extern void cfftf_batch(int N, Treal data[], Treal ch[], const Treal wrk[]);
+extern void cfftb_batch(int N, Treal data[], Treal ch[], const Treal wrk[]);
+extern void rfftf_batch(int N, Treal data[], Treal ch[], const Treal wrk[]);
+extern void rfftb_batch(int N, Treal data[], Treal ch[], const Treal wrk[]);
+
 #ifdef __cplusplus
 }
 #endif
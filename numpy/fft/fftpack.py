@@ -31,17 +31,16 @@ version of the FFTPACK routines.
 
 """
 __all__ = ['fft','ifft', 'rfft', 'irfft', 'hfft', 'ihfft', 'rfftn',
-           'irfftn', 'rfft2', 'irfft2', 'fft2', 'ifft2', 'fftn', 'ifftn']
+           'irfftn', 'rfft2', 'irfft2', 'fft2', 'ifft2', 'fftn', 'ifftn',
+           'set_plan_cache_size']
 
-from numpy.core import asarray, zeros, swapaxes, shape, conjugate, \
-     take
+from numpy.core import asarray, shape, conjugate, take
 import fftpack_lite as fftpack
 
-_fft_cache = {}
-_real_fft_cache = {}
+# The kinds of transforms of fftpack.execute
+_FORWARD, _BACKWARD, _REAL_FORWARD, _REAL_BACKWARD = range(4)
 
-def _raw_fft(a, n=None, axis=-1, init_function=fftpack.cffti,
-             work_function=fftpack.cfftf, fft_cache = _fft_cache ):
+def _raw_fft(a, n=None, axis=-1, kind=_FORWARD):
     a = asarray(a)
 
     if n is None:
@@ -50,32 +49,30 @@ def _raw_fft(a, n=None, axis=-1, init_function=fftpack.cffti,
     if n < 1:
         raise ValueError("Invalid number of FFT data points (%d) specified." % n)
 
-    try:
-        wsave = fft_cache[n]
-    except(KeyError):
-        wsave = init_function(n)
-        fft_cache[n] = wsave
-
-    if a.shape[axis] != n:
-        s = list(a.shape)
-        if s[axis] > n:
-            index = [slice(None)]*len(s)
-            index[axis] = slice(0,n)
-            a = a[index]
-        else:
-            index = [slice(None)]*len(s)
-            index[axis] = slice(0,s[axis])
-            s[axis] = n
-            z = zeros(s, a.dtype.char)
-            z[index] = a
-            a = z
+    # fftpack crops or pads the lanes, and transforms them all in C
+    return fftpack.execute(a, n, axis, kind)
+
+
+def set_plan_cache_size(nbytes):
+    """
+    Limit the memory used to cache the setup of the transforms.
+
+    The FFTs keep the factors of their recent sizes, up to `nbytes`,
+    dropping the least recently used ones first. The default limit is
+    64 MB.
+
+    Parameters
+    ----------
+    nbytes : int
+        The most bytes the cache may use, 0 disables it.
+
+    Returns
+    -------
+    old : int
+        The previous limit.
 
-    if axis != -1:
-        a = swapaxes(a, axis, -1)
-    r = work_function(a, wsave)
-    if axis != -1:
-        r = swapaxes(r, axis, -1)
-    return r
+    """
+    return fftpack.set_cache_size(nbytes)
 
 
 def fft(a, n=None, axis=-1):
@@ -124,7 +121,10 @@ def fft(a, n=None, axis=-1):
     FFT (Fast Fourier Transform) refers to a way the discrete Fourier
     Transform (DFT) can be calculated efficiently, by using symmetries in the
     calculated terms.  The symmetry is highest when `n` is a power of 2, and
-    the transform is therefore most efficient for these sizes.
+    the transform is therefore most efficient for these sizes.  Lengths with
+    a large prime factor are transformed with Bluestein's algorithm [BL]_,
+    as a convolution computed with transforms of a longer length whose
+    factors are small, so that they also take O(n log(n)) time.
 
     The DFT is defined, with the conventions used in this implementation, in
     the documentation for the `numpy.fft` module.
@@ -134,6 +134,9 @@ def fft(a, n=None, axis=-1):
     .. [CT] Cooley, James W., and John W. Tukey, 1965, "An algorithm for the
             machine calculation of complex Fourier series," *Math. Comput.*
             19: 297-301.
+    .. [BL] Bluestein, Leo I., 1970, "A linear filtering approach to the
+            computation of discrete Fourier transform," *IEEE Transactions
+            on Audio and Electroacoustics* 18: 451-455.
 
     Examples
     --------
@@ -161,7 +164,7 @@ def fft(a, n=None, axis=-1):
 
     """
 
-    return _raw_fft(a, n, axis, fftpack.cffti, fftpack.cfftf, _fft_cache)
+    return _raw_fft(a, n, axis, _FORWARD)
 
 
 def ifft(a, n=None, axis=-1):
@@ -242,7 +245,7 @@ def ifft(a, n=None, axis=-1):
     a = asarray(a).astype(complex)
     if n is None:
         n = shape(a)[axis]
-    return _raw_fft(a, n, axis, fftpack.cffti, fftpack.cfftb, _fft_cache) / n
+    return _raw_fft(a, n, axis, _BACKWARD) / n
 
 
 def rfft(a, n=None, axis=-1):
@@ -319,7 +322,7 @@ def rfft(a, n=None, axis=-1):
     """
 
     a = asarray(a).astype(float)
-    return _raw_fft(a, n, axis, fftpack.rffti, fftpack.rfftf, _real_fft_cache)
+    return _raw_fft(a, n, axis, _REAL_FORWARD)
 
 
 def irfft(a, n=None, axis=-1):
@@ -402,8 +405,7 @@ def irfft(a, n=None, axis=-1):
     a = asarray(a).astype(complex)
     if n is None:
         n = (shape(a)[axis] - 1) * 2
-    return _raw_fft(a, n, axis, fftpack.rffti, fftpack.rfftb,
-                    _real_fft_cache) / n
+    return _raw_fft(a, n, axis, _REAL_BACKWARD) / n
 
 
 def hfft(a, n=None, axis=-1):
@@ -3,6 +3,9 @@
 #include "fftpack.h"
 #include "Python.h"
 #include "numpy/arrayobject.h"
+#include "numpy/npy_3kcompat.h"
+#include "numpy/npy_math.h"
+#include "npy_threads.h"
 
 static PyObject *ErrorObject;
 
@@ -292,6 +295,759 @@ fftpack_rffti(PyObject *NPY_UNUSED(self), PyObject *args)
 }
 
 
+/*
+ * The plans of the transforms, the work arrays of cffti and rffti, are kept
+ * in a cache of the most recently used ones, up to a number of bytes. The
+ * cache is only used with the GIL held, and the transforms which run
+ * without it hold a reference to their plan, so that an eviction by
+ * another thread frees it only once they are done.
+ *
+ * Lengths with a large prime factor use Bluestein's algorithm instead,
+ * which computes the transform as a convolution with a chirp through
+ * transforms of a length m >= 2*n - 1 with the factors 2, 3 and 5 only.
+ * Their plan holds the plan of that length in sub, and in wsave the chirp
+ * exp(i*pi*k**2/n) for k < n and the transform of the chirp, divided by m,
+ * which is the other operand of the convolution. It serves both the real
+ * and the complex transforms.
+ */
+typedef struct fft_plan {
+    struct fft_plan *prev, *next;
+    npy_intp n;
+    int real;
+    /* the transforms using it, and whether it is still in the cache */
+    int refcount, cached;
+    npy_intp nbytes;
+    struct fft_plan *sub;
+    double wsave[1];
+} fft_plan;
+
+/*
+ * Lengths with a prime factor above this use Bluestein's algorithm, the
+ * passes of fftpack take time proportional to the factors.
+ */
+#define FFT_BLUESTEIN_MIN_FACTOR 50
+
+/* the most recently used plan is the head */
+static fft_plan *plan_head = NULL, *plan_tail = NULL;
+static npy_intp plan_cache_bytes = 0;
+static npy_intp plan_cache_limit = 64 << 20;
+
+static void
+plan_unlink(fft_plan *plan)
+{
+    if (plan->prev != NULL) {
+        plan->prev->next = plan->next;
+    }
+    else {
+        plan_head = plan->next;
+    }
+    if (plan->next != NULL) {
+        plan->next->prev = plan->prev;
+    }
+    else {
+        plan_tail = plan->prev;
+    }
+    plan->prev = plan->next = NULL;
+}
+
+static void
+plan_push(fft_plan *plan)
+{
+    plan->prev = NULL;
+    plan->next = plan_head;
+    if (plan_head != NULL) {
+        plan_head->prev = plan;
+    }
+    else {
+        plan_tail = plan;
+    }
+    plan_head = plan;
+}
+
+static void
+plan_release(fft_plan *plan)
+{
+    if (--plan->refcount == 0 && !plan->cached) {
+        if (plan->sub != NULL) {
+            plan_release(plan->sub);
+        }
+        PyArray_free(plan);
+    }
+}
+
+/* Whether n has a prime factor above FFT_BLUESTEIN_MIN_FACTOR */
+static int
+fft_use_bluestein(npy_intp n)
+{
+    npy_intp p;
+
+    for (p = 2; p <= FFT_BLUESTEIN_MIN_FACTOR && p*p <= n; p++) {
+        while (n % p == 0) {
+            n /= p;
+        }
+    }
+    return n > FFT_BLUESTEIN_MIN_FACTOR;
+}
+
+/* The smallest length of at least n with the factors 2, 3 and 5 only */
+static npy_intp
+fft_good_size(npy_intp n)
+{
+    npy_intp best = 2*n, p5, p35, m;
+
+    for (p5 = 1; p5 < best; p5 *= 5) {
+        for (p35 = p5; p35 < best; p35 *= 3) {
+            for (m = p35; m < n; m *= 2) {
+                ;
+            }
+            if (m < best) {
+                best = m;
+            }
+        }
+    }
+    return best;
+}
+
+static fft_plan *
+plan_acquire(npy_intp n, int real);
+
+/*
+ * Sets up the chirp and its transform in the plan of Bluestein's algorithm,
+ * whose sub plan is set.
+ */
+static int
+plan_bluestein(fft_plan *plan)
+{
+    npy_intp k, n = plan->n, m = plan->sub->n;
+    double *chirp = plan->wsave, *b = plan->wsave + 2*n, *ch;
+
+    ch = PyArray_malloc(2*m*sizeof(double));
+    if (ch == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (k = 0; k < n; k++) {
+        /* k**2 modulo 2*n keeps the angle accurate */
+        double angle = NPY_PI*(double)((npy_uint64)k*k % (2*n)) / n;
+
+        chirp[2*k] = cos(angle);
+        chirp[2*k + 1] = sin(angle);
+    }
+    /* the chirp at -(n - 1) ... n - 1, wrapped around m */
+    memset(b, 0, 2*m*sizeof(double));
+    for (k = 0; k < n; k++) {
+        b[2*k] = chirp[2*k] / m;
+        b[2*k + 1] = chirp[2*k + 1] / m;
+        if (k > 0) {
+            b[2*(m - k)] = b[2*k];
+            b[2*(m - k) + 1] = b[2*k + 1];
+        }
+    }
+    cfftf_r((int)m, b, ch, plan->sub->wsave);
+    PyArray_free(ch);
+    return 0;
+}
+
+/* Drops the least recently used plans above the limit */
+static void
+plan_evict(void)
+{
+    while (plan_tail != NULL && plan_cache_bytes > plan_cache_limit) {
+        fft_plan *plan = plan_tail;
+
+        plan_unlink(plan);
+        plan_cache_bytes -= plan->nbytes;
+        plan->cached = 0;
+        plan->refcount++;
+        plan_release(plan);
+    }
+}
+
+/* Returns a new reference to the plan of a transform, the GIL is held */
+static fft_plan *
+plan_acquire(npy_intp n, int real)
+{
+    fft_plan *plan, *sub = NULL;
+    npy_intp nwork = real ? 2*n + 15 : 4*n + 15;
+    int bluestein = n > FFT_BLUESTEIN_MIN_FACTOR && fft_use_bluestein(n);
+
+    if (bluestein) {
+        real = 0;
+    }
+    for (plan = plan_head; plan != NULL; plan = plan->next) {
+        if (plan->n == n && plan->real == real) {
+            plan_unlink(plan);
+            plan_push(plan);
+            plan->refcount++;
+            return plan;
+        }
+    }
+    if (n > NPY_MAX_INT) {
+        PyErr_SetString(PyExc_ValueError, "the FFT size is too large");
+        return NULL;
+    }
+    if (bluestein) {
+        sub = plan_acquire(fft_good_size(2*n - 1), 0);
+        if (sub == NULL) {
+            return NULL;
+        }
+        nwork = 2*n + 2*sub->n;
+    }
+    plan = PyArray_malloc(sizeof(fft_plan) + nwork*sizeof(double));
+    if (plan == NULL) {
+        if (sub != NULL) {
+            plan_release(sub);
+        }
+        PyErr_NoMemory();
+        return NULL;
+    }
+    plan->n = n;
+    plan->real = real;
+    plan->refcount = 1;
+    plan->cached = 0;
+    plan->nbytes = sizeof(fft_plan) + nwork*sizeof(double);
+    plan->sub = sub;
+    if (bluestein) {
+        if (plan_bluestein(plan) < 0) {
+            plan_release(plan);
+            return NULL;
+        }
+    }
+    else if (real) {
+        rffti((int)n, plan->wsave);
+    }
+    else {
+        cffti((int)n, plan->wsave);
+    }
+    /* a plan above the limit, any with a limit of 0, is not cached */
+    if (plan->nbytes <= plan_cache_limit) {
+        plan->cached = 1;
+        plan_push(plan);
+        plan_cache_bytes += plan->nbytes;
+        plan_evict();
+    }
+    return plan;
+}
+
+static char fftpack_set_cache_size__doc__[] =
+    "set_cache_size(nbytes)\n\n"
+    "Limit the memory of the cached FFT plans to nbytes, 0 disables the\n"
+    "cache, and return the previous limit.";
+
+static PyObject *
+fftpack_set_cache_size(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    npy_intp old = plan_cache_limit, limit;
+
+    if (!PyArg_ParseTuple(args, "n", &limit)) {
+        return NULL;
+    }
+    if (limit < 0) {
+        PyErr_SetString(PyExc_ValueError, "the cache size must be >= 0");
+        return NULL;
+    }
+    plan_cache_limit = limit;
+    plan_evict();
+    return Py_BuildValue("n", old);
+}
+
+static char fftpack_cache_info__doc__[] =
+    "cache_info()\n\n"
+    "Return the number of cached FFT plans, their bytes and the limit.";
+
+static PyObject *
+fftpack_cache_info(PyObject *NPY_UNUSED(self), PyObject *NPY_UNUSED(args))
+{
+    fft_plan *plan;
+    npy_intp count = 0;
+
+    for (plan = plan_head; plan != NULL; plan = plan->next) {
+        count++;
+    }
+    return Py_BuildValue("nnn", count, plan_cache_bytes, plan_cache_limit);
+}
+
+/* The transforms of execute */
+enum {
+    FFT_FORWARD,
+    FFT_BACKWARD,
+    FFT_REAL_FORWARD,
+    FFT_REAL_BACKWARD
+};
+
+/* The fewest points per task for splitting a batch over the threads */
+#define FFT_THREAD_MIN_POINTS (1 << 15)
+/* The points of the lanes which are gathered together from an outer axis */
+#define FFT_TILE_POINTS (1 << 14)
+#define FFT_MAX_TILE 16
+
+typedef struct {
+    int kind;
+    fft_plan *plan;
+    /* the number of points of the transform, of an input and output lane */
+    npy_intp n, nin, nout;
+    char *indata, *outdata;
+    npy_intp instride, outstride;
+    /* the offsets of the lanes */
+    npy_intp nlanes, *inoffsets, *outoffsets;
+    npy_intp chunk;
+    /* the lanes read together, and the scratch space of a lane */
+    npy_intp tile, worksize;
+    double *work;
+} fft_batch;
+
+/*
+ * Copies count items of nd doubles to dst, taking them from lane p of the
+ * v interleaved lanes at src.
+ */
+static void
+fft_scatter(char *dst, const double *src, npy_intp count, npy_intp stride,
+            int nd, int v, int p)
+{
+    npy_intp i;
+    int itemsize = nd*sizeof(double);
+
+    if (v == 1 && stride == itemsize) {
+        memcpy(dst, src, count*itemsize);
+        return;
+    }
+    src += p;
+    for (i = 0; i < count; i++, dst += stride, src += nd*v) {
+        ((double *)dst)[0] = src[0];
+        if (nd == 2) {
+            ((double *)dst)[1] = src[v];
+        }
+    }
+}
+
+/*
+ * Transforms the v interleaved lanes at w with Bluestein's algorithm, the
+ * input and output are those of the transforms of fftpack. The convolution
+ * uses the space of 4*m*v doubles at a.
+ */
+static void
+fft_bluestein(const fft_plan *plan, int kind, double *w, double *a, int v)
+{
+    npy_intp j, k, n = plan->n, m = plan->sub->n, nout;
+    const double *chirp = plan->wsave, *b = plan->wsave + 2*n;
+    double *ch = a + 2*m*v;
+    /* the backward transform conjugates the input and the output */
+    double sign = (kind == FFT_BACKWARD || kind == FFT_REAL_BACKWARD) ?
+                  -1.0 : 1.0;
+    int p;
+
+    for (j = 0; j < n; j++) {
+        double c = chirp[2*j], s = chirp[2*j + 1];
+
+        for (p = 0; p < v; p++) {
+            double xr, xi;
+
+            if (kind == FFT_REAL_FORWARD) {
+                xr = w[(1 + j)*v + p];
+                xi = 0.0;
+            }
+            else if (kind == FFT_REAL_BACKWARD) {
+                /* the other half of a hermitian input, whose imaginary
+                 * parts at 0 and n/2 are ignored like by rfftb */
+                k = j <= n/2 ? j : n - j;
+                xr = w[2*k*v + p];
+                xi = (k == 0 || 2*k == n) ? 0.0 : w[(2*k + 1)*v + p];
+                if (k != j) {
+                    xi = -xi;
+                }
+            }
+            else {
+                xr = w[2*j*v + p];
+                xi = w[(2*j + 1)*v + p];
+            }
+            xi *= sign;
+            a[2*j*v + p] = xr*c + xi*s;
+            a[(2*j + 1)*v + p] = xi*c - xr*s;
+        }
+    }
+    memset(a + 2*n*v, 0, 2*(m - n)*v*sizeof(double));
+
+    if (v > 1) {
+        cfftf_batch((int)m, a, ch, plan->sub->wsave);
+    }
+    else {
+        cfftf_r((int)m, a, ch, plan->sub->wsave);
+    }
+    for (j = 0; j < m; j++) {
+        for (p = 0; p < v; p++) {
+            double *x = a + 2*j*v + p;
+            double xr = x[0];
+
+            x[0] = xr*b[2*j] - x[v]*b[2*j + 1];
+            x[v] = xr*b[2*j + 1] + x[v]*b[2*j];
+        }
+    }
+    if (v > 1) {
+        cfftb_batch((int)m, a, ch, plan->sub->wsave);
+    }
+    else {
+        cfftb_r((int)m, a, ch, plan->sub->wsave);
+    }
+
+    nout = kind == FFT_REAL_FORWARD ? n/2 + 1 : n;
+    for (j = 0; j < nout; j++) {
+        double c = chirp[2*j], s = chirp[2*j + 1];
+
+        for (p = 0; p < v; p++) {
+            double xr = a[2*j*v + p], xi = a[(2*j + 1)*v + p];
+
+            if (kind == FFT_REAL_BACKWARD) {
+                /* the halfcomplex input of rfftb would follow the lanes */
+                w[(2*(n/2 + 1) + j)*v + p] = xr*c + xi*s;
+            }
+            else {
+                w[2*j*v + p] = xr*c + xi*s;
+                w[(2*j + 1)*v + p] = sign*(xi*c - xr*s);
+            }
+        }
+    }
+    if (kind == FFT_REAL_FORWARD) {
+        /* the real parts of the spectrum of real input */
+        for (p = 0; p < v; p++) {
+            w[v + p] = 0.0;
+            if (n % 2 == 0) {
+                w[(n + 1)*v + p] = 0.0;
+            }
+        }
+    }
+}
+
+/*
+ * Transforms the lanes [first, last). The inputs of a tile of lanes are
+ * gathered together, so that the lanes along an outer axis are read a row
+ * at a time, and interleaved in groups of FFTPACK_BATCH lanes, which are
+ * transformed at once. The lanes left over at the end of a tile are
+ * transformed one at a time. work holds the scratch space of a tile.
+ */
+static void
+fft_batch_lanes(const fft_batch *b, npy_intp first, npy_intp last,
+                double *work)
+{
+    npy_intp i, j, k, l, ntile, nfull, m, n = b->n, nitems;
+    int real_forward = b->kind == FFT_REAL_FORWARD;
+    /* the doubles of an input item, the items start after shift doubles */
+    int nd = real_forward ? 1 : 2;
+    npy_intp shift = real_forward ? 1 : 0;
+    double *bases[FFT_MAX_TILE];
+    int vs[FFT_MAX_TILE], ps[FFT_MAX_TILE];
+
+    /* the items to fill, padding with zeros */
+    if (real_forward) {
+        nitems = n + 1;
+        m = b->nin < n ? b->nin : n;
+    }
+    else if (b->kind == FFT_REAL_BACKWARD) {
+        nitems = n/2 + 1;
+        m = b->nin < nitems ? b->nin : nitems;
+    }
+    else {
+        nitems = n;
+        m = b->nin < n ? b->nin : n;
+    }
+
+    for (i = first; i < last; i += ntile) {
+        ntile = last - i < b->tile ? last - i : b->tile;
+        nfull = ntile - ntile % FFTPACK_BATCH;
+        for (l = 0; l < ntile; l++) {
+            if (l < nfull) {
+                bases[l] = work + (l - l % FFTPACK_BATCH)*b->worksize;
+                vs[l] = FFTPACK_BATCH;
+                ps[l] = l % FFTPACK_BATCH;
+            }
+            else {
+                bases[l] = work + l*b->worksize;
+                vs[l] = 1;
+                ps[l] = 0;
+            }
+        }
+
+        if (b->instride == nd*sizeof(double)) {
+            for (l = 0; l < ntile; l++) {
+                const double *src = (const double *)(b->indata +
+                        b->inoffsets[i + l]);
+                double *dst = bases[l] + shift*vs[l] + ps[l];
+
+                if (vs[l] == 1) {
+                    memcpy(dst, src, m*nd*sizeof(double));
+                    continue;
+                }
+                for (k = 0; k < m*nd; k++) {
+                    dst[k*vs[l]] = src[k];
+                }
+            }
+        }
+        else {
+            for (j = 0; j < m; j++) {
+                for (l = 0; l < ntile; l++) {
+                    const double *src = (const double *)(b->indata +
+                            b->inoffsets[i + l] + j*b->instride);
+                    double *dst = bases[l] + (shift + j*nd)*vs[l] + ps[l];
+
+                    dst[0] = src[0];
+                    if (nd == 2) {
+                        dst[vs[l]] = src[1];
+                    }
+                }
+            }
+        }
+
+        for (l = 0; l < ntile; l += vs[l]) {
+            int v = vs[l];
+            double *w = bases[l], *ch = w + v*(4*n + 4);
+
+            memset(w + (shift + m*nd)*v, 0, (nitems - m)*nd*v*sizeof(double));
+            if (b->plan->sub != NULL) {
+                fft_bluestein(b->plan, b->kind, w, ch, v);
+            }
+            else {
+                switch (b->kind) {
+                    case FFT_FORWARD:
+                        if (v > 1) {
+                            cfftf_batch((int)n, w, ch, b->plan->wsave);
+                        }
+                        else {
+                            cfftf_r((int)n, w, ch, b->plan->wsave);
+                        }
+                        break;
+                    case FFT_BACKWARD:
+                        if (v > 1) {
+                            cfftb_batch((int)n, w, ch, b->plan->wsave);
+                        }
+                        else {
+                            cfftb_r((int)n, w, ch, b->plan->wsave);
+                        }
+                        break;
+                    case FFT_REAL_FORWARD:
+                        if (v > 1) {
+                            rfftf_batch((int)n, w + v, ch, b->plan->wsave);
+                        }
+                        else {
+                            rfftf_r((int)n, w + 1, ch, b->plan->wsave);
+                        }
+                        /* the first item is real */
+                        memcpy(w, w + v, v*sizeof(double));
+                        memset(w + v, 0, v*sizeof(double));
+                        break;
+                    case FFT_REAL_BACKWARD: {
+                        /* the halfcomplex input of rfftb follows the lanes */
+                        double *half = w + 2*nitems*v;
+
+                        memcpy(half, w, v*sizeof(double));
+                        memcpy(half + v, w + 2*v, (n - 1)*v*sizeof(double));
+                        if (v > 1) {
+                            rfftb_batch((int)n, half, ch, b->plan->wsave);
+                        }
+                        else {
+                            rfftb_r((int)n, half, ch, b->plan->wsave);
+                        }
+                        break;
+                    }
+                }
+            }
+            for (k = 0; k < v; k++) {
+                char *out = b->outdata + b->outoffsets[i + l + k];
+
+                if (b->kind == FFT_REAL_BACKWARD) {
+                    fft_scatter(out, w + 2*nitems*v, n, b->outstride, 1, v, k);
+                }
+                else {
+                    fft_scatter(out, w, b->nout, b->outstride, 2, v, k);
+                }
+            }
+        }
+    }
+}
+
+static void
+fft_batch_task(void *data, npy_intp itask)
+{
+    fft_batch *b = (fft_batch *)data;
+    npy_intp first = itask*b->chunk, last = first + b->chunk;
+
+    if (last > b->nlanes) {
+        last = b->nlanes;
+    }
+    fft_batch_lanes(b, first, last, b->work + itask*b->tile*b->worksize);
+}
+
+static char fftpack_execute__doc__[] =
+    "execute(a, n, axis, kind)\n\n"
+    "Transform all the lanes of a along axis, cropped or padded with zeros\n"
+    "to n points. kind is 0 for cfftf, 1 for cfftb, 2 for rfftf and 3 for\n"
+    "rfftb, whose input lanes are complex with n//2 + 1 points.";
+
+static PyObject *
+fftpack_execute(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *op;
+    PyArrayObject *in = NULL, *out = NULL;
+    npy_intp n, dims[NPY_MAXDIMS], coords[NPY_MAXDIMS];
+    npy_intp i, inoff, outoff, ntasks = 1;
+    int axis, kind, nd, k;
+    fft_batch b;
+    npy_ufunc_threads_api *api = NULL;
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!PyArg_ParseTuple(args, "Onii", &op, &n, &axis, &kind)) {
+        return NULL;
+    }
+    if (kind < FFT_FORWARD || kind > FFT_REAL_BACKWARD) {
+        PyErr_SetString(PyExc_ValueError, "unknown kind of transform");
+        return NULL;
+    }
+    if (n < 1) {
+        PyErr_Format(PyExc_ValueError,
+                "Invalid number of FFT data points (%ld) specified.",
+                (long)n);
+        return NULL;
+    }
+    in = (PyArrayObject *)PyArray_FROM_OTF(op,
+                kind == FFT_REAL_FORWARD ? NPY_DOUBLE : NPY_CDOUBLE,
+                NPY_ARRAY_ALIGNED | NPY_ARRAY_NOTSWAPPED);
+    if (in == NULL) {
+        return NULL;
+    }
+    nd = PyArray_NDIM(in);
+    if (axis < 0) {
+        axis += nd;
+    }
+    if (axis < 0 || axis >= nd) {
+        PyErr_SetString(PyExc_IndexError, "axis out of range");
+        Py_DECREF(in);
+        return NULL;
+    }
+
+    memset(&b, 0, sizeof(b));
+    b.kind = kind;
+    b.n = n;
+    b.nin = PyArray_DIM(in, axis);
+    b.nout = kind == FFT_REAL_FORWARD ? n/2 + 1 : n;
+    /* the output lanes are contiguous, in the axes swapped like the input */
+    memcpy(dims, PyArray_DIMS(in), nd*sizeof(npy_intp));
+    dims[axis] = dims[nd - 1];
+    dims[nd - 1] = b.nout;
+    out = (PyArrayObject *)PyArray_SimpleNew(nd, dims,
+                kind == FFT_REAL_BACKWARD ? NPY_DOUBLE : NPY_CDOUBLE);
+    if (out == NULL) {
+        goto fail;
+    }
+    if (axis != nd - 1) {
+        PyArrayObject *swapped;
+
+        swapped = (PyArrayObject *)PyArray_SwapAxes(out, axis, nd - 1);
+        Py_DECREF(out);
+        out = swapped;
+        if (out == NULL) {
+            goto fail;
+        }
+    }
+    memcpy(dims, PyArray_DIMS(out), nd*sizeof(npy_intp));
+    b.nlanes = PyArray_SIZE(out) / b.nout;
+    if (b.nlanes == 0) {
+        Py_DECREF(in);
+        return (PyObject *)out;
+    }
+    b.plan = plan_acquire(n, kind >= FFT_REAL_FORWARD);
+    if (b.plan == NULL) {
+        goto fail;
+    }
+
+    /* the offsets of the lanes, counting over the other axes */
+    b.indata = PyArray_DATA(in);
+    b.outdata = PyArray_DATA(out);
+    b.instride = PyArray_STRIDE(in, axis);
+    b.outstride = PyArray_STRIDE(out, axis);
+    b.inoffsets = PyArray_malloc(2*b.nlanes*sizeof(npy_intp));
+    if (b.inoffsets == NULL) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+    b.outoffsets = b.inoffsets + b.nlanes;
+    memset(coords, 0, nd*sizeof(npy_intp));
+    inoff = outoff = 0;
+    for (i = 0; i < b.nlanes; i++) {
+        b.inoffsets[i] = inoff;
+        b.outoffsets[i] = outoff;
+        for (k = nd - 1; k >= 0; k--) {
+            if (k == axis) {
+                continue;
+            }
+            if (++coords[k] < dims[k]) {
+                inoff += PyArray_STRIDE(in, k);
+                outoff += PyArray_STRIDE(out, k);
+                break;
+            }
+            coords[k] = 0;
+            inoff -= PyArray_STRIDE(in, k)*(dims[k] - 1);
+            outoff -= PyArray_STRIDE(out, k)*(dims[k] - 1);
+        }
+    }
+
+    if (b.nlanes > 1 && b.nlanes*n >= 2*FFT_THREAD_MIN_POINTS) {
+        api = npy_get_ufunc_threads();
+        if (api != NULL) {
+            ntasks = b.nlanes*n / FFT_THREAD_MIN_POINTS;
+            if (ntasks > b.nlanes) {
+                ntasks = b.nlanes;
+            }
+            if (ntasks > api->get_num_threads()) {
+                ntasks = api->get_num_threads();
+            }
+        }
+    }
+    b.chunk = (b.nlanes + ntasks - 1) / ntasks;
+    b.chunk += (FFTPACK_BATCH - b.chunk % FFTPACK_BATCH) % FFTPACK_BATCH;
+    /* the data and the halfcomplex copy of rfftb, then the scratch space */
+    b.worksize = 6*n + 4;
+    if (b.plan->sub != NULL) {
+        b.worksize = 4*n + 4 + 4*b.plan->sub->n;
+    }
+    b.tile = FFT_TILE_POINTS / n;
+    if (b.tile > FFT_MAX_TILE) {
+        b.tile = FFT_MAX_TILE;
+    }
+    b.tile -= b.tile % FFTPACK_BATCH;
+    if (b.tile < FFTPACK_BATCH) {
+        b.tile = FFTPACK_BATCH;
+    }
+    b.work = PyArray_malloc(ntasks*b.tile*b.worksize*sizeof(double));
+    if (b.work == NULL) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+
+    NPY_BEGIN_THREADS;
+    if (ntasks > 1) {
+        api->run_tasks(&fft_batch_task, &b, ntasks);
+    }
+    else {
+        fft_batch_lanes(&b, 0, b.nlanes, b.work);
+    }
+    NPY_END_THREADS;
+
+    PyArray_free(b.work);
+    PyArray_free(b.inoffsets);
+    plan_release(b.plan);
+    Py_DECREF(in);
+    return (PyObject *)out;
+
+fail:
+    PyArray_free(b.work);
+    PyArray_free(b.inoffsets);
+    if (b.plan != NULL) {
+        plan_release(b.plan);
+    }
+    Py_XDECREF(in);
+    Py_XDECREF(out);
+    return NULL;
+}
+
+
 /* List of methods defined in the module */
 
 static struct PyMethodDef fftpack_methods[] = {
@@ -301,6 +1057,10 @@ static struct PyMethodDef fftpack_methods[] = {
     {"rfftf",   fftpack_rfftf,  1,      fftpack_rfftf__doc__},
     {"rfftb",   fftpack_rfftb,  1,      fftpack_rfftb__doc__},
     {"rffti",   fftpack_rffti,  1,      fftpack_rffti__doc__},
+    {"execute", fftpack_execute, 1,     fftpack_execute__doc__},
+    {"set_cache_size", fftpack_set_cache_size, 1,
+        fftpack_set_cache_size__doc__},
+    {"cache_info", fftpack_cache_info, 1, fftpack_cache_info__doc__},
     {NULL, NULL, 0, NULL}          /* sentinel */
 };
 
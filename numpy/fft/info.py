@@ -48,6 +48,7 @@ Helper routines
    fftfreq   Discrete Fourier Transform sample frequencies.
    fftshift  Shift zero-frequency component to center of spectrum.
    ifftshift Inverse of fftshift.
+   set_plan_cache_size Limit the memory of the cached transform setups.
 
 
 Background information
@@ -1,7 +1,8 @@
 from __future__ import division
 
 import numpy as np
-from numpy.testing import TestCase, run_module_suite, assert_array_almost_equal
+from numpy.testing import TestCase, run_module_suite, \
+     assert_array_almost_equal, assert_equal, assert_
 
 def fft1(x):
     L = len(x)
@@ -22,6 +23,95 @@ class TestFFT1D(TestCase):
         x = rand(30) + 1j*rand(30)
         assert_array_almost_equal(fft1(x), np.fft.fft(x))
 
+    def test_axes_and_sizes(self):
+        rand = np.random.random
+        x = rand((3, 10, 4)) + 1j*rand((3, 10, 4))
+        for axis in range(-3, 3):
+            for n in (None, 1, 7, 10, 16):
+                y = np.fft.fft(x, n, axis)
+                z = np.apply_along_axis(
+                    lambda v: fft1(np.resize(np.concatenate(
+                        [v, np.zeros(max(0, (n or len(v)) - len(v)))]),
+                        n or len(v))), axis, x)
+                assert_array_almost_equal(y, z)
+                assert_array_almost_equal(np.fft.ifft(y, axis=axis),
+                                          np.fft.ifft(z, axis=axis))
+
+    def test_real(self):
+        x = np.random.random((5, 11))
+        for n in (None, 4, 11, 12, 20):
+            y = np.fft.rfft(x, n, axis=0)
+            z = np.fft.fft(x, n, axis=0)
+            assert_array_almost_equal(y, z[:y.shape[0]])
+            m = n or x.shape[0]
+            assert_array_almost_equal(np.fft.irfft(y, m, axis=0),
+                                      np.fft.ifft(z, axis=0).real)
+
+    def test_batches(self):
+        # the lanes are transformed in groups, and the rest one at a time
+        rand = np.random.random
+        for n in (2, 3, 4, 5, 7, 12, 14, 30, 49, 60, 77, 98):
+            for nlanes in (2, 3, 5, 17):
+                x = rand((nlanes, n)) + 1j*rand((nlanes, n))
+                for f, a in ((np.fft.fft, x), (np.fft.ifft, x),
+                             (np.fft.rfft, x.real.copy())):
+                    y = f(a)
+                    assert_array_almost_equal(y[0], f(a[0]))
+                    assert_array_almost_equal(f(a.T, axis=0).T, y)
+                assert_array_almost_equal(np.fft.fft(x)[-1], fft1(x[-1]))
+                assert_array_almost_equal(np.fft.irfft(x, n)[-1],
+                                          np.fft.irfft(x[-1], n))
+
+    def test_large_prime_factors(self):
+        rand = np.random.random
+        for n in (53, 101, 2*59, 3*3*67, 1009):
+            x = rand((3, n)) + 1j*rand((3, n))
+            y = np.fft.fft(x)
+            assert_array_almost_equal(y[1], fft1(x[1]))
+            assert_array_almost_equal(np.fft.fft(x.T, axis=0).T, y)
+            assert_array_almost_equal(np.fft.ifft(y), x)
+            r = np.fft.rfft(x.real)
+            assert_array_almost_equal(r, np.fft.fft(x.real)[:, :n//2 + 1])
+            assert_equal(r[:, 0].imag, 0)
+            assert_array_almost_equal(np.fft.irfft(r, n), x.real)
+
+    def test_threads(self):
+        x = np.random.random((200, 512))
+        old = np.setnumthreads(4)
+        try:
+            y = np.fft.rfft(x)
+            assert_array_almost_equal(np.fft.irfft(y), x)
+        finally:
+            np.setnumthreads(old)
+        assert_array_almost_equal(y, np.fft.rfft(x))
+
+
+class TestPlanCache(TestCase):
+
+    def setUp(self):
+        self.old = np.fft.set_plan_cache_size(1 << 16)
+
+    def tearDown(self):
+        np.fft.set_plan_cache_size(self.old)
+
+    def test_bounded(self):
+        from numpy.fft import fftpack_lite
+        for n in range(100, 200):
+            np.fft.fft(np.ones(n))
+        count, nbytes, limit = fftpack_lite.cache_info()
+        assert_(nbytes <= limit and 0 < count < 100)
+        # an evicted size is set up again
+        assert_array_almost_equal(np.fft.fft(np.ones(100)),
+                                  np.eye(1, 100)[0]*100)
+        np.fft.set_plan_cache_size(0)
+        assert_equal(fftpack_lite.cache_info()[:2], (0, 0))
+        # nothing is cached without a limit
+        assert_array_almost_equal(np.fft.fft(np.ones(100)),
+                                  np.eye(1, 100)[0]*100)
+        assert_array_almost_equal(np.fft.fft(np.ones(101)),
+                                  np.eye(1, 101)[0]*101)
+        assert_equal(fftpack_lite.cache_info()[:2], (0, 0))
+
 
 if __name__ == "__main__":
     run_module_suite()
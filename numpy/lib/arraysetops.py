@@ -1,5 +1,5 @@
 """
-Set operations for 1D numeric arrays based on sorting.
+Set operations for 1D numeric arrays based on sorting and hashing.
 
 :Contains:
   ediff1d,
@@ -15,6 +15,10 @@ Set operations for 1D numeric arrays based on sorting.
 For floating point arrays, inaccurate results may appear due to usual round-off
 and floating point comparison issues.
 
+For the numeric types except long double and for strings the distinct values
+are found with a hash table, and only they are sorted. As with sorting, each
+NaN is a distinct value.
+
 Speed could be gained in some operations by an implementation of
 sort(), that can provide directly the permutation vectors, avoiding
 thus calls to argsort().
@@ -28,6 +32,15 @@ __all__ = ['ediff1d', 'intersect1d', 'setxor1d', 'union1d', 'setdiff1d',
 
 import numpy as np
 from numpy.lib.utils import deprecate
+from numpy.core.multiarray import _unique_hash, _in1d_hash
+
+# The type characters of the dtypes the hash tables support
+_hash_typechars = 'bBhHiIlLqQpP?efdFDSU'
+
+def _hashable(ar):
+    """Whether the hash tables can be used for the 1-D ndarray `ar`."""
+    return type(ar) is np.ndarray and ar.ndim == 1 and \
+            ar.dtype.char in _hash_typechars
 
 def ediff1d(ary, to_end=None, to_begin=None):
     """
@@ -173,6 +186,23 @@ def unique(ar, return_index=False, return_inverse=False):
         else:
             return ar
 
+    if _hashable(ar):
+        # Find the distinct values with a hash table and sort only them,
+        # unless there are so many that sorting all values is as fast.
+        res = _unique_hash(ar, return_inverse, ar.size // 4)
+        if res is not None:
+            first, inverse = res
+            aux = ar[first]
+            perm = aux.argsort(kind='mergesort')
+            ret = (aux[perm],)
+            if return_index:
+                ret += (first[perm],)
+            if return_inverse:
+                rank = np.empty(perm.size, np.intp)
+                rank[perm] = np.arange(perm.size)
+                ret += (rank[inverse],)
+            return ret[0] if len(ret) == 1 else ret
+
     if return_inverse or return_index:
         if return_index:
             perm = ar.argsort(kind='mergesort')
@@ -331,6 +361,15 @@ def in1d(ar1, ar2, assume_unique=False):
             mask |= (ar1 == a)
         return mask
 
+    # Use a hash table of ar2 when possible
+    ar1 = np.asarray(ar1).ravel()
+    ar2 = np.asarray(ar2).ravel()
+    kinds = ar1.dtype.kind + ar2.dtype.kind
+    if kinds in ('SS', 'UU') or (kinds[0] in 'biufc' and kinds[1] in 'biufc'):
+        dtype = np.promote_types(ar1.dtype, ar2.dtype)
+        if dtype.char in _hash_typechars:
+            return _in1d_hash(ar1.astype(dtype), ar2.astype(dtype))
+
     # Otherwise use sorting
     if not assume_unique:
         ar1, rev_idx = np.unique(ar1, return_inverse=True)
@@ -19,7 +19,8 @@ from numpy.core.numeric import ScalarType, dot, where, newaxis, intp, \
         integer, isscalar
 from numpy.core.umath import pi, multiply, add, arctan2,  \
         frompyfunc, isnan, cos, less_equal, sqrt, sin, mod, exp, log10
-from numpy.core.fromnumeric import ravel, nonzero, choose, sort, mean
+from numpy.core.fromnumeric import ravel, nonzero, choose, sort, partition, \
+     mean
 from numpy.core.numerictypes import typecodes, number
 from numpy.core import atleast_1d, atleast_2d
 from numpy.lib.twodim_base import diag
@@ -2929,30 +2930,37 @@ def median(a, axis=None, out=None, overwrite_input=False):
     >>> assert not np.all(a==b)
 
     """
+    if axis is None:
+        # a flattened matrix stays 2-D, so partition a 1-D view instead
+        a = np.asarray(a).ravel()
+        axis = 0
+    # only the one or two middle elements need to be in sorted position
+    sz = np.shape(a)[axis]
+    szh = sz // 2
+    if sz % 2 == 1:
+        kth = [szh]
+    elif sz > 0:
+        kth = [szh - 1, szh]
+    else:
+        kth = np.array([], dtype=intp)
     if overwrite_input:
-        if axis is None:
-            sorted = a.ravel()
-            sorted.sort()
-        else:
-            a.sort(axis=axis)
-            sorted = a
+        a.partition(kth, axis=axis)
+        part = a
     else:
-        sorted = sort(a, axis=axis)
-    if sorted.shape == ():
+        part = partition(a, kth, axis=axis)
+    if part.shape == ():
         # make 0-D arrays work
-        return sorted.item()
-    if axis is None:
-        axis = 0
-    indexer = [slice(None)] * sorted.ndim
-    index = int(sorted.shape[axis]/2)
-    if sorted.shape[axis] % 2 == 1:
+        return part.item()
+    indexer = [slice(None)] * part.ndim
+    index = int(part.shape[axis]/2)
+    if part.shape[axis] % 2 == 1:
         # index with slice to allow mean (below) to work
         indexer[axis] = slice(index, index+1)
     else:
         indexer[axis] = slice(index-1, index+1)
     # Use mean in odd and even case to coerce data type
     # and check, use out array.
-    return mean(sorted[indexer], axis=axis, out=out)
+    return mean(part[indexer], axis=axis, out=out)
 
 def percentile(a, q, axis=None, out=None, overwrite_input=False):
     """
@@ -3039,19 +3047,33 @@ def percentile(a, q, axis=None, out=None, overwrite_input=False):
     elif q == 100:
         return a.max(axis=axis, out=out)
 
+    # only the elements next to the requested ranks need to be in sorted
+    # position, the ranks of out of range q are clipped here and rejected
+    # by _compute_qth_percentile
+    if axis is None:
+        Nx = a.size
+    else:
+        Nx = a.shape[axis]
+    if Nx > 0:
+        ranks = np.asarray(q, dtype=float).ravel() / 100.0 * (Nx - 1)
+        lo = np.clip(np.floor(ranks), 0, Nx - 1).astype(intp)
+        kth = concatenate((lo, np.minimum(lo + 1, Nx - 1)))
+    else:
+        kth = np.array([], dtype=intp)
+
     if overwrite_input:
         if axis is None:
-            sorted = a.ravel()
-            sorted.sort()
+            part = a.ravel()
+            part.partition(kth)
         else:
-            a.sort(axis=axis)
-            sorted = a
+            a.partition(kth, axis=axis)
+            part = a
     else:
-        sorted = sort(a, axis=axis)
+        part = partition(a, kth, axis=axis)
     if axis is None:
         axis = 0
 
-    return _compute_qth_percentile(sorted, q, axis, out)
+    return _compute_qth_percentile(part, q, axis, out)
 
 # handle sequence of q's without calling sort multiple times
 def _compute_qth_percentile(sorted, q, axis, out):
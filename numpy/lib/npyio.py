@@ -1,6 +1,7 @@
 __all__ = ['savetxt', 'loadtxt', 'genfromtxt', 'ndfromtxt', 'mafromtxt',
            'recfromtxt', 'recfromcsv', 'load', 'loads', 'save', 'savez',
-           'savez_compressed', 'packbits', 'unpackbits', 'fromregex', 'DataSource']
+           'savez_compressed', 'packbits', 'unpackbits', 'fromregex', 'DataSource',
+           'loadtxt_blocks', 'fromfile_blocks']
 
 import numpy as np
 import format
@@ -9,6 +10,7 @@ import os
 import re
 import sys
 import itertools
+import struct
 import warnings
 import weakref
 from operator import itemgetter
@@ -16,13 +18,15 @@ from operator import itemgetter
 from cPickle import load as _cload, loads
 from _datasource import DataSource
 from _compiled_base import packbits, unpackbits
+from numpy.core.multiarray import _loadtxt
 
 from _iotools import LineSplitter, NameValidator, StringConverter, \
                      ConverterError, ConverterLockError, ConversionWarning, \
                      _is_string_like, has_nested_fields, flatten_dtype, \
                      easy_dtype, _bytes_to_name
 
-from numpy.compat import asbytes, asstr, asbytes_nested, bytes
+from numpy.compat import asbytes, asstr, asbytes_nested, bytes, isfileobj
+from numpy.core.memmap import mode_equivalents
 
 if sys.version_info[0] >= 3:
     from io import BytesIO
@@ -123,6 +127,12 @@ def zipfile_factory(*args, **kwargs):
         kwargs['allowZip64'] = True
     return zipfile.ZipFile(*args, **kwargs)
 
+# The local file header in front of each member of a zip archive, see
+# section V.A of the PKWARE APPNOTE.TXT.
+_ZIP_PREFIX = asbytes('PK\x03\x04')
+_ZIP_LOCAL_HEADER = '<4s22xHH'
+_ZIP_LOCAL_HEADER_SIZE = struct.calcsize(_ZIP_LOCAL_HEADER)
+
 class NpzFile(object):
     """
     NpzFile(fid)
@@ -140,6 +150,15 @@ class NpzFile(object):
     be obtained with ``obj.files`` and the ZipFile object itself using
     ``obj.zip``.
 
+    With a `mmap_mode`, the arrays of members that are stored without
+    compression, as `savez` writes them, are memory-mapped at their
+    offset inside the archive instead of being read. Opening the archive
+    then only reads its directory, and the pages of an array are loaded
+    when it is used. Compressed members and members holding Python
+    objects are read as usual. The members start anywhere in the archive,
+    so the mapped arrays are usually not aligned, and the functions which
+    need aligned data, such as `dot`, work on a copy of them.
+
     Attributes
     ----------
     files : list of str
@@ -158,6 +177,11 @@ class NpzFile(object):
     own_fid : bool, optional
         Whether NpzFile should close the file handle.
         Requires that `fid` is a file-like object.
+    mmap_mode : {None, 'r', 'c'}, optional
+        If not None, memory-map the uncompressed members with the given
+        mode, see `numpy.memmap`. Memory-mapping requires the archive to
+        be a file on disk. The modes which write to the file are not
+        allowed, as they would leave a wrong checksum in the archive.
 
     Examples
     --------
@@ -179,9 +203,15 @@ class NpzFile(object):
     array([0, 1, 2, 3, 4, 5, 6, 7, 8, 9])
 
     """
-    def __init__(self, fid, own_fid=False):
+    def __init__(self, fid, own_fid=False, mmap_mode=None):
         # Import is postponed to here since zipfile depends on gzip, an optional
         # component of the so-called standard library.
+        self.zip = self.fid = None
+        if mmap_mode is not None:
+            mmap_mode = mode_equivalents.get(mmap_mode, mmap_mode)
+            if mmap_mode not in ('r', 'c'):
+                raise ValueError("mmap_mode of an archive must be 'r' or "
+                                 "'c', not %r" % (mmap_mode,))
         _zip = zipfile_factory(fid)
         self._files = _zip.namelist()
         self.files = []
@@ -196,6 +226,10 @@ class NpzFile(object):
             self.fid = fid
         else:
             self.fid = None
+        # The members can only be mapped from a file on disk.
+        self._mmap_mode = None
+        if mmap_mode is not None and isfileobj(_zip.fp):
+            self._mmap_mode = mmap_mode
 
     def __enter__(self):
         return self
@@ -235,6 +269,10 @@ class NpzFile(object):
             member = 1
             key += '.npy'
         if member:
+            if self._mmap_mode is not None:
+                array = self._memmap(key)
+                if array is not None:
+                    return array
             bytes = self.zip.read(key)
             if bytes.startswith(format.MAGIC_PREFIX):
                 value = BytesIO(bytes)
@@ -244,6 +282,53 @@ class NpzFile(object):
         else:
             raise KeyError("%s is not a file in the archive" % key)
 
+    def _memmap(self, key):
+        """
+        Memory-map the array of the member `key`, or return None if it has
+        to be read through the zipfile.
+
+        """
+        import zipfile
+        info = self.zip.getinfo(key)
+        # Bit 0 of the flags marks an encrypted member.
+        if info.compress_type != zipfile.ZIP_STORED or info.flag_bits & 0x1:
+            return None
+        # The name and extra field of the local header may differ from the
+        # ones in the central directory, so the data offset is taken from
+        # the local header.
+        fp = self.zip.fp
+        fp.seek(info.header_offset)
+        header = fp.read(_ZIP_LOCAL_HEADER_SIZE)
+        if len(header) != _ZIP_LOCAL_HEADER_SIZE:
+            return None
+        prefix, name_len, extra_len = struct.unpack(_ZIP_LOCAL_HEADER, header)
+        if prefix != _ZIP_PREFIX:
+            return None
+        start = info.header_offset + _ZIP_LOCAL_HEADER_SIZE + name_len + \
+                extra_len
+        fp.seek(start)
+        if fp.read(len(format.MAGIC_PREFIX)) != format.MAGIC_PREFIX:
+            return None
+        fp.seek(start)
+        if format.read_magic(fp) != (1, 0):
+            return None
+        shape, fortran_order, dtype = format.read_array_header_1_0(fp)
+        offset = fp.tell()
+        size = 1
+        for n in shape:
+            size *= n
+        # Empty arrays can't be mapped.
+        if dtype.hasobject or size == 0:
+            return None
+        if offset + size*dtype.itemsize > start + info.file_size:
+            raise ValueError("array data of %s extends past the member" % key)
+        if fortran_order:
+            order = 'F'
+        else:
+            order = 'C'
+        return np.memmap(fp, dtype=dtype, mode=self._mmap_mode,
+                         offset=offset, shape=shape, order=order)
+
 
     def __iter__(self):
         return iter(self.files)
@@ -287,7 +372,9 @@ def load(file, mmap_mode=None):
         A memory-mapped array is kept on disk. However, it can be accessed
         and sliced like any ndarray.  Memory mapping is especially useful for
         accessing small fragments of large files without reading the entire
-        file into memory.
+        file into memory. For ``.npz`` files the arrays of the uncompressed
+        members are memory-mapped when they are accessed, see `NpzFile`;
+        only 'r' and 'c' are allowed.
 
     Returns
     -------
@@ -365,13 +452,13 @@ def load(file, mmap_mode=None):
 
     try:
         # Code to distinguish from NumPy binary files and pickles.
-        _ZIP_PREFIX = asbytes('PK\x03\x04')
         N = len(format.MAGIC_PREFIX)
         magic = fid.read(N)
         fid.seek(-N, 1) # back-up
         if magic.startswith(_ZIP_PREFIX):  # zip-file (assume .npz)
+            npz = NpzFile(fid, own_fid=True, mmap_mode=mmap_mode)
             own_fid = False
-            return NpzFile(fid, own_fid=True)
+            return npz
         elif magic == format.MAGIC_PREFIX: # .npy file
             if mmap_mode:
                 return format.open_memmap(file, mode=mmap_mode)
@@ -607,6 +694,42 @@ def _getconv(dtype):
     else:
         return str
 
+# The types the C text reader converts, in native byte order
+_text_typechars = '?bBhHiIlLqQpPefdgFDGS'
+
+def _text_columns(dtype):
+    """
+    Return the columns of a row of `dtype` for the C text reader, as a
+    list of (type, offset) pairs, or None if it does not support them.
+    """
+    if dtype.names is not None:
+        columns = []
+        for name in dtype.names:
+            field, offset = dtype.fields[name][:2]
+            sub = _text_columns(field)
+            if sub is None:
+                return None
+            columns.extend([(dt, offset + off) for (dt, off) in sub])
+        return columns
+    if dtype.shape:
+        base = dtype.base
+        sub = _text_columns(base)
+        if sub is None:
+            return None
+        return [(dt, i*base.itemsize + off)
+                for i in range(int(np.prod(dtype.shape)))
+                for (dt, off) in sub]
+    if dtype.char in _text_typechars and dtype.isnative and dtype.itemsize:
+        return [(dtype, 0)]
+    return None
+
+def _read_blocks(fh, size=1 << 20):
+    """Yield the contents of a file in blocks, for the C text reader."""
+    while True:
+        block = fh.read(size)
+        if not block:
+            break
+        yield block
 
 
 def loadtxt(fname, dtype=float, comments='#', delimiter=None,
@@ -674,6 +797,9 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
     `genfromtxt` function provides more sophisticated handling of, e.g.,
     lines with missing values.
 
+    Unless `converters` are given, files of booleans, numbers and byte
+    strings are parsed in C, in blocks, straight into the result.
+
     Examples
     --------
     >>> from StringIO import StringIO   # StringIO behaves like a file object
@@ -709,12 +835,13 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
         if _is_string_like(fname):
             fown = True
             if fname.endswith('.gz'):
-                fh = iter(seek_gzip_factory(fname))
+                fobj = seek_gzip_factory(fname)
             elif fname.endswith('.bz2'):
                 import bz2
-                fh = iter(bz2.BZ2File(fname))
+                fobj = bz2.BZ2File(fname)
             else:
-                fh = iter(open(fname, 'U'))
+                fobj = open(fname, 'U')
+            fh = iter(fobj)
         else:
             fh = iter(fname)
     except TypeError:
@@ -779,6 +906,28 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
         dtype = np.dtype(dtype)
         defconv = _getconv(dtype)
 
+        # Without converters the C reader fills the array directly, but
+        # negative usecols count from the end of each line
+        columns = _text_columns(dtype)
+        if usecols and [i for i in usecols if i < 0]:
+            columns = None
+        if columns is not None and not user_converters:
+            if dtype.names is None and not dtype.shape:
+                columns = None
+            else:
+                # The fields take the leading columns or usecols
+                usecols = (usecols or range(len(columns)))[:len(columns)]
+            if fown:
+                chunks = _read_blocks(fobj)
+            else:
+                chunks = fh
+            X = _loadtxt(chunks, dtype, columns, delimiter, comments,
+                         skiprows, usecols, lines=not fown)[0]
+            if len(X) == 0:
+                warnings.warn('loadtxt: Empty input file: "%s"' % fname)
+                X = np.array([], dtype)
+            return _loadtxt_shape(X, dtype, ndmin, unpack)
+
         # Skip the first `skiprows` lines
         for i in xrange(skiprows):
             fh.next()
@@ -832,14 +981,17 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
             X.append(items)
     finally:
         if fown:
-            fh.close()
+            fobj.close()
 
     X = np.array(X, dtype)
     # Multicolumn data are returned with shape (1, N, M), i.e.
     # (1, 1, M) for a single row - remove the singleton dimension there
     if X.ndim == 3 and X.shape[:2] == (1, 1):
         X.shape = (1, -1)
+    return _loadtxt_shape(X, dtype, ndmin, unpack)
 
+def _loadtxt_shape(X, dtype, ndmin, unpack):
+    """Give the array read by loadtxt its final shape."""
     # Verify that the array has at least dimensions `ndmin`.
     # Check correctness of the values of `ndmin`
     if not ndmin in [0, 1, 2]:
@@ -856,7 +1008,7 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
             X = np.atleast_2d(X).T
 
     if unpack:
-        if len(dtype_types) > 1:
+        if dtype.names is not None:
             # For structured arrays, return an array for each field.
             return [X[field] for field in dtype.names]
         else:
@@ -865,6 +1017,254 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
         return X
 
 
+def _open_binary(fname):
+    """Open a file name like loadtxt, but in binary mode, or pass a file."""
+    if not _is_string_like(fname):
+        return fname, False
+    if fname.endswith('.gz'):
+        return seek_gzip_factory(fname), True
+    elif fname.endswith('.bz2'):
+        import bz2
+        return bz2.BZ2File(fname), True
+    return open(fname, 'rb'), True
+
+class _BlockReader(object):
+    """
+    Base of the readers of `loadtxt_blocks` and `fromfile_blocks`, which
+    return the next block from `read`.
+    """
+    def __init__(self, fname, offset):
+        self._fh, self._own_fh = _open_binary(fname)
+        if offset:
+            self._fh.seek(offset)
+        self.offset = offset
+
+    def __iter__(self):
+        return self
+
+    def next(self):
+        block = self.read()
+        if len(block) == 0:
+            raise StopIteration
+        return block
+
+    __next__ = next
+
+    def close(self):
+        """Close the file, if the reader opened it."""
+        if self._own_fh:
+            self._fh.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc_info):
+        self.close()
+
+
+class TextBlockReader(_BlockReader):
+    """
+    Iterator over the rows of a text file in blocks, see `loadtxt_blocks`.
+    """
+    def __init__(self, fname, blocksize, dtype=float, comments='#',
+                 delimiter=None, skiprows=0, usecols=None, offset=0):
+        self.dtype = np.dtype(dtype)
+        self._columns = _text_columns(self.dtype)
+        if self._columns is None:
+            raise TypeError("cannot read %s from text in blocks" % self.dtype)
+        if self.dtype.names is None and not self.dtype.shape:
+            self._columns = None
+        if blocksize < 1:
+            raise ValueError("blocksize must be positive")
+        self.blocksize = blocksize
+        self._comments = asbytes(comments)
+        if delimiter is not None:
+            delimiter = asbytes(delimiter)
+        self._delimiter = delimiter
+        self._skiprows = skiprows
+        if usecols is not None:
+            usecols = list(usecols)
+        self._usecols = usecols
+        self._buffer = None
+        self._tail = asbytes('')
+        self._chunksize = 1 << 16
+        _BlockReader.__init__(self, fname, offset)
+
+    def _chunks(self, read):
+        """The bytes after the last row, then those of the file."""
+        if self._tail:
+            read.append(self._tail)
+            yield self._tail
+        while True:
+            chunk = self._fh.read(self._chunksize)
+            if not chunk:
+                break
+            read.append(chunk)
+            yield chunk
+
+    def read(self):
+        """
+        Return the next block of rows, or an empty array at the end of the
+        file. The blocks after the first full one are views of it.
+        """
+        read = []
+        X, invalid, used = _loadtxt(self._chunks(read), self.dtype,
+                                    self._columns, self._delimiter,
+                                    self._comments, self._skiprows,
+                                    self._usecols, max_rows=self.blocksize,
+                                    out=self._buffer)
+        self._skiprows = 0
+        self._tail = asbytes('').join(read)[used:]
+        self.offset += used
+        if self._buffer is None and len(X) == self.blocksize:
+            self._buffer = X
+        # read about one block at a time
+        if len(X):
+            self._chunksize = min(max(used // len(X) * self.blocksize,
+                                      1 << 16), 1 << 24)
+        return X
+
+
+class BinaryBlockReader(_BlockReader):
+    """
+    Iterator over the records of a binary file in blocks, see
+    `fromfile_blocks`.
+    """
+    def __init__(self, fname, blocksize, dtype=float, offset=0):
+        self.dtype = np.dtype(dtype)
+        if self.dtype.hasobject or self.dtype.itemsize == 0:
+            raise TypeError("cannot read %s from a file" % self.dtype)
+        if blocksize < 1:
+            raise ValueError("blocksize must be positive")
+        self.blocksize = blocksize
+        self._buffer = np.empty(blocksize, self.dtype)
+        self._tail = asbytes('')
+        _BlockReader.__init__(self, fname, offset)
+
+    def read(self):
+        """
+        Return the next block of records, or an empty array at the end of
+        the file. All the blocks are views of the same buffer.
+        """
+        data = self._buffer.reshape(-1).view(np.uint8)
+        # the bytes of a partial record left over by the last read, the
+        # file is not seeked back as pipes and compressed files can't
+        n = len(self._tail)
+        if n:
+            data[:n] = np.frombuffer(self._tail, np.uint8)
+        # the bz2 files of Python 2 have no readinto
+        readinto = getattr(self._fh, 'readinto', None)
+        while n < len(data):
+            if readinto is not None:
+                got = readinto(data[n:])
+            else:
+                chunk = self._fh.read(len(data) - n)
+                got = len(chunk)
+                if got:
+                    data[n:n + got] = np.frombuffer(chunk, np.uint8)
+            if not got:
+                break
+            n += got
+        count = n // self.dtype.itemsize
+        self._tail = data[count * self.dtype.itemsize:n].tostring()
+        self.offset += count * self.dtype.itemsize
+        return self._buffer[:count]
+
+
+def loadtxt_blocks(fname, blocksize, dtype=float, comments='#',
+                   delimiter=None, skiprows=0, usecols=None, offset=0):
+    """
+    Iterate over the rows of a text file in blocks of `blocksize` rows.
+
+    The rows are parsed like `loadtxt` does without converters, into one
+    buffer which is reused for every block, so that files of any size can
+    be read in constant memory.
+
+    Parameters
+    ----------
+    fname : file or str
+        File or filename to read, filenames ending in ``.gz`` or ``.bz2``
+        are decompressed. The file must be open in binary mode.
+    blocksize : int
+        The number of rows of the blocks, the last one may be shorter.
+    dtype, comments, delimiter, skiprows, usecols
+        As in `loadtxt`, `skiprows` counts from `offset`.
+    offset : int, optional
+        The byte offset in the file to start at, such as the `offset` of
+        a previous reader.
+
+    Returns
+    -------
+    reader : TextBlockReader
+        An iterator over the blocks. The blocks of a homogeneous `dtype`
+        are 2-D arrays with one row per line, those of a structured
+        `dtype` are 1-D. Its ``offset`` attribute is the byte offset of
+        the rows after the last block returned.
+
+    See Also
+    --------
+    loadtxt, fromfile_blocks
+
+    Notes
+    -----
+    Each block overwrites the previous one, so copy those which must
+    outlive the next step of the iteration.
+
+    Examples
+    --------
+    >>> from StringIO import StringIO
+    >>> c = StringIO("0 1\n2 3\n4 5\n")
+    >>> for block in np.loadtxt_blocks(c, 2):
+    ...     print block.sum(axis=0)
+    [ 2.  4.]
+    [ 4.  5.]
+
+    """
+    return TextBlockReader(fname, blocksize, dtype, comments, delimiter,
+                           skiprows, usecols, offset)
+
+def fromfile_blocks(fname, blocksize, dtype=float, offset=0):
+    """
+    Iterate over the records of a binary file in blocks of `blocksize`.
+
+    Like `fromfile` with an empty `sep`, but the records are read into one
+    buffer which is reused for every block, so that files of any size can
+    be read in constant memory.
+
+    Parameters
+    ----------
+    fname : file or str
+        Open file object or filename, filenames ending in ``.gz`` or
+        ``.bz2`` are decompressed.
+    blocksize : int
+        The number of records of the blocks, the last one may be shorter.
+    dtype : data-type, optional
+        Data type of the records.
+    offset : int, optional
+        The byte offset in the file to start at, such as the `offset` of
+        a previous reader.
+
+    Returns
+    -------
+    reader : BinaryBlockReader
+        An iterator over the blocks, 1-D arrays of `dtype`. Its ``offset``
+        attribute is the byte offset of the records after the last block
+        returned.
+
+    See Also
+    --------
+    fromfile, loadtxt_blocks
+
+    Notes
+    -----
+    Each block overwrites the previous one, so copy those which must
+    outlive the next step of the iteration. A partial record at the end
+    of the file is not returned.
+
+    """
+    return BinaryBlockReader(fname, blocksize, dtype, offset)
+
+
 def savetxt(fname, X, fmt='%.18e', delimiter=' ', newline='\n', header='',
         footer='', comments='# '):
     """
@@ -1145,6 +1545,59 @@ def fromregex(file, regexp, dtype):
 
 
 
+def _genfromtxt_fast(fname, dtype, columns, comments, delimiter,
+                     skip_header, usecols, unpack, invalid_raise):
+    """
+    Read the simple cases of genfromtxt with the C text reader, the empty
+    and invalid fields are filled as the default converters would.
+    """
+    own_fhd = False
+    try:
+        if isinstance(fname, basestring):
+            fhd = np.lib._datasource.open(fname, 'rbU')
+            own_fhd = True
+            chunks = _read_blocks(fhd)
+        else:
+            chunks = iter(fname)
+    except TypeError:
+        raise TypeError("fname mustbe a string, filehandle, or generator. "\
+                        "(got %s instead)" % type(fname))
+    if dtype.names is None and not dtype.shape:
+        columns = None
+    try:
+        output, invalid, _ = _loadtxt(chunks, dtype, columns, delimiter,
+                                      comments, skip_header, usecols,
+                                      lines=not own_fhd, loose=True,
+                                      strip=asbytes(' \r\n'))
+    finally:
+        if own_fhd:
+            fhd.close()
+
+    if invalid:
+        if usecols is not None:
+            nbcols = len(usecols)
+        elif columns is None:
+            nbcols = output.shape[1]
+        else:
+            nbcols = len(columns)
+        template = "    Line #%%i (got %%i columns instead of %i)" % nbcols
+        errmsg = [template % (i, nb) for (i, nb) in invalid]
+        errmsg.insert(0, "Some errors were detected !")
+        errmsg = "\n".join(errmsg)
+        if invalid_raise:
+            raise ValueError(errmsg)
+        else:
+            warnings.warn(errmsg, ConversionWarning)
+
+    if len(output) == 0 and not invalid:
+        warnings.warn('genfromtxt: Empty input file: "%s"' % fname)
+        output = np.array([], dtype)
+    output = output.squeeze()
+    if unpack:
+        return output.T
+    return output
+
+
 def genfromtxt(fname, dtype=float, comments='#', delimiter=None,
                skiprows=0, skip_header=0, skip_footer=0, converters=None,
                missing='', missing_values=None, filling_values=None,
@@ -1244,6 +1697,8 @@ def genfromtxt(fname, dtype=float, comments='#', delimiter=None,
       exception is raised).
     * Individual values are not stripped of spaces by default.
       When using a custom converter, make sure the function does remove spaces.
+    * Without names, converters, missing values, masks or boolean fields the
+      file is parsed in C by the reader of `loadtxt`.
 
     References
     ----------
@@ -1311,6 +1766,32 @@ def genfromtxt(fname, dtype=float, comments='#', delimiter=None,
             "(got '%s' instead)"
         raise TypeError(errmsg % type(user_converters))
 
+    # Without names, converters, missing values or masks the C text reader
+    # of loadtxt handles the file
+    if (dtype is not None and names is None and not user_converters and
+            not missing and missing_values is None and
+            filling_values is None and not usemask and not skip_footer and
+            not skiprows and not autostrip and loose and
+            (delimiter is None or isinstance(delimiter, bytes))):
+        fast_dtype = easy_dtype(dtype, defaultfmt=defaultfmt)
+        columns = _text_columns(fast_dtype)
+        if columns is not None and usecols is not None:
+            if (fast_dtype.names is not None or
+                    not isinstance(usecols, (list, tuple)) or
+                    [i for i in usecols if not isinstance(i, int)]):
+                columns = None
+        # The structured arrays truncate the floats of integer fields,
+        # those and the booleans stay with the converters
+        if fast_dtype.names is not None:
+            unsupported = 'biu'
+        else:
+            unsupported = 'b'
+        if (columns is not None and
+                not [dt for (dt, off) in columns if dt.kind in unsupported]):
+            return _genfromtxt_fast(fname, fast_dtype, columns, comments,
+                                    delimiter, skip_header, usecols,
+                                    unpack, invalid_raise)
+
     # Initialize the filehandle, the LineSplitter and the NameValidator
     own_fhd = False
     try:
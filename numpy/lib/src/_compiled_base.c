@@ -7,71 +7,22 @@
 #include "numpy/ufuncobject.h"
 #include "string.h"
 
-static npy_intp
-incr_slot_(double x, double *bins, npy_intp lbins)
-{
-    npy_intp i;
-
-    for ( i = 0; i < lbins; i ++ ) {
-        if ( x < bins [i] ) {
-            return i;
-        }
-    }
-    return lbins;
-}
-
-static npy_intp
-decr_slot_(double x, double * bins, npy_intp lbins)
-{
-    npy_intp i;
-
-    for ( i = lbins - 1; i >= 0; i -- ) {
-        if (x < bins [i]) {
-            return i + 1;
-        }
-    }
-    return 0;
-}
-
-static npy_intp
-incr_slot_right_(double x, double *bins, npy_intp lbins)
-{
-    npy_intp i;
-
-    for ( i = 0; i < lbins; i ++ ) {
-        if ( x <= bins [i] ) {
-            return i;
-        }
-    }
-    return lbins;
-}
-
-static npy_intp
-decr_slot_right_(double x, double * bins, npy_intp lbins)
-{
-    npy_intp i;
-
-    for ( i = lbins - 1; i >= 0; i -- ) {
-        if (x <= bins [i]) {
-            return i + 1;
-        }
-    }
-    return 0;
-}
-
 /**
  * Returns -1 if the array is monotonic decreasing,
  * +1 if the array is monotonic increasing,
  * and 0 if the array is not monotonic.
  */
 static int
-check_array_monotonic(double * a, int lena)
+check_array_monotonic(double * a, npy_intp lena)
 {
-    int i;
+    npy_intp i;
 
-    if (a [0] <= a [1]) {
+    /* the direction is set by the first pair of different elements */
+    for (i = 0; i < lena - 1 && a [i] == a [i + 1]; i ++) {
+    }
+    if (i == lena - 1 || a [i] < a [i + 1]) {
         /* possibly monotonic increasing */
-        for (i = 1; i < lena - 1; i ++) {
+        for (; i < lena - 1; i ++) {
             if (a [i] > a [i + 1]) {
                 return 0;
             }
@@ -80,7 +31,7 @@ check_array_monotonic(double * a, int lena)
     }
     else {
         /* possibly monotonic decreasing */
-        for (i = 1; i < lena - 1; i ++) {
+        for (; i < lena - 1; i ++) {
             if (a [i] < a [i + 1]) {
                 return 0;
             }
@@ -91,34 +42,24 @@ check_array_monotonic(double * a, int lena)
 
 
 
-/* find the index of the maximum element of an integer array */
-static npy_intp
-mxx (npy_intp *i , npy_intp len)
+/* find the minimum and the maximum of an integer array in one pass */
+static void
+minmax(const npy_intp *data, npy_intp data_len, npy_intp *mn, npy_intp *mx)
 {
-    npy_intp mx = 0, max = i[0];
-    npy_intp j;
+    npy_intp min = data[0], max = data[0];
+    npy_intp i;
 
-    for ( j = 1; j < len; j ++ ) {
-        if ( i [j] > max ) {
-            max = i [j];
-            mx = j;
+    for (i = 1; i < data_len; i++) {
+        const npy_intp val = data[i];
+        if (val < min) {
+            min = val;
+        }
+        else if (val > max) {
+            max = val;
         }
     }
-    return mx;
-}
-
-/* find the index of the minimum element of an integer array */
-static npy_intp
-mnx (npy_intp *i , npy_intp len)
-{
-    npy_intp mn = 0, min = i [0];
-    npy_intp j;
-
-    for ( j = 1; j < len; j ++ )
-        if ( i [j] < min )
-            {min = i [j];
-                mn = j;}
-    return mn;
+    *mn = min;
+    *mx = max;
 }
 
 
@@ -141,8 +82,8 @@ arr_bincount(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
     PyArray_Descr *type;
     PyObject *list = NULL, *weight=Py_None, *mlength=Py_None;
     PyArrayObject *lst=NULL, *ans=NULL, *wts=NULL;
-    npy_intp *numbers, *ians, len , mxi, mni, ans_size, minlength;
-    int i;
+    npy_intp *numbers, *ians, len , mx, mn, ans_size, minlength;
+    npy_intp i;
     double *weights , *dans;
     static char *kwlist[] = {"list", "weights", "minlength", NULL};
 
@@ -174,14 +115,13 @@ arr_bincount(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
     }
 
     numbers = (npy_intp *) PyArray_DATA(lst);
-    mxi = mxx(numbers, len);
-    mni = mnx(numbers, len);
-    if (numbers[mni] < 0) {
+    minmax(numbers, len, &mn, &mx);
+    if (mn < 0) {
         PyErr_SetString(PyExc_ValueError,
                 "The first argument of bincount must be non-negative");
         goto fail;
     }
-    ans_size = numbers [mxi] + 1;
+    ans_size = mx + 1;
     if (mlength != Py_None) {
         if (!(minlength = PyArray_PyIntAsIntp(mlength))) {
             goto fail;
@@ -266,7 +206,6 @@ arr_digitize(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
     int m, i;
     static char *kwlist[] = {"x", "bins", "right", NULL};
     PyArray_Descr *type;
-    char bins_non_monotonic = 0;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|i", kwlist, &ox, &obins,
                 &right)) {
@@ -289,19 +228,19 @@ arr_digitize(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
     dx = (double *)PyArray_DATA(ax);
     lbins = PyArray_SIZE(abins);
     dbins = (double *)PyArray_DATA(abins);
-    aret = (PyArrayObject *)PyArray_SimpleNew(1, &lx, NPY_INTP);
-    if (aret == NULL) {
-        goto fail;
-    }
-    iret = (npy_intp *)PyArray_DATA(aret);
 
     if (lx <= 0 || lbins < 0) {
         PyErr_SetString(PyExc_ValueError,
                 "Both x and bins must have non-zero length");
             goto fail;
     }
-    NPY_BEGIN_ALLOW_THREADS;
     if (lbins == 1)  {
+        aret = (PyArrayObject *)PyArray_SimpleNew(1, &lx, NPY_INTP);
+        if (aret == NULL) {
+            goto fail;
+        }
+        iret = (npy_intp *)PyArray_DATA(aret);
+        NPY_BEGIN_ALLOW_THREADS;
         if (right == 0) {
             for (i = 0; i < lx; i++) {
                 if (dx [i] >= dbins[0]) {
@@ -323,50 +262,53 @@ arr_digitize(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
             }
 
         }
+        NPY_END_ALLOW_THREADS;
     }
     else {
+        /*
+         * For increasing bins the index i with bins [i - 1] <= x < bins [i]
+         * is where searchsorted inserts x on the right side, and on the
+         * left side if right == True. Decreasing bins are searched
+         * reversed, the index counts the bins on the other side of x.
+         */
+        NPY_SEARCHSIDE side = right ? NPY_SEARCHLEFT : NPY_SEARCHRIGHT;
+
         m = check_array_monotonic(dbins, lbins);
-        if (right == 0) {
-            if ( m == -1 ) {
-                for ( i = 0; i < lx; i ++ ) {
-                    iret [i] = decr_slot_ ((double)dx[i], dbins, lbins);
-                }
-            }
-            else if ( m == 1 ) {
-                for ( i = 0; i < lx; i ++ ) {
-                    iret [i] = incr_slot_ ((double)dx[i], dbins, lbins);
-                }
-            }
-            else {
-            /* defer PyErr_SetString until after NPY_END_ALLOW_THREADS */
-                bins_non_monotonic = 1;
-            }
+        if (m == 0) {
+            PyErr_SetString(PyExc_ValueError,
+                    "The bins must be monotonically increasing or decreasing");
+            goto fail;
+        }
+        if (m == 1) {
+            aret = (PyArrayObject *)PyArray_SearchSorted(abins,
+                                                (PyObject *)ax, side, NULL);
         }
         else {
-            if ( m == -1 ) {
-                for ( i = 0; i < lx; i ++ ) {
-                    iret [i] = decr_slot_right_ ((double)dx[i], dbins,
-                                                                lbins);
-                }
+            PyArrayObject *rbins;
+            double *drbins;
+
+            rbins = (PyArrayObject *)PyArray_SimpleNew(1, &lbins, NPY_DOUBLE);
+            if (rbins == NULL) {
+                goto fail;
             }
-            else if ( m == 1 ) {
-                for ( i = 0; i < lx; i ++ ) {
-                    iret [i] = incr_slot_right_ ((double)dx[i], dbins,
-                                                               lbins);
-                }
+            drbins = (double *)PyArray_DATA(rbins);
+            for (i = 0; i < lbins; i++) {
+                drbins[i] = dbins[lbins - 1 - i];
             }
-            else {
-            /* defer PyErr_SetString until after NPY_END_ALLOW_THREADS */
-                bins_non_monotonic = 1;
+            aret = (PyArrayObject *)PyArray_SearchSorted(rbins,
+                                                (PyObject *)ax, side, NULL);
+            Py_DECREF(rbins);
+            if (aret == NULL) {
+                goto fail;
+            }
+            iret = (npy_intp *)PyArray_DATA(aret);
+            for (i = 0; i < lx; i++) {
+                iret[i] = lbins - iret[i];
             }
-
         }
-    }
-    NPY_END_ALLOW_THREADS;
-    if (bins_non_monotonic) {
-        PyErr_SetString(PyExc_ValueError,
-                "The bins must be monotonically increasing or decreasing");
-        goto fail;
+        if (aret == NULL) {
+            goto fail;
+        }
     }
     Py_DECREF(ax);
     Py_DECREF(abins);
@@ -34,6 +34,42 @@ class TestAso(TestCase):
 
         assert_array_equal([], unique([]))
 
+    def test_unique_types(self):
+        # the hash tables against sorting
+        def check(a):
+            perm = a.argsort(kind='mergesort')
+            aux = a[perm]
+            flag = np.concatenate(([True], aux[1:] != aux[:-1]))
+            inv = (np.cumsum(flag) - 1)[perm.argsort()]
+            vals, ind0, ind1 = unique(a, return_index=True,
+                                      return_inverse=True)
+            msg = repr(a.dtype)
+            assert_array_equal(vals, aux[flag], msg)
+            assert_array_equal(ind0, perm[flag], msg)
+            assert_array_equal(ind1, inv, msg)
+            assert_array_equal(unique(a), aux[flag], msg)
+
+        rng = np.random.RandomState(3)
+        for dt in np.typecodes['All']:
+            if dt in 'OVMmgG':
+                continue
+            a = (rng.randint(0, 20, 300) - 7).astype(dt)
+            check(a)
+            check(a[::-3])
+            check(a.astype(a.dtype.newbyteorder()))
+        # every element distinct, sorts instead
+        check(rng.permutation(1000))
+
+    def test_unique_nan(self):
+        # NaN is a distinct value each time, -0.0 equals 0.0
+        a = np.array([np.nan, 1, -0.0, np.nan, 0.0, 1])
+        vals, ind0, ind1 = unique(a, return_index=True, return_inverse=True)
+        assert_array_equal(vals, [0, 1, np.nan, np.nan])
+        assert_array_equal(ind0, [2, 1, 0, 3])
+        assert_array_equal(ind1, [2, 1, 0, 3, 0, 1])
+        c = np.array([complex(1, np.nan), 1j, -0.0j, 1j])
+        assert_equal(len(unique(c)), 3)
+
     def test_intersect1d( self ):
         # unique inputs
         a = np.array( [5, 7, 1, 2] )
@@ -148,6 +184,22 @@ class TestAso(TestCase):
 
         assert_array_equal(in1d([], []), [])
 
+    def test_in1d_types(self):
+        # the hash tables against sorting
+        rng = np.random.RandomState(3)
+        for dt in np.typecodes['AllInteger'] + np.typecodes['AllFloat']:
+            a = rng.randint(0, 40, 100).astype(dt)
+            b = rng.randint(0, 40, 50).astype(dt)
+            ec = np.array([x in b.tolist() for x in a.tolist()])
+            assert_array_equal(in1d(a, b), ec, dt)
+        a = np.array([1, 2.5, np.nan, 3, -0.0])
+        b = np.array([2, 3, 0, 5] * 4, dtype=np.int8)
+        assert_array_equal(in1d(a, b), [False, False, False, True, True])
+        assert_array_equal(in1d(a, [np.nan] * 20), [False] * 5)
+        a = np.array(['a', 'bc', 'b', ''])
+        b = np.array(['bc', 'ab', '', 'abc'] * 4)
+        assert_array_equal(in1d(a, b), [False, True, False, True])
+
     def test_in1d_char_array( self ):
         a = np.array(['a', 'b', 'c','d','e','c','e','b'])
         b = np.array(['a','c'])
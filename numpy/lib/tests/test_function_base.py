@@ -452,6 +452,27 @@ class TestDigitize(TestCase):
         bins = np.linspace(x.min(), x.max(), 10)
         assert_(np.all(digitize(x, bins, True) != 10))
 
+    def test_searchsorted(self):
+        # digitize agrees with searchsorted on both sides
+        x = rand(1000) * 12 - 1
+        bins = np.linspace(0, 10, 41)
+        assert_array_equal(digitize(x, bins), bins.searchsorted(x, 'right'))
+        assert_array_equal(digitize(x, bins, True), bins.searchsorted(x))
+        assert_array_equal(digitize(x, bins[::-1]),
+                           41 - bins.searchsorted(x, 'right'))
+        assert_array_equal(digitize(x, bins[::-1], True),
+                           41 - bins.searchsorted(x))
+        # repeated bins
+        x = [0, 1, 1.5, 2, 3]
+        bins = [1, 1, 2, 2]
+        assert_array_equal(digitize(x, bins), [0, 2, 2, 4, 4])
+        assert_array_equal(digitize(x, bins, True), [0, 0, 2, 2, 4])
+        assert_array_equal(digitize(x, bins[::-1]), [4, 2, 2, 0, 0])
+        assert_array_equal(digitize(x, bins[::-1], True), [4, 4, 2, 2, 0])
+
+    def test_non_monotonic(self):
+        assert_raises(ValueError, digitize, [1, 2], [0, 2, 1])
+
 
 class TestUnwrap(TestCase):
     def test_simple(self):
@@ -1250,6 +1271,45 @@ def test_median():
     assert_allclose(np.median(a2, axis=0), [1.5,  2.5,  3.5])
     assert_allclose(np.median(a2, axis=1), [1, 4])
 
+    # odd and even sizes against the sorted middle elements
+    rng = np.random.RandomState(0)
+    for n in [1, 2, 3, 10, 11, 100, 101]:
+        d = rng.rand(n)
+        s = np.sort(d)
+        assert_allclose(np.median(d), (s[(n - 1) // 2] + s[n // 2]) / 2.)
+        c = d.copy()
+        assert_allclose(np.median(c, overwrite_input=True), np.median(d))
+    d = rng.rand(5, 6)
+    c = d.copy()
+    assert_allclose(np.median(c, axis=0, overwrite_input=True),
+                    np.median(d, axis=0))
+    assert_allclose(np.median(d, axis=1), np.mean(np.sort(d)[:, 2:4], axis=1))
+
+    # a matrix has the median of all its elements
+    m = np.matrix([[3., 1, 2], [6, 5, 4]])
+    assert_equal(np.median(m), 3.5)
+    assert_equal(np.median(m.copy(), overwrite_input=True), 3.5)
+    assert_equal(np.median(m, axis=0), [[4.5, 3, 3]])
+
+    # the median of nothing is nan
+    olderr = np.seterr(invalid='ignore')
+    try:
+        assert_(np.isnan(np.median([])))
+        assert_equal(np.median(np.ones((0, 3)), axis=1).shape, (0,))
+    finally:
+        np.seterr(**olderr)
+
+
+def test_percentile_partition():
+    # percentile only partitions around the ranks it needs
+    rng = np.random.RandomState(0)
+    d = rng.rand(101, 3)
+    s = np.sort(d, axis=0)
+    assert_allclose(np.percentile(d, 25, axis=0), s[25])
+    assert_allclose(np.percentile(d, [10, 50.5, 90], axis=0),
+                    [s[10], (s[50] + s[51]) / 2, s[90]])
+    assert_allclose(np.percentile(d, 99.5), np.percentile(d.ravel(), 99.5))
+
 
 class TestAdd_newdoc_ufunc(TestCase):
 
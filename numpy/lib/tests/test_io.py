@@ -167,6 +167,63 @@ class TestSavezLoad(RoundtripTest, TestCase):
         if errors:
             raise AssertionError(errors)
 
+    @np.testing.dec.knownfailureif(sys.platform == 'win32', "Fail on Win32")
+    def test_mmap_members(self):
+        a = np.arange(12.).reshape(3, 4)
+        b = np.asfortranarray(np.arange(6, dtype='>i4').reshape(2, 3))
+        c = np.array(3 + 4j)
+        d = np.array([], float)
+        e = np.array([None, 1], object)
+        fd, tmp = mkstemp(suffix='.npz')
+        os.close(fd)
+        try:
+            np.savez(tmp, a=a, b=b, c=c, d=d, e=e)
+            l = np.load(tmp, mmap_mode='r')
+            try:
+                for name, arr in [('a', a), ('b', b), ('c', c)]:
+                    m = l[name]
+                    assert_(isinstance(m, np.memmap))
+                    assert_equal(m.dtype, arr.dtype)
+                    assert_equal(m.flags.f_contiguous, arr.flags.f_contiguous)
+                    assert_equal(m, arr)
+                # Empty arrays and object arrays are read.
+                assert_(not isinstance(l['d'], np.memmap))
+                assert_equal(l['d'], d)
+                assert_equal(list(l['e']), [None, 1])
+            finally:
+                l.close()
+            # The mapped arrays outlive the archive.
+            assert_equal(m, c)
+
+            # A copy on write mapping leaves the archive as it is.
+            l = np.load(tmp, mmap_mode='c')
+            try:
+                m = l['a']
+                m[0, 0] = 42
+                assert_equal(m[0, 0], 42)
+            finally:
+                l.close()
+            del m
+            l = np.load(tmp)
+            try:
+                assert_equal(l['a'], a)
+            finally:
+                l.close()
+
+            np.savez_compressed(tmp, a=a)
+            l = np.load(tmp, mmap_mode='r')
+            try:
+                assert_(not isinstance(l['a'], np.memmap))
+                assert_equal(l['a'], a)
+            finally:
+                l.close()
+
+            # Writing would leave the checksum of the member wrong.
+            assert_raises(ValueError, np.load, tmp, mmap_mode='w+')
+            assert_raises(ValueError, np.load, tmp, mmap_mode='r+')
+        finally:
+            os.remove(tmp)
+
 class TestSaveTxt(TestCase):
     def test_array(self):
         a = np.array([[1, 2], [3, 4]], float)
@@ -626,6 +683,153 @@ class TestLoadTxt(TestCase):
         res = np.loadtxt(count())
         assert_array_equal(res, np.arange(10))
 
+    def test_large_file(self):
+        # Spans several blocks of the reader, and the thread pool
+        np.random.seed(1234)
+        a = np.random.randn(30000, 4) * 10.0 ** np.arange(-6, 6, 3)
+        f, name = mkstemp()
+        os.close(f)
+        old = np.setnumthreads(4)
+        try:
+            np.savetxt(name, a, fmt='%r', delimiter=',')
+            x = np.loadtxt(name, delimiter=',')
+            assert_array_equal(x, a)
+            x = np.loadtxt(name, delimiter=',', dtype=np.float32,
+                           usecols=(3, 0))
+            assert_array_equal(x, a[:, [3, 0]].astype(np.float32))
+        finally:
+            np.setnumthreads(old)
+            os.unlink(name)
+
+    def test_exact_floats(self):
+        values = ['0.1', '2.5e-300', '1.7976931348623157e308', '-0.0',
+                  '9007199254740993', '1e23', '4.9e-324', '.5', '5.', 'inf',
+                  '123456789012345678901234567890', '0.30000000000000004']
+        c = StringIO(asbytes('\n'.join(values)))
+        x = np.loadtxt(c)
+        assert_equal(x, np.array([float(v) for v in values]))
+
+    def test_usecols_negative_and_repeated(self):
+        c = StringIO(asbytes('1 2 3\n4 5 6\n'))
+        x = np.loadtxt(c, usecols=(-1, 0, -1))
+        assert_array_equal(x, [[3, 1, 3], [6, 4, 6]])
+
+    def test_complex(self):
+        c = StringIO(asbytes('1+2j 3\n-1.5e2-1j 2j\n'))
+        x = np.loadtxt(c, dtype=complex)
+        assert_equal(x, [[1 + 2j, 3], [-150 - 1j, 2j]])
+
+    def test_bad_values(self):
+        c = StringIO(asbytes('1 2\n3 x\n'))
+        try:
+            np.loadtxt(c)
+        except ValueError, e:
+            assert_(str(e).startswith("could not convert string 'x'"))
+            assert_('line 2' in str(e))
+        else:
+            raise AssertionError("loadtxt accepted a bad value")
+        c = StringIO(asbytes('1 2\n3 4 5\n'))
+        assert_raises(ValueError, np.loadtxt, c)
+        c = StringIO(asbytes('1 2\n3\n'))
+        assert_raises(ValueError, np.loadtxt, c, usecols=(1,))
+
+    def test_integer_fractions(self):
+        c = StringIO(asbytes('1.5 1e3\n'))
+        assert_equal(np.loadtxt(c, dtype=np.int32), [1, 1000])
+        c = StringIO(asbytes('1.5 1e3\n'))
+        assert_raises(ValueError, np.loadtxt, c, dtype=np.int64)
+        c = StringIO(asbytes('1.5 0\n'))
+        assert_raises(ValueError, np.loadtxt, c, dtype=bool)
+
+    def test_extra_columns(self):
+        c = StringIO(asbytes('1 2 3\n4 5 6\n'))
+        x = np.loadtxt(c, dtype=[('a', 'i4'), ('b', 'f8')])
+        assert_equal(x['a'], [1, 4])
+        assert_equal(x['b'], [2, 5])
+        c = StringIO(asbytes('1 2 3\n4 5\n'))
+        x = np.loadtxt(c, usecols=(-1,))
+        assert_equal(x, [3, 5])
+
+class TestBlockReaders(TestCase):
+    def setUp(self):
+        f, self.name = mkstemp()
+        os.close(f)
+        self.a = np.arange(3000, dtype=float).reshape(1000, 3) / 7
+
+    def tearDown(self):
+        os.unlink(self.name)
+
+    def test_text_blocks(self):
+        np.savetxt(self.name, self.a, fmt='%r', header='x y z')
+        reader = np.loadtxt_blocks(self.name, 300)
+        blocks = [b.copy() for b in reader]
+        assert_equal([len(b) for b in blocks], [300, 300, 300, 100])
+        assert_array_equal(np.concatenate(blocks), self.a)
+        reader.close()
+
+    def test_text_buffer_reused(self):
+        c = StringIO(asbytes('1 2\n3 4\n5 6\n7 8\n'))
+        reader = np.loadtxt_blocks(c, 2, dtype=int)
+        first = reader.read()
+        second = reader.read()
+        assert_(second.base is first)
+        assert_array_equal(first, [[5, 6], [7, 8]])
+        assert_equal(len(reader.read()), 0)
+
+    def test_text_resume(self):
+        np.savetxt(self.name, self.a, fmt='%r', delimiter=',')
+        reader = np.loadtxt_blocks(self.name, 400, delimiter=',')
+        first = reader.read().copy()
+        reader.close()
+        reader = np.loadtxt_blocks(self.name, 400, delimiter=',',
+                                   offset=reader.offset)
+        rest = np.concatenate([b.copy() for b in reader])
+        reader.close()
+        assert_array_equal(np.concatenate([first, rest]), self.a)
+
+    def test_text_structured(self):
+        np.savetxt(self.name, self.a, fmt='%r')
+        dt = [('x', 'f8'), ('z', 'i4')]
+        reader = np.loadtxt_blocks(self.name, 333, dtype=dt, usecols=(0, 2))
+        b = np.concatenate([b.copy() for b in reader])
+        reader.close()
+        assert_equal(b.dtype, np.dtype(dt))
+        assert_array_equal(b['x'], self.a[:, 0])
+        assert_array_equal(b['z'], self.a[:, 2].astype('i4'))
+
+    def test_binary_blocks(self):
+        self.a.tofile(self.name)
+        f = open(self.name, 'ab')
+        f.write(asbytes('xyz'))
+        f.close()
+        reader = np.fromfile_blocks(self.name, 400, dtype=('f8', 3))
+        blocks = [b.copy() for b in reader]
+        reader.close()
+        assert_equal([len(b) for b in blocks], [400, 400, 200])
+        assert_array_equal(np.concatenate(blocks), self.a)
+        assert_equal(reader.offset, self.a.nbytes)
+        reader = np.fromfile_blocks(self.name, 400, offset=8 * 2990)
+        assert_array_equal(reader.read(), self.a.ravel()[2990:])
+        reader.close()
+
+    def test_binary_compressed(self):
+        import bz2
+        data = self.a.tostring() + asbytes('xyz')
+        for ext, open_ in [('.bz2', bz2.BZ2File), ('.gz', gzip.open)]:
+            name = self.name + ext
+            f = open_(name, 'wb')
+            f.write(data)
+            f.close()
+            try:
+                reader = np.fromfile_blocks(name, 400, dtype=('f8', 3))
+                blocks = [b.copy() for b in reader]
+                reader.close()
+            finally:
+                os.unlink(name)
+            assert_equal([len(b) for b in blocks], [400, 400, 200])
+            assert_array_equal(np.concatenate(blocks), self.a)
+            assert_equal(reader.offset, self.a.nbytes)
+
 class Testfromregex(TestCase):
     def test_record(self):
         c = StringIO()
@@ -1482,6 +1686,34 @@ M   33  21.99
         res = np.genfromtxt(count())
         assert_array_equal(res, np.arange(10))
 
+    def test_missing_fields_as_nan(self):
+        data = StringIO(asbytes('1,,3\n4,5,\n,x,9'))
+        test = np.genfromtxt(data, delimiter=',')
+        control = np.array([[1, np.nan, 3], [4, 5, np.nan],
+                            [np.nan, np.nan, 9]])
+        assert_equal(test, control)
+        data = StringIO(asbytes('1,,3\n4,2.5,6'))
+        test = np.genfromtxt(data, delimiter=',', dtype=int)
+        assert_equal(test, [[1, -1, 3], [4, -1, 6]])
+
+    def test_sized_integer_fractions(self):
+        for dtype, control in [(np.int8, [1, -24]), (np.int32, [1, 1000]),
+                               (np.uint8, [1, 232]), (np.uint32, [1, 1000]),
+                               (np.int64, [-1, -1])]:
+            data = StringIO(asbytes('1.5 1e3'))
+            test = np.genfromtxt(data, dtype=dtype)
+            assert_equal(test.dtype, dtype)
+            assert_equal(test, control)
+
+    def test_invalid_lines_with_comments(self):
+        data = StringIO(asbytes('# header\n1 2\n3 4 5\n6 7\n'))
+        try:
+            np.genfromtxt(data)
+        except ValueError, e:
+            assert_('Line #3 (got 3 columns instead of 2)' in str(e))
+        else:
+            raise AssertionError("genfromtxt accepted a bad line")
+
 
 def test_gzip_load():
     a = np.random.random((5, 5))
@@ -4,6 +4,17 @@ NOTE: This is generated code. Look in Misc/lapack_lite for information on
 */
 #include "f2c.h"
 
+/*
+ * Set by lapack_litemodule.c to hand large products to the gemm of numpy.
+ * Not generated by f2c, keep when regenerating this file.
+ */
+extern int (*npy_lite_dgemm_hook)(char *, char *, integer *, integer *,
+	integer *, void *, void *, integer *, void *, integer *, void *,
+	void *, integer *);
+extern int (*npy_lite_zgemm_hook)(char *, char *, integer *, integer *,
+	integer *, void *, void *, integer *, void *, integer *, void *,
+	void *, integer *);
+
 #ifdef HAVE_CONFIG
 #include "config.h"
 #else
@@ -541,6 +552,18 @@ L60:
 	return 0;
     }
 
+    if (npy_lite_dgemm_hook != 0) {
+	static doublereal one = 1.;
+	switch ((*npy_lite_dgemm_hook)(transa, transb, m, n, k, alpha,
+		&a[a_offset], lda, &b[b_offset], ldb, beta, &c__[c_offset],
+		ldc)) {
+	case 1:
+	    return 0;
+	case -1:
+	    beta = &one;
+	}
+    }
+
 /*     Start the operations. */
 
     if (notb) {
@@ -4973,6 +4996,18 @@ L20:
 	return 0;
     }
 
+    if (npy_lite_zgemm_hook != 0) {
+	static doublecomplex one = {1., 0.};
+	switch ((*npy_lite_zgemm_hook)(transa, transb, m, n, k, alpha,
+		&a[a_offset], lda, &b[b_offset], ldb, beta, &c__[c_offset],
+		ldc)) {
+	case 1:
+	    return 0;
+	case -1:
+	    beta = &one;
+	}
+    }
+
 /*     Start the operations. */
 
     if (notb) {
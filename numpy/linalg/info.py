@@ -22,6 +22,14 @@ Eigenvalues and decompositions:
 - svd             Singular value decomposition of a matrix
 - cholesky        Cholesky decomposition of a matrix
 
+Stacks of matrices:
+
+solve, inv, det, slogdet, cholesky, qr, eig, eigh, eigvals, eigvalsh and
+svd also take arrays of more than two dimensions, as stacks of matrices in
+the last two dimensions that broadcast like the arguments of a ufunc. A loop in
+C works through the stack; it raises LinAlgError for the whole stack if a
+single matrix fails.
+
 Tensor operations:
 
 - tensorsolve     Solve a linear tensor equation
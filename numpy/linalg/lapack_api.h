@@ -0,0 +1,67 @@
+#ifndef _NPY_LAPACK_API_H_
+#define _NPY_LAPACK_API_H_
+
+/*
+ * The LAPACK routines lapack_lite is linked with, lapack_lite itself or an
+ * optimized library. The _umath_linalg module finds them through the
+ * _LAPACK capsule of lapack_lite, which holds a pointer to this struct.
+ */
+
+typedef struct { float r, i; } f2c_complex;
+typedef struct { double r, i; } f2c_doublecomplex;
+
+typedef struct {
+    int (*dgetrf)(int *m, int *n, double a[], int *lda, int ipiv[],
+                  int *info);
+    int (*zgetrf)(int *m, int *n, f2c_doublecomplex a[], int *lda,
+                  int ipiv[], int *info);
+    int (*dgesv)(int *n, int *nrhs, double a[], int *lda, int ipiv[],
+                 double b[], int *ldb, int *info);
+    int (*zgesv)(int *n, int *nrhs, f2c_doublecomplex a[], int *lda,
+                 int ipiv[], f2c_doublecomplex b[], int *ldb, int *info);
+    int (*dpotrf)(char *uplo, int *n, double a[], int *lda, int *info);
+    int (*zpotrf)(char *uplo, int *n, f2c_doublecomplex a[], int *lda,
+                  int *info);
+    int (*dsyevd)(char *jobz, char *uplo, int *n, double a[], int *lda,
+                  double w[], double work[], int *lwork, int iwork[],
+                  int *liwork, int *info);
+    int (*zheevd)(char *jobz, char *uplo, int *n, f2c_doublecomplex a[],
+                  int *lda, double w[], f2c_doublecomplex work[],
+                  int *lwork, double rwork[], int *lrwork, int iwork[],
+                  int *liwork, int *info);
+    int (*dgeev)(char *jobvl, char *jobvr, int *n, double a[], int *lda,
+                 double wr[], double wi[], double vl[], int *ldvl,
+                 double vr[], int *ldvr, double work[], int *lwork,
+                 int *info);
+    int (*zgeev)(char *jobvl, char *jobvr, int *n, f2c_doublecomplex a[],
+                 int *lda, f2c_doublecomplex w[], f2c_doublecomplex vl[],
+                 int *ldvl, f2c_doublecomplex vr[], int *ldvr,
+                 f2c_doublecomplex work[], int *lwork, double rwork[],
+                 int *info);
+    int (*dgesdd)(char *jobz, int *m, int *n, double a[], int *lda,
+                  double s[], double u[], int *ldu, double vt[], int *ldvt,
+                  double work[], int *lwork, int iwork[], int *info);
+    int (*zgesdd)(char *jobz, int *m, int *n, f2c_doublecomplex a[],
+                  int *lda, double s[], f2c_doublecomplex u[], int *ldu,
+                  f2c_doublecomplex vt[], int *ldvt,
+                  f2c_doublecomplex work[], int *lwork, double rwork[],
+                  int iwork[], int *info);
+    int (*dgeqrf)(int *m, int *n, double a[], int *lda, double tau[],
+                  double work[], int *lwork, int *info);
+    int (*zgeqrf)(int *m, int *n, f2c_doublecomplex a[], int *lda,
+                  f2c_doublecomplex tau[], f2c_doublecomplex work[],
+                  int *lwork, int *info);
+    int (*dorgqr)(int *m, int *n, int *k, double a[], int *lda,
+                  double tau[], double work[], int *lwork, int *info);
+    int (*zungqr)(int *m, int *n, int *k, f2c_doublecomplex a[], int *lda,
+                  f2c_doublecomplex tau[], f2c_doublecomplex work[],
+                  int *lwork, int *info);
+    /*
+     * Called with the GIL held around the calls of the routines above,
+     * which the bundled lapack_lite may only run in one thread at a time.
+     */
+    void (*acquire)(void);
+    void (*release)(void);
+} npy_lapack_api;
+
+#endif
@@ -6,6 +6,9 @@ More modifications by Jeff Whitaker
 
 #include "Python.h"
 #include "numpy/arrayobject.h"
+#include "numpy/npy_3kcompat.h"
+#include "npy_gemm.h"
+#include "lapack_api.h"
 
 #ifdef NO_APPEND_FORTRAN
 # define FNAME(x) x
@@ -13,8 +16,6 @@ More modifications by Jeff Whitaker
 # define FNAME(x) x##_
 #endif
 
-typedef struct { float r, i; } f2c_complex;
-typedef struct { double r, i; } f2c_doublecomplex;
 /* typedef long int (*L_fp)(); */
 
 extern int FNAME(dgeev)(char *jobvl, char *jobvr, int *n,
@@ -95,6 +96,216 @@ extern int FNAME(zungqr)(int *m, int *n, int *k, f2c_doublecomplex a[],
 
 static PyObject *LapackError;
 
+/*
+ * The f2c'd routines of the bundled lapack_lite keep their locals in static
+ * storage, so that only one thread at a time may run them. The lock is
+ * never waited for with the GIL held, since xerbla_ takes the GIL while
+ * the lock is held.
+ */
+#if defined(NPY_LAPACK_LITE_BUNDLED) && NPY_ALLOW_THREADS
+#include "pythread.h"
+
+static PyThread_type_lock lite_lock = NULL;
+
+#define LITE_LOCK PyThread_acquire_lock(lite_lock, WAIT_LOCK)
+#define LITE_UNLOCK PyThread_release_lock(lite_lock)
+#else
+#define LITE_LOCK
+#define LITE_UNLOCK
+#endif
+
+/*
+ * Around the calls of the wrappers, which run without the GIL. xerbla_
+ * reports an illegal argument with an exception, which is returned.
+ */
+#define LITE_BEGIN_CALL NPY_BEGIN_ALLOW_THREADS LITE_LOCK;
+#define LITE_END_CALL LITE_UNLOCK; NPY_END_ALLOW_THREADS \
+        if (PyErr_Occurred()) { \
+            return NULL; \
+        }
+
+/* For the users of the _LAPACK capsule, which hold the GIL */
+static void
+lite_acquire(void)
+{
+#if defined(NPY_LAPACK_LITE_BUNDLED) && NPY_ALLOW_THREADS
+    if (!PyThread_acquire_lock(lite_lock, NOWAIT_LOCK)) {
+        NPY_BEGIN_ALLOW_THREADS
+        LITE_LOCK;
+        NPY_END_ALLOW_THREADS
+    }
+#endif
+}
+
+static void
+lite_release(void)
+{
+    LITE_UNLOCK;
+}
+
+static npy_lapack_api lapack_api = {
+    &FNAME(dgetrf), &FNAME(zgetrf), &FNAME(dgesv), &FNAME(zgesv),
+    &FNAME(dpotrf), &FNAME(zpotrf), &FNAME(dsyevd), &FNAME(zheevd),
+    &FNAME(dgeev), &FNAME(zgeev), &FNAME(dgesdd), &FNAME(zgesdd),
+    &FNAME(dgeqrf), &FNAME(zgeqrf), &FNAME(dorgqr), &FNAME(zungqr),
+    &lite_acquire, &lite_release};
+
+/*
+ * The products of at least this many multiplications in the dgemm_ and
+ * zgemm_ of blas_lite.c are done by the gemm of numpy.core.multiarray.
+ */
+#define LITE_GEMM_MIN_WORK 4096
+
+static npy_gemm_api *lite_gemm_api = NULL;
+static npy_ufunc_threads_api *lite_threads_api = NULL;
+
+/*
+ * The gemm of the column major arrays of BLAS, without the checks and
+ * quick returns done by the caller and with alpha nonzero. Returns 1 when
+ * done, 0 when C is untouched and -1 when C has been scaled by beta but the
+ * product still needs adding.
+ */
+static int
+lite_gemm(int typenum, char *transa, char *transb, int *m, int *n, int *k,
+          void *alpha, void *a, int *lda, void *b, int *ldb,
+          void *beta, void *c, int *ldc)
+{
+    npy_intp size = typenum == NPY_CDOUBLE ? 16 : 8;
+    npy_intp i, j, astride, bstride, *offsets;
+    int notb = *transb == 'N' || *transb == 'n';
+    double *cd = c;
+
+    if ((npy_intp)*m * *n * *k < LITE_GEMM_MIN_WORK || *n < 2) {
+        return 0;
+    }
+    offsets = malloc((*m + *n)*sizeof(npy_intp));
+    if (offsets == NULL) {
+        return 0;
+    }
+    if (*transa == 'N' || *transa == 'n') {
+        for (i = 0; i < *m; i++) {
+            offsets[i] = i*size;
+        }
+        astride = *lda*size;
+    }
+    else {
+        for (i = 0; i < *m; i++) {
+            offsets[i] = i * *lda*size;
+        }
+        astride = size;
+    }
+    for (j = 0; j < *n; j++) {
+        offsets[*m + j] = notb ? j * *ldb*size : j*size;
+    }
+    bstride = notb ? size : *ldb*size;
+
+    /* C = beta*C, exactly zero for a zero beta as BLAS does */
+    for (j = 0; j < *n; j++) {
+        double *col = cd + j * *ldc*(size/8);
+
+        if (typenum == NPY_DOUBLE) {
+            double br = *(double *)beta;
+
+            if (br == 0.) {
+                memset(col, 0, *m*size);
+            }
+            else if (br != 1.) {
+                for (i = 0; i < *m; i++) {
+                    col[i] *= br;
+                }
+            }
+        }
+        else {
+            double br = ((double *)beta)[0], bi = ((double *)beta)[1];
+
+            if (br == 0. && bi == 0.) {
+                memset(col, 0, *m*size);
+            }
+            else if (br != 1. || bi != 0.) {
+                for (i = 0; i < *m; i++) {
+                    double re = col[2*i], im = col[2*i + 1];
+
+                    col[2*i] = br*re - bi*im;
+                    col[2*i + 1] = br*im + bi*re;
+                }
+            }
+        }
+    }
+
+    i = lite_gemm_api->gemm(typenum, *m, *n, *k, alpha,
+                            a, offsets, astride,
+                            *transa == 'C' || *transa == 'c',
+                            b, offsets + *m, bstride,
+                            *transb == 'C' || *transb == 'c',
+                            c, size, *ldc*size, lite_threads_api);
+    free(offsets);
+    return i == 0 ? 1 : -1;
+}
+
+static int
+lite_dgemm(char *transa, char *transb, int *m, int *n, int *k,
+           void *alpha, void *a, int *lda, void *b, int *ldb,
+           void *beta, void *c, int *ldc)
+{
+    return lite_gemm(NPY_DOUBLE, transa, transb, m, n, k,
+                     alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+static int
+lite_zgemm(char *transa, char *transb, int *m, int *n, int *k,
+           void *alpha, void *a, int *lda, void *b, int *ldb,
+           void *beta, void *c, int *ldc)
+{
+    return lite_gemm(NPY_CDOUBLE, transa, transb, m, n, k,
+                     alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+/* Used by blas_lite.c, they stay NULL with an optimized lapack */
+int (*npy_lite_dgemm_hook)(char *, char *, int *, int *, int *, void *,
+                           void *, int *, void *, int *, void *, void *,
+                           int *) = NULL;
+int (*npy_lite_zgemm_hook)(char *, char *, int *, int *, int *, void *,
+                           void *, int *, void *, int *, void *, void *,
+                           int *) = NULL;
+
+/* Finds the gemm of numpy.core.multiarray and the threads of umath */
+static void
+lite_gemm_setup(void)
+{
+    static const char *names[2][2] = {
+        {"numpy.core.multiarray", "_GEMM"},
+        {"numpy.core.umath", "_UFUNC_THREADS"}};
+    void *apis[2] = {NULL, NULL};
+    int i;
+
+    for (i = 0; i < 2; i++) {
+        PyObject *mod, *capsule;
+
+        mod = PyImport_ImportModule(names[i][0]);
+        if (mod == NULL) {
+            PyErr_Clear();
+            return;
+        }
+        capsule = PyObject_GetAttrString(mod, names[i][1]);
+        Py_DECREF(mod);
+        if (capsule == NULL) {
+            PyErr_Clear();
+            return;
+        }
+        if (NpyCapsule_Check(capsule)) {
+            apis[i] = NpyCapsule_AsVoidPtr(capsule);
+        }
+        Py_DECREF(capsule);
+    }
+    if (apis[0] == NULL) {
+        return;
+    }
+    lite_gemm_api = apis[0];
+    lite_threads_api = apis[1];
+    npy_lite_dgemm_hook = &lite_dgemm;
+    npy_lite_zgemm_hook = &lite_zgemm;
+}
+
 #define TRY(E) if (!(E)) return NULL
 
 static int
@@ -167,10 +378,12 @@ lapack_lite_dgeev(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(vr,NPY_DOUBLE,"vr","NPY_DOUBLE","dgeev"));
     TRY(check_object(work,NPY_DOUBLE,"work","NPY_DOUBLE","dgeev"));
 
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
             FNAME(dgeev)(&jobvl,&jobvr,&n,DDATA(a),&lda,DDATA(wr),DDATA(wi),
                          DDATA(vl),&ldvl,DDATA(vr),&ldvr,DDATA(work),&lwork,
                          &info);
+    LITE_END_CALL
 
     return Py_BuildValue("{s:i,s:c,s:c,s:i,s:i,s:i,s:i,s:i,s:i}","dgeev_",
                          lapack_lite_status__,"jobvl",jobvl,"jobvr",jobvr,
@@ -251,9 +464,11 @@ lapack_lite_dsyevd(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(work,NPY_DOUBLE,"work","NPY_DOUBLE","dsyevd"));
     TRY(check_object(iwork,NPY_INT,"iwork","NPY_INT","dsyevd"));
 
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
             FNAME(dsyevd)(&jobz,&uplo,&n,DDATA(a),&lda,DDATA(w),DDATA(work),
                           &lwork,IDATA(iwork),&liwork,&info);
+    LITE_END_CALL
 
     return Py_BuildValue("{s:i,s:c,s:c,s:i,s:i,s:i,s:i,s:i}","dsyevd_",
                          lapack_lite_status__,"jobz",jobz,"uplo",uplo,
@@ -338,9 +553,11 @@ lapack_lite_zheevd(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(w,NPY_DOUBLE,"rwork","NPY_DOUBLE","zheevd"));
     TRY(check_object(iwork,NPY_INT,"iwork","NPY_INT","zheevd"));
 
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
     FNAME(zheevd)(&jobz,&uplo,&n,ZDATA(a),&lda,DDATA(w),ZDATA(work),
                   &lwork,DDATA(rwork),&lrwork,IDATA(iwork),&liwork,&info);
+    LITE_END_CALL
 
     return Py_BuildValue("{s:i,s:c,s:c,s:i,s:i,s:i,s:i,s:i,s:i}","zheevd_",
                          lapack_lite_status__,"jobz",jobz,"uplo",uplo,"n",n,
@@ -376,10 +593,12 @@ lapack_lite_dgelsd(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(work,NPY_DOUBLE,"work","NPY_DOUBLE","dgelsd"));
     TRY(check_object(iwork,NPY_INT,"iwork","NPY_INT","dgelsd"));
 
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
             FNAME(dgelsd)(&m,&n,&nrhs,DDATA(a),&lda,DDATA(b),&ldb,
                           DDATA(s),&rcond,&rank,DDATA(work),&lwork,
                           IDATA(iwork),&info);
+    LITE_END_CALL
 
     return Py_BuildValue("{s:i,s:i,s:i,s:i,s:i,s:i,s:d,s:i,s:i,s:i}","dgelsd_",
                          lapack_lite_status__,"m",m,"n",n,"nrhs",nrhs,
@@ -405,8 +624,10 @@ lapack_lite_dgesv(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(ipiv,NPY_INT,"ipiv","NPY_INT","dgesv"));
     TRY(check_object(b,NPY_DOUBLE,"b","NPY_DOUBLE","dgesv"));
 
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
     FNAME(dgesv)(&n,&nrhs,DDATA(a),&lda,IDATA(ipiv),DDATA(b),&ldb,&info);
+    LITE_END_CALL
 
     return Py_BuildValue("{s:i,s:i,s:i,s:i,s:i,s:i}","dgesv_",
                          lapack_lite_status__,"n",n,"nrhs",nrhs,"lda",lda,
@@ -442,10 +663,12 @@ lapack_lite_dgesdd(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(work,NPY_DOUBLE,"work","NPY_DOUBLE","dgesdd"));
     TRY(check_object(iwork,NPY_INT,"iwork","NPY_INT","dgesdd"));
 
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
             FNAME(dgesdd)(&jobz,&m,&n,DDATA(a),&lda,DDATA(s),DDATA(u),&ldu,
                           DDATA(vt),&ldvt,DDATA(work),&lwork,IDATA(iwork),
                           &info);
+    LITE_END_CALL
 
     if (info == 0 && lwork == -1) {
             /* We need to check the result because
@@ -494,8 +717,10 @@ lapack_lite_dgetrf(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(a,NPY_DOUBLE,"a","NPY_DOUBLE","dgetrf"));
     TRY(check_object(ipiv,NPY_INT,"ipiv","NPY_INT","dgetrf"));
 
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
             FNAME(dgetrf)(&m,&n,DDATA(a),&lda,IDATA(ipiv),&info);
+    LITE_END_CALL
 
     return Py_BuildValue("{s:i,s:i,s:i,s:i,s:i}","dgetrf_",lapack_lite_status__,
                          "m",m,"n",n,"lda",lda,"info",info);
@@ -514,8 +739,10 @@ lapack_lite_dpotrf(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(PyArg_ParseTuple(args,"ciOii",&uplo,&n,&a,&lda,&info));
     TRY(check_object(a,NPY_DOUBLE,"a","NPY_DOUBLE","dpotrf"));
 
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
             FNAME(dpotrf)(&uplo,&n,DDATA(a),&lda,&info);
+    LITE_END_CALL
 
     return Py_BuildValue("{s:i,s:i,s:i,s:i}","dpotrf_",lapack_lite_status__,
                          "n",n,"lda",lda,"info",info);
@@ -537,9 +764,11 @@ lapack_lite_dgeqrf(PyObject *NPY_UNUSED(self), PyObject *args)
         TRY(check_object(tau,NPY_DOUBLE,"tau","NPY_DOUBLE","dgeqrf"));
         TRY(check_object(work,NPY_DOUBLE,"work","NPY_DOUBLE","dgeqrf"));
 
+        LITE_BEGIN_CALL
         lapack_lite_status__ = \
                 FNAME(dgeqrf)(&m, &n, DDATA(a), &lda, DDATA(tau),
                               DDATA(work), &lwork, &info);
+        LITE_END_CALL
 
         return Py_BuildValue("{s:i,s:i,s:i,s:i,s:i,s:i}","dgeqrf_",
                              lapack_lite_status__,"m",m,"n",n,"lda",lda,
@@ -560,8 +789,10 @@ lapack_lite_dorgqr(PyObject *NPY_UNUSED(self), PyObject *args)
         TRY(check_object(a,NPY_DOUBLE,"a","NPY_DOUBLE","dorgqr"));
         TRY(check_object(tau,NPY_DOUBLE,"tau","NPY_DOUBLE","dorgqr"));
         TRY(check_object(work,NPY_DOUBLE,"work","NPY_DOUBLE","dorgqr"));
+        LITE_BEGIN_CALL
         lapack_lite_status__ = \
         FNAME(dorgqr)(&m, &n, &k, DDATA(a), &lda, DDATA(tau), DDATA(work), &lwork, &info);
+        LITE_END_CALL
 
         return Py_BuildValue("{s:i,s:i}","dorgqr_",lapack_lite_status__,
                              "info",info);
@@ -597,10 +828,12 @@ lapack_lite_zgeev(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(work,NPY_CDOUBLE,"work","NPY_CDOUBLE","zgeev"));
     TRY(check_object(rwork,NPY_DOUBLE,"rwork","NPY_DOUBLE","zgeev"));
 
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
             FNAME(zgeev)(&jobvl,&jobvr,&n,ZDATA(a),&lda,ZDATA(w),ZDATA(vl),
                          &ldvl,ZDATA(vr),&ldvr,ZDATA(work),&lwork,
                          DDATA(rwork),&info);
+    LITE_END_CALL
 
     return Py_BuildValue("{s:i,s:c,s:c,s:i,s:i,s:i,s:i,s:i,s:i}","zgeev_",
                          lapack_lite_status__,"jobvl",jobvl,"jobvr",jobvr,
@@ -638,9 +871,11 @@ lapack_lite_zgelsd(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(rwork,NPY_DOUBLE,"rwork","NPY_DOUBLE","zgelsd"));
     TRY(check_object(iwork,NPY_INT,"iwork","NPY_INT","zgelsd"));
 
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
     FNAME(zgelsd)(&m,&n,&nrhs,ZDATA(a),&lda,ZDATA(b),&ldb,DDATA(s),&rcond,
                   &rank,ZDATA(work),&lwork,DDATA(rwork),IDATA(iwork),&info);
+    LITE_END_CALL
 
     return Py_BuildValue("{s:i,s:i,s:i,s:i,s:i,s:i,s:i,s:i,s:i}","zgelsd_",
                          lapack_lite_status__,"m",m,"n",n,"nrhs",nrhs,"lda",lda,
@@ -665,8 +900,10 @@ lapack_lite_zgesv(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(ipiv,NPY_INT,"ipiv","NPY_INT","zgesv"));
     TRY(check_object(b,NPY_CDOUBLE,"b","NPY_CDOUBLE","zgesv"));
 
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
     FNAME(zgesv)(&n,&nrhs,ZDATA(a),&lda,IDATA(ipiv),ZDATA(b),&ldb,&info);
+    LITE_END_CALL
 
     return Py_BuildValue("{s:i,s:i,s:i,s:i,s:i,s:i}","zgesv_",
                          lapack_lite_status__,"n",n,"nrhs",nrhs,"lda",lda,
@@ -704,10 +941,12 @@ lapack_lite_zgesdd(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(rwork,NPY_DOUBLE,"rwork","NPY_DOUBLE","zgesdd"));
     TRY(check_object(iwork,NPY_INT,"iwork","NPY_INT","zgesdd"));
 
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
     FNAME(zgesdd)(&jobz,&m,&n,ZDATA(a),&lda,DDATA(s),ZDATA(u),&ldu,
                   ZDATA(vt),&ldvt,ZDATA(work),&lwork,DDATA(rwork),
                   IDATA(iwork),&info);
+    LITE_END_CALL
 
     return Py_BuildValue("{s:i,s:c,s:i,s:i,s:i,s:i,s:i,s:i,s:i}","zgesdd_",
                          lapack_lite_status__,"jobz",jobz,"m",m,"n",n,
@@ -730,8 +969,10 @@ lapack_lite_zgetrf(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(a,NPY_CDOUBLE,"a","NPY_CDOUBLE","zgetrf"));
     TRY(check_object(ipiv,NPY_INT,"ipiv","NPY_INT","zgetrf"));
 
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
     FNAME(zgetrf)(&m,&n,ZDATA(a),&lda,IDATA(ipiv),&info);
+    LITE_END_CALL
 
     return Py_BuildValue("{s:i,s:i,s:i,s:i,s:i}","zgetrf_",
                          lapack_lite_status__,"m",m,"n",n,"lda",lda,"info",info);
@@ -749,8 +990,10 @@ lapack_lite_zpotrf(PyObject *NPY_UNUSED(self), PyObject *args)
 
     TRY(PyArg_ParseTuple(args,"ciOii",&uplo,&n,&a,&lda,&info));
     TRY(check_object(a,NPY_CDOUBLE,"a","NPY_CDOUBLE","zpotrf"));
+    LITE_BEGIN_CALL
     lapack_lite_status__ = \
     FNAME(zpotrf)(&uplo,&n,ZDATA(a),&lda,&info);
+    LITE_END_CALL
 
     return Py_BuildValue("{s:i,s:i,s:i,s:i}","zpotrf_",
                          lapack_lite_status__,"n",n,"lda",lda,"info",info);
@@ -772,8 +1015,10 @@ lapack_lite_zgeqrf(PyObject *NPY_UNUSED(self), PyObject *args)
         TRY(check_object(tau,NPY_CDOUBLE,"tau","NPY_CDOUBLE","zgeqrf"));
         TRY(check_object(work,NPY_CDOUBLE,"work","NPY_CDOUBLE","zgeqrf"));
 
+        LITE_BEGIN_CALL
         lapack_lite_status__ = \
         FNAME(zgeqrf)(&m, &n, ZDATA(a), &lda, ZDATA(tau), ZDATA(work), &lwork, &info);
+        LITE_END_CALL
 
         return Py_BuildValue("{s:i,s:i,s:i,s:i,s:i,s:i}","zgeqrf_",lapack_lite_status__,"m",m,"n",n,"lda",lda,"lwork",lwork,"info",info);
 }
@@ -794,9 +1039,11 @@ lapack_lite_zungqr(PyObject *NPY_UNUSED(self), PyObject *args)
         TRY(check_object(work,NPY_CDOUBLE,"work","NPY_CDOUBLE","zungqr"));
 
 
+        LITE_BEGIN_CALL
         lapack_lite_status__ = \
         FNAME(zungqr)(&m, &n, &k, ZDATA(a), &lda, ZDATA(tau), ZDATA(work),
                       &lwork, &info);
+        LITE_END_CALL
 
         return Py_BuildValue("{s:i,s:i}","zungqr_",lapack_lite_status__,
                              "info",info);
@@ -855,7 +1102,7 @@ PyMODINIT_FUNC
 initlapack_lite(void)
 #endif
 {
-    PyObject *m,*d;
+    PyObject *m, *d, *s;
 #if PY_MAJOR_VERSION >= 3
     m = PyModule_Create(&moduledef);
 #else
@@ -870,6 +1117,17 @@ initlapack_lite(void)
     d = PyModule_GetDict(m);
     LapackError = PyErr_NewException("lapack_lite.LapackError", NULL, NULL);
     PyDict_SetItemString(d, "LapackError", LapackError);
+#if defined(NPY_LAPACK_LITE_BUNDLED) && NPY_ALLOW_THREADS
+    lite_lock = PyThread_allocate_lock();
+    if (lite_lock == NULL) {
+        PyErr_NoMemory();
+        return RETVAL;
+    }
+#endif
+    s = NpyCapsule_FromVoidPtr((void *)&lapack_api, NULL);
+    PyDict_SetItemString(d, "_LAPACK", s);
+    Py_DECREF(s);
+    lite_gemm_setup();
 
     return RETVAL;
 }
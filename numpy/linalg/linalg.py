@@ -18,12 +18,17 @@ from numpy.core import array, asarray, zeros, empty, transpose, \
         intc, single, double, csingle, cdouble, inexact, complexfloating, \
         newaxis, ravel, all, Inf, dot, add, multiply, identity, sqrt, \
         maximum, flatnonzero, diagonal, arange, fastCopyAndTranspose, sum, \
-        isfinite, size, finfo, absolute, log, exp
+        isfinite, size, finfo, absolute, log, exp, seterr, seterrcall
 from numpy.lib import triu
-from numpy.linalg import lapack_lite
+from numpy.linalg import lapack_lite, _umath_linalg
 from numpy.matrixlib.defmatrix import matrix_power
 from numpy.compat import asbytes
 
+try:
+    import threading
+except ImportError:
+    import dummy_threading as threading
+
 # For Python2/3 compatibility
 _N = asbytes('N')
 _V = asbytes('V')
@@ -33,6 +38,13 @@ _L = asbytes('L')
 
 fortran_int = intc
 
+# The workspace of the LAPACK routines, kept by each thread for its next
+# calls unless larger than _workspace_max_bytes, and the work sizes found
+# by their workspace queries
+_workspace_max_bytes = 1 << 24
+_lwork_max_keys = 256
+_lapack_local = threading.local()
+
 # Error object
 class LinAlgError(Exception):
     """
@@ -164,11 +176,77 @@ def _assertFinite(*arrays):
         if not (isfinite(a).all()):
             raise LinAlgError("Array must not contain infs or NaNs")
 
+def _workspace(name, t, size):
+    """
+    Return a work array of at least `size` items of type `t` for the
+    LAPACK routine `name`, reusing the one of the previous call in the
+    thread. It is left uninitialized.
+    """
+    cache = _lapack_local.__dict__.setdefault('workspace', {})
+    key = (name, t)
+    work = cache.get(key)
+    if work is None or work.shape[0] < size:
+        work = empty((max(size, 1),), t)
+        if work.nbytes <= _workspace_max_bytes:
+            cache[key] = work
+    return work
+
+def _lwork(key, query):
+    """
+    Return the work sizes query() finds with a workspace query, remembered
+    by the thread under `key`, which is the routine with the arguments
+    that decide them.
+    """
+    cache = _lapack_local.__dict__.setdefault('lwork', {})
+    sizes = cache.get(key)
+    if sizes is None:
+        sizes = query()
+        if len(cache) >= _lwork_max_keys:
+            cache.clear()
+        cache[key] = sizes
+    return sizes
+
 def _assertNonEmpty(*arrays):
     for a in arrays:
         if size(a) == 0:
             raise LinAlgError("Arrays cannot be empty")
 
+def _isStacked(*arrays):
+    for a in arrays:
+        if len(a.shape) > 2:
+            return True
+    return False
+
+def _assertStackedSquareness(*arrays):
+    for a in arrays:
+        if len(a.shape) < 2:
+            raise LinAlgError('%d-dimensional array given. Array must be '
+                    'at least two-dimensional' % len(a.shape))
+        if a.shape[-1] != a.shape[-2]:
+            raise LinAlgError('Last 2 dimensions of the array must be square')
+
+def _asType(a, t):
+    if a.dtype != t:
+        a = a.astype(t)
+    return a
+
+def _callStacked(gufunc, message, *args):
+    """
+    Call a gufunc of _umath_linalg on stacks of matrices. The matrices the
+    gufunc fails on set the invalid floating point flag, which raises
+    LinAlgError(message).
+    """
+    def raise_error(err, flag):
+        raise LinAlgError(message)
+    olderr = seterr(invalid='call', over='ignore', divide='ignore',
+                    under='ignore')
+    oldcall = seterrcall(raise_error)
+    try:
+        return gufunc(*args)
+    finally:
+        seterrcall(oldcall)
+        seterr(**olderr)
+
 
 # Linear equations
 
@@ -305,6 +383,16 @@ def solve(a, b):
     """
     a, _ = _makearray(a)
     b, wrap = _makearray(b)
+    if _isStacked(a, b):
+        _assertStackedSquareness(a)
+        t, result_t = _commonType(a, b)
+        # b is a single vector, or a stack of vectors matching that of a
+        if len(b.shape) == 1 or b.shape == a.shape[:-1]:
+            gufunc = _umath_linalg.solve1
+        else:
+            gufunc = _umath_linalg.solve
+        r = _callStacked(gufunc, 'Singular matrix', a, b)
+        return wrap(_asType(r, result_t))
     one_eq = len(b.shape) == 1
     if one_eq:
         b = b[:, newaxis]
@@ -442,6 +530,11 @@ def inv(a):
 
     """
     a, wrap = _makearray(a)
+    if _isStacked(a):
+        _assertStackedSquareness(a)
+        t, result_t = _commonType(a)
+        r = _callStacked(_umath_linalg.inv, 'Singular matrix', a)
+        return wrap(_asType(r, result_t))
     return wrap(solve(a, identity(a.shape[0], dtype=a.dtype)))
 
 
@@ -514,6 +607,13 @@ def cholesky(a):
 
     """
     a, wrap = _makearray(a)
+    if _isStacked(a):
+        _assertStackedSquareness(a)
+        t, result_t = _commonType(a)
+        r = _callStacked(_umath_linalg.cholesky_lo,
+                         'Matrix is not positive definite - '
+                         'Cholesky decomposition cannot be computed', a)
+        return wrap(_asType(r, result_t))
     _assertRank2(a)
     _assertSquareness(a)
     t, result_t = _commonType(a)
@@ -624,6 +724,26 @@ def qr(a, mode='full'):
 
     """
     a, wrap = _makearray(a)
+    if _isStacked(a):
+        _assertNonEmpty(a)
+        m, n = a.shape[-2:]
+        t, result_t = _commonType(a)
+        message = 'QR decomposition failed'
+        if mode[0] == 'e':
+            return _asType(_callStacked(_umath_linalg.qr_e, message, a),
+                           result_t)
+        if mode[0] == 'r':
+            if m <= n:
+                gufunc = _umath_linalg.qr_r_m
+            else:
+                gufunc = _umath_linalg.qr_r_n
+            return _asType(_callStacked(gufunc, message, a), result_t)
+        if m <= n:
+            gufunc = _umath_linalg.qr_m
+        else:
+            gufunc = _umath_linalg.qr_n
+        q, r = _callStacked(gufunc, message, a)
+        return wrap(_asType(q, result_t)), wrap(_asType(r, result_t))
     _assertRank2(a)
     _assertNonEmpty(a)
     m, n = a.shape
@@ -640,15 +760,17 @@ def qr(a, mode='full'):
         routine_name = 'dgeqrf'
 
     # calculate optimal size of work data 'work'
-    lwork = 1
-    work = zeros((lwork,), t)
-    results = lapack_routine(m, n, a, m, tau, work, -1, 0)
-    if results['info'] != 0:
-        raise LinAlgError('%s returns %d' % (routine_name, results['info']))
+    def query():
+        work = zeros((1,), t)
+        results = lapack_routine(m, n, a, m, tau, work, -1, 0)
+        if results['info'] != 0:
+            raise LinAlgError('%s returns %d' % (routine_name,
+                                                 results['info']))
+        return int(abs(work[0]))
+    lwork = _lwork((routine_name, m, n), query)
 
     # do qr decomposition
-    lwork = int(abs(work[0]))
-    work = zeros((lwork,), t)
+    work = _workspace(routine_name, t, lwork)
     results = lapack_routine(m, n, a, m, tau, work, lwork, 0)
 
     if results['info'] != 0:
@@ -679,15 +801,17 @@ def qr(a, mode='full'):
         routine_name = 'dorgqr'
 
     # determine optimal lwork
-    lwork = 1
-    work = zeros((lwork,), t)
-    results = lapack_routine(m, mn, mn, a, m, tau, work, -1, 0)
-    if results['info'] != 0:
-        raise LinAlgError('%s returns %d' % (routine_name, results['info']))
+    def query():
+        work = zeros((1,), t)
+        results = lapack_routine(m, mn, mn, a, m, tau, work, -1, 0)
+        if results['info'] != 0:
+            raise LinAlgError('%s returns %d' % (routine_name,
+                                                 results['info']))
+        return int(abs(work[0]))
+    lwork = _lwork((routine_name, m, mn), query)
 
     # compute q
-    lwork = int(abs(work[0]))
-    work = zeros((lwork,), t)
+    work = _workspace(routine_name, t, lwork)
     results = lapack_routine(m, mn, mn, a, m, tau, work, lwork, 0)
     if results['info'] != 0:
         raise LinAlgError('%s returns %d' % (routine_name, results['info']))
@@ -763,6 +887,18 @@ def eigvals(a):
 
     """
     a, wrap = _makearray(a)
+    if _isStacked(a):
+        _assertStackedSquareness(a)
+        _assertFinite(a)
+        t, result_t = _commonType(a)
+        w = _callStacked(_umath_linalg.eigvals,
+                         'Eigenvalues did not converge', a)
+        if not isComplexType(t) and all(w.imag == 0.0):
+            w = w.real
+            result_t = _realType(result_t)
+        else:
+            result_t = _complexType(result_t)
+        return _asType(w, result_t)
     _assertRank2(a)
     _assertSquareness(a)
     _assertFinite(a)
@@ -775,25 +911,27 @@ def eigvals(a):
     if isComplexType(t):
         lapack_routine = lapack_lite.zgeev
         w = zeros((n,), t)
-        rwork = zeros((n,), real_t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        results = lapack_routine(_N, _N, n, a, n, w,
-                                 dummy, 1, dummy, 1, work, -1, rwork, 0)
-        lwork = int(abs(work[0]))
-        work = zeros((lwork,), t)
+        rwork = _workspace('zgeev', real_t, n)
+        def query():
+            work = zeros((1,), t)
+            lapack_routine(_N, _N, n, a, n, w,
+                           dummy, 1, dummy, 1, work, -1, rwork, 0)
+            return int(abs(work[0]))
+        lwork = _lwork(('zgeev', _N, n), query)
+        work = _workspace('zgeev', t, lwork)
         results = lapack_routine(_N, _N, n, a, n, w,
                                  dummy, 1, dummy, 1, work, lwork, rwork, 0)
     else:
         lapack_routine = lapack_lite.dgeev
         wr = zeros((n,), t)
         wi = zeros((n,), t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        results = lapack_routine(_N, _N, n, a, n, wr, wi,
-                                 dummy, 1, dummy, 1, work, -1, 0)
-        lwork = int(work[0])
-        work = zeros((lwork,), t)
+        def query():
+            work = zeros((1,), t)
+            lapack_routine(_N, _N, n, a, n, wr, wi,
+                           dummy, 1, dummy, 1, work, -1, 0)
+            return int(work[0])
+        lwork = _lwork(('dgeev', _N, n), query)
+        work = _workspace('dgeev', t, lwork)
         results = lapack_routine(_N, _N, n, a, n, wr, wi,
                                  dummy, 1, dummy, 1, work, lwork, 0)
         if all(wi == 0.):
@@ -856,6 +994,16 @@ def eigvalsh(a, UPLO='L'):
     """
     UPLO = asbytes(UPLO)
     a, wrap = _makearray(a)
+    if _isStacked(a):
+        _assertStackedSquareness(a)
+        t, result_t = _commonType(a)
+        if UPLO == _L:
+            gufunc = _umath_linalg.eigvalsh_lo
+        else:
+            gufunc = _umath_linalg.eigvalsh_up
+        w = _callStacked(gufunc, 'Eigenvalues did not converge', a)
+        # of the type of a, as for a single matrix
+        return _asType(w, result_t)
     _assertRank2(a)
     _assertSquareness(a)
     t, result_t = _commonType(a)
@@ -864,31 +1012,31 @@ def eigvalsh(a, UPLO='L'):
     a = _to_native_byte_order(a)
     n = a.shape[0]
     liwork = 5*n+3
-    iwork = zeros((liwork,), fortran_int)
+    iwork = _workspace('heevd', fortran_int, liwork)
     if isComplexType(t):
         lapack_routine = lapack_lite.zheevd
         w = zeros((n,), real_t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        lrwork = 1
-        rwork = zeros((lrwork,), real_t)
-        results = lapack_routine(_N, UPLO, n, a, n, w, work, -1,
-                                 rwork, -1, iwork, liwork,  0)
-        lwork = int(abs(work[0]))
-        work = zeros((lwork,), t)
-        lrwork = int(rwork[0])
-        rwork = zeros((lrwork,), real_t)
+        def query():
+            work = zeros((1,), t)
+            rwork = zeros((1,), real_t)
+            lapack_routine(_N, UPLO, n, a, n, w, work, -1,
+                           rwork, -1, iwork, liwork,  0)
+            return int(abs(work[0])), int(rwork[0])
+        lwork, lrwork = _lwork(('zheevd', _N, n), query)
+        work = _workspace('zheevd', t, lwork)
+        rwork = _workspace('zheevd', real_t, lrwork)
         results = lapack_routine(_N, UPLO, n, a, n, w, work, lwork,
                                 rwork, lrwork, iwork, liwork,  0)
     else:
         lapack_routine = lapack_lite.dsyevd
         w = zeros((n,), t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        results = lapack_routine(_N, UPLO, n, a, n, w, work, -1,
-                                 iwork, liwork, 0)
-        lwork = int(work[0])
-        work = zeros((lwork,), t)
+        def query():
+            work = zeros((1,), t)
+            lapack_routine(_N, UPLO, n, a, n, w, work, -1,
+                           iwork, liwork, 0)
+            return int(work[0])
+        lwork = _lwork(('dsyevd', _N, n), query)
+        work = _workspace('dsyevd', t, lwork)
         results = lapack_routine(_N, UPLO, n, a, n, w, work, lwork,
                                  iwork, liwork, 0)
     if results['info'] > 0:
@@ -1013,6 +1161,19 @@ def eig(a):
 
     """
     a, wrap = _makearray(a)
+    if _isStacked(a):
+        _assertStackedSquareness(a)
+        _assertFinite(a)
+        t, result_t = _commonType(a)
+        w, v = _callStacked(_umath_linalg.eig,
+                            'Eigenvalues did not converge', a)
+        if not isComplexType(t) and all(w.imag == 0.0):
+            w = w.real
+            v = v.real
+            result_t = _realType(result_t)
+        else:
+            result_t = _complexType(result_t)
+        return _asType(w, result_t), wrap(_asType(v, result_t))
     _assertRank2(a)
     _assertSquareness(a)
     _assertFinite(a)
@@ -1026,13 +1187,14 @@ def eig(a):
         lapack_routine = lapack_lite.zgeev
         w = zeros((n,), t)
         v = zeros((n, n), t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        rwork = zeros((2*n,), real_t)
-        results = lapack_routine(_N, _V, n, a, n, w,
-                                 dummy, 1, v, n, work, -1, rwork, 0)
-        lwork = int(abs(work[0]))
-        work = zeros((lwork,), t)
+        rwork = _workspace('zgeev', real_t, 2*n)
+        def query():
+            work = zeros((1,), t)
+            lapack_routine(_N, _V, n, a, n, w,
+                           dummy, 1, v, n, work, -1, rwork, 0)
+            return int(abs(work[0]))
+        lwork = _lwork(('zgeev', _V, n), query)
+        work = _workspace('zgeev', t, lwork)
         results = lapack_routine(_N, _V, n, a, n, w,
                                  dummy, 1, v, n, work, lwork, rwork, 0)
     else:
@@ -1040,14 +1202,15 @@ def eig(a):
         wr = zeros((n,), t)
         wi = zeros((n,), t)
         vr = zeros((n, n), t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        results = lapack_routine(_N, _V, n, a, n, wr, wi,
-                                  dummy, 1, vr, n, work, -1, 0)
-        lwork = int(work[0])
-        work = zeros((lwork,), t)
+        def query():
+            work = zeros((1,), t)
+            lapack_routine(_N, _V, n, a, n, wr, wi,
+                           dummy, 1, vr, n, work, -1, 0)
+            return int(work[0])
+        lwork = _lwork(('dgeev', _V, n), query)
+        work = _workspace('dgeev', t, lwork)
         results = lapack_routine(_N, _V, n, a, n, wr, wi,
-                                  dummy, 1, vr, n, work, lwork, 0)
+                                 dummy, 1, vr, n, work, lwork, 0)
         if all(wi == 0.0):
             w = wr
             v = vr
@@ -1149,6 +1312,15 @@ def eigh(a, UPLO='L'):
     """
     UPLO = asbytes(UPLO)
     a, wrap = _makearray(a)
+    if _isStacked(a):
+        _assertStackedSquareness(a)
+        t, result_t = _commonType(a)
+        if UPLO == _L:
+            gufunc = _umath_linalg.eigh_lo
+        else:
+            gufunc = _umath_linalg.eigh_up
+        w, v = _callStacked(gufunc, 'Eigenvalues did not converge', a)
+        return _asType(w, _realType(result_t)), wrap(_asType(v, result_t))
     _assertRank2(a)
     _assertSquareness(a)
     t, result_t = _commonType(a)
@@ -1157,31 +1329,31 @@ def eigh(a, UPLO='L'):
     a = _to_native_byte_order(a)
     n = a.shape[0]
     liwork = 5*n+3
-    iwork = zeros((liwork,), fortran_int)
+    iwork = _workspace('heevd', fortran_int, liwork)
     if isComplexType(t):
         lapack_routine = lapack_lite.zheevd
         w = zeros((n,), real_t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        lrwork = 1
-        rwork = zeros((lrwork,), real_t)
-        results = lapack_routine(_V, UPLO, n, a, n, w, work, -1,
-                                 rwork, -1, iwork, liwork,  0)
-        lwork = int(abs(work[0]))
-        work = zeros((lwork,), t)
-        lrwork = int(rwork[0])
-        rwork = zeros((lrwork,), real_t)
+        def query():
+            work = zeros((1,), t)
+            rwork = zeros((1,), real_t)
+            lapack_routine(_V, UPLO, n, a, n, w, work, -1,
+                           rwork, -1, iwork, liwork,  0)
+            return int(abs(work[0])), int(rwork[0])
+        lwork, lrwork = _lwork(('zheevd', _V, n), query)
+        work = _workspace('zheevd', t, lwork)
+        rwork = _workspace('zheevd', real_t, lrwork)
         results = lapack_routine(_V, UPLO, n, a, n, w, work, lwork,
                                  rwork, lrwork, iwork, liwork,  0)
     else:
         lapack_routine = lapack_lite.dsyevd
         w = zeros((n,), t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        results = lapack_routine(_V, UPLO, n, a, n, w, work, -1,
-                iwork, liwork, 0)
-        lwork = int(work[0])
-        work = zeros((lwork,), t)
+        def query():
+            work = zeros((1,), t)
+            lapack_routine(_V, UPLO, n, a, n, w, work, -1,
+                           iwork, liwork, 0)
+            return int(work[0])
+        lwork = _lwork(('dsyevd', _V, n), query)
+        work = _workspace('dsyevd', t, lwork)
         results = lapack_routine(_V, UPLO, n, a, n, w, work, lwork,
                 iwork, liwork, 0)
     if results['info'] > 0:
@@ -1269,6 +1441,31 @@ def svd(a, full_matrices=1, compute_uv=1):
 
     """
     a, wrap = _makearray(a)
+    if _isStacked(a):
+        _assertNonEmpty(a)
+        m, n = a.shape[-2:]
+        t, result_t = _commonType(a)
+        message = 'SVD did not converge'
+        if not compute_uv:
+            if m <= n:
+                gufunc = _umath_linalg.svd_m
+            else:
+                gufunc = _umath_linalg.svd_n
+            s = _callStacked(gufunc, message, a)
+            return _asType(s, _realType(result_t))
+        if full_matrices:
+            if m <= n:
+                gufunc = _umath_linalg.svd_m_f
+            else:
+                gufunc = _umath_linalg.svd_n_f
+        else:
+            if m <= n:
+                gufunc = _umath_linalg.svd_m_s
+            else:
+                gufunc = _umath_linalg.svd_n_s
+        s, u, vt = _callStacked(gufunc, message, a)
+        return (wrap(_asType(u, result_t)), _asType(s, _realType(result_t)),
+                wrap(_asType(vt, result_t)))
     _assertRank2(a)
     _assertNonEmpty(a)
     m, n = a.shape
@@ -1295,27 +1492,29 @@ def svd(a, full_matrices=1, compute_uv=1):
         u = empty((1, 1), t)
         vt = empty((1, 1), t)
 
-    iwork = zeros((8*min(m, n),), fortran_int)
+    iwork = _workspace('gesdd', fortran_int, 8*min(m, n))
     if isComplexType(t):
         lapack_routine = lapack_lite.zgesdd
         lrwork = min(m,n)*max(5*min(m,n)+7, 2*max(m,n)+2*min(m,n)+1)
-        rwork = zeros((lrwork,), real_t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        results = lapack_routine(option, m, n, a, m, s, u, m, vt, nvt,
-                                 work, -1, rwork, iwork, 0)
-        lwork = int(abs(work[0]))
-        work = zeros((lwork,), t)
+        rwork = _workspace('zgesdd', real_t, lrwork)
+        def query():
+            work = zeros((1,), t)
+            lapack_routine(option, m, n, a, m, s, u, m, vt, nvt,
+                           work, -1, rwork, iwork, 0)
+            return int(abs(work[0]))
+        lwork = _lwork(('zgesdd', option, m, n), query)
+        work = _workspace('zgesdd', t, lwork)
         results = lapack_routine(option, m, n, a, m, s, u, m, vt, nvt,
                                  work, lwork, rwork, iwork, 0)
     else:
         lapack_routine = lapack_lite.dgesdd
-        lwork = 1
-        work = zeros((lwork,), t)
-        results = lapack_routine(option, m, n, a, m, s, u, m, vt, nvt,
-                                 work, -1, iwork, 0)
-        lwork = int(work[0])
-        work = zeros((lwork,), t)
+        def query():
+            work = zeros((1,), t)
+            lapack_routine(option, m, n, a, m, s, u, m, vt, nvt,
+                           work, -1, iwork, 0)
+            return int(work[0])
+        lwork = _lwork(('dgesdd', option, m, n), query)
+        work = _workspace('dgesdd', t, lwork)
         results = lapack_routine(option, m, n, a, m, s, u, m, vt, nvt,
                                  work, lwork, iwork, 0)
     if results['info'] > 0:
@@ -1616,6 +1815,15 @@ def slogdet(a):
 
     """
     a = asarray(a)
+    if _isStacked(a):
+        _assertStackedSquareness(a)
+        t, result_t = _commonType(a)
+        # a singular matrix has a sign of 0 and a logdet of -inf
+        olderr = seterr(invalid='ignore')
+        try:
+            return _umath_linalg.slogdet(a)
+        finally:
+            seterr(**olderr)
     _assertRank2(a)
     _assertSquareness(a)
     t, result_t = _commonType(a)
@@ -1674,6 +1882,15 @@ def det(a):
       for large matrices where underflow/overflow may occur.
 
     """
+    a = asarray(a)
+    if _isStacked(a):
+        _assertStackedSquareness(a)
+        t, result_t = _commonType(a)
+        olderr = seterr(invalid='ignore')
+        try:
+            return _umath_linalg.det(a)
+        finally:
+            seterr(**olderr)
     sign, logdet = slogdet(a)
     return sign * exp(logdet)
 
@@ -1784,34 +2001,35 @@ def lstsq(a, b, rcond=-1):
     a, bstar = _to_native_byte_order(a, bstar)
     s = zeros((min(m, n),), real_t)
     nlvl = max( 0, int( math.log( float(min(m, n))/2. ) ) + 1 )
-    iwork = zeros((3*min(m, n)*nlvl+11*min(m, n),), fortran_int)
+    iwork = _workspace('gelsd', fortran_int, 3*min(m, n)*nlvl+11*min(m, n))
     if isComplexType(t):
         lapack_routine = lapack_lite.zgelsd
-        lwork = 1
-        rwork = zeros((lwork,), real_t)
-        work = zeros((lwork,), t)
-        results = lapack_routine(m, n, n_rhs, a, m, bstar, ldb, s, rcond,
-                                 0, work, -1, rwork, iwork, 0)
-        lwork = int(abs(work[0]))
-        rwork = zeros((lwork,), real_t)
-        a_real = zeros((m, n), real_t)
-        bstar_real = zeros((ldb, n_rhs,), real_t)
-        results = lapack_lite.dgelsd(m, n, n_rhs, a_real, m,
-                                     bstar_real, ldb, s, rcond,
-                                     0, rwork, -1, iwork, 0)
-        lrwork = int(rwork[0])
-        work = zeros((lwork,), t)
-        rwork = zeros((lrwork,), real_t)
+        def query():
+            work = zeros((1,), t)
+            rwork = zeros((1,), real_t)
+            lapack_routine(m, n, n_rhs, a, m, bstar, ldb, s, rcond,
+                           0, work, -1, rwork, iwork, 0)
+            lwork = int(abs(work[0]))
+            a_real = zeros((m, n), real_t)
+            bstar_real = zeros((ldb, n_rhs,), real_t)
+            lapack_lite.dgelsd(m, n, n_rhs, a_real, m,
+                               bstar_real, ldb, s, rcond,
+                               0, rwork, -1, iwork, 0)
+            return lwork, int(rwork[0])
+        lwork, lrwork = _lwork(('zgelsd', m, n, n_rhs), query)
+        work = _workspace('zgelsd', t, lwork)
+        rwork = _workspace('zgelsd', real_t, lrwork)
         results = lapack_routine(m, n, n_rhs, a, m, bstar, ldb, s, rcond,
                                  0, work, lwork, rwork, iwork, 0)
     else:
         lapack_routine = lapack_lite.dgelsd
-        lwork = 1
-        work = zeros((lwork,), t)
-        results = lapack_routine(m, n, n_rhs, a, m, bstar, ldb, s, rcond,
-                                 0, work, -1, iwork, 0)
-        lwork = int(work[0])
-        work = zeros((lwork,), t)
+        def query():
+            work = zeros((1,), t)
+            lapack_routine(m, n, n_rhs, a, m, bstar, ldb, s, rcond,
+                           0, work, -1, iwork, 0)
+            return int(work[0])
+        lwork = _lwork(('dgelsd', m, n, n_rhs), query)
+        work = _workspace('dgelsd', t, lwork)
         results = lapack_routine(m, n, n_rhs, a, m, bstar, ldb, s, rcond,
                                  0, work, lwork, iwork, 0)
     if results['info'] > 0:
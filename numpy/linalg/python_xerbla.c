@@ -26,12 +26,22 @@ int xerbla_(char *srname, integer *info)
                                  6 for name, 4 for param. num. */
 
         int len = 0; /* length of subroutine name*/
+#ifdef WITH_THREAD
+        PyGILState_STATE save;
+#endif
         while( len<6 && srname[len]!='\0' )
                 len++;
         while( len && srname[len-1]==' ' )
                 len--;
 
         snprintf(buf, sizeof(buf), format, len, srname, *info);
+        /* lapack_lite calls the routines without the GIL */
+#ifdef WITH_THREAD
+        save = PyGILState_Ensure();
+#endif
         PyErr_SetString(PyExc_ValueError, buf);
+#ifdef WITH_THREAD
+        PyGILState_Release(save);
+#endif
         return 0;
 }
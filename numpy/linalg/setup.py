@@ -20,6 +20,12 @@ def configuration(parent_package='',top_path=None):
                 return ext.depends[:1]
             return ext.depends[:2]
 
+    # the f2c'd routines are not reentrant, calls into them get serialized
+    if lapack_info:
+        lite_info = lapack_info
+    else:
+        lite_info = {'define_macros': [('NPY_LAPACK_LITE_BUNDLED', 1)]}
+
     config.add_extension('lapack_lite',
                          sources = [get_lapack_lite_sources],
                          depends=  ['lapack_litemodule.c',
@@ -27,7 +33,14 @@ def configuration(parent_package='',top_path=None):
                                     'zlapack_lite.c', 'dlapack_lite.c',
                                     'blas_lite.c', 'dlamch.c',
                                     'f2c_lite.c','f2c.h'],
-                         extra_info = lapack_info
+                         extra_info = lite_info
+                         )
+
+    # the gufuncs for stacks of matrices, on the LAPACK of lapack_lite
+    config.add_extension('_umath_linalg',
+                         sources = ['umath_linalg.c.src'],
+                         depends = ['lapack_api.h'],
+                         libraries = ['npymath'],
                          )
 
     return config
@@ -456,6 +456,157 @@ class TestQR(TestCase):
         a = np.zeros((0,2))
         self.assertRaises(linalg.LinAlgError, linalg.qr, a)
 
+    def test_qr_blocked(self):
+        # large enough for the blocked updates of lapack_lite
+        np.random.seed(4)
+        for dt in (np.double, np.cdouble):
+            a = np.random.randn(200, 150).astype(dt)
+            if dt == np.cdouble:
+                a += 1j*np.random.randn(200, 150)
+            q, r = linalg.qr(a)
+            assert_almost_equal(dot(q, r), a)
+            assert_almost_equal(dot(q.T.conj(), q), identity(150))
+
+
+class TestStacked(TestCase):
+    # the sizes up to 4 have their own LU factorization
+    sizes = (0, 1, 2, 3, 4, 6)
+
+    def stack(self, n, dt, shape=(3, 2), hermitian=False):
+        np.random.seed(n)
+        a = np.random.randn(*(shape + (n, n)))
+        if dt in (csingle, cdouble):
+            a = a + 1j*np.random.randn(*(shape + (n, n)))
+        if hermitian:
+            a = np.einsum('...ij,...kj->...ik', a, a.conj()) + n*identity(n)
+        return a.astype(dt)
+
+    def check(self, stacked, single_matrix, *args):
+        r = stacked(*args)
+        # lapack_lite does not take empty matrices
+        if args[0].shape[-1] == 0:
+            return r
+        for idx in np.ndindex(*args[0].shape[:-2]):
+            assert_almost_equal(r[idx], single_matrix(*[x[idx] for x in args]))
+        return r
+
+    def test_solve_inv_det(self):
+        for n in self.sizes:
+            for dt in (single, double, csingle, cdouble):
+                a = self.stack(n, dt)
+                b = np.random.randn(3, 2, n, 2).astype(dt)
+                r = self.check(linalg.solve, linalg.solve, a, b)
+                assert_equal(r.dtype, dt)
+                r = self.check(linalg.solve, linalg.solve, a, b[..., 0])
+                assert_equal(r.shape, b.shape[:-1])
+                r = self.check(linalg.inv, linalg.inv, a)
+                assert_equal(r.dtype, dt)
+                if n > 0:
+                    self.check(linalg.det, linalg.det, a.astype(cdouble))
+                    s, ld = linalg.slogdet(a)
+                    assert_almost_equal(s*np.exp(ld), linalg.det(a))
+
+    def test_decompositions(self):
+        for n in self.sizes[1:]:
+            for dt in (double, cdouble):
+                h = self.stack(n, dt, hermitian=True)
+                self.check(linalg.cholesky, linalg.cholesky, h)
+                self.check(linalg.eigvalsh, linalg.eigvalsh, h)
+                w, v = linalg.eigh(h, UPLO='U')
+                assert_almost_equal(np.einsum('...ij,...jk->...ik', h, v),
+                                    v*w[..., np.newaxis, :])
+                a = self.stack(n, dt)
+                w, v = linalg.eig(a)
+                assert_almost_equal(np.einsum('...ij,...jk->...ik', a, v),
+                                    v*w[..., np.newaxis, :])
+                assert_almost_equal(np.sort_complex(linalg.eigvals(a)),
+                                    np.sort_complex(w))
+                for r in (a, a[..., :n-1, :], a[..., :, :n-1]):
+                    if r.size == 0:
+                        continue
+                    self.check(lambda x: linalg.svd(x, compute_uv=0),
+                               lambda x: linalg.svd(x, compute_uv=0), r)
+                    for full in (0, 1):
+                        u, s, vt = linalg.svd(r, full)
+                        k = min(r.shape[-2:])
+                        assert_almost_equal(
+                            np.einsum('...ij,...j,...jk->...ik',
+                                      u[..., :k], s, vt[..., :k, :]), r)
+
+    def test_qr(self):
+        for dt in (single, double, csingle, cdouble):
+            a = self.stack(5, dt)
+            for x in (a, a[..., :3, :], a[..., :, :3]):
+                q, r = linalg.qr(x)
+                assert_equal(q.dtype, dt)
+                assert_equal(r.dtype, dt)
+                assert_almost_equal(np.einsum('...ij,...jk->...ik', q, r), x)
+                r2 = linalg.qr(x, 'r')
+                a2 = linalg.qr(x, 'economic')
+                for idx in np.ndindex(*x.shape[:-2]):
+                    q1, r1 = linalg.qr(x[idx])
+                    assert_almost_equal(q[idx], q1)
+                    assert_almost_equal(r[idx], r1)
+                    assert_almost_equal(r2[idx], r1)
+                    assert_almost_equal(a2[idx], linalg.qr(x[idx], 'e'))
+
+    def test_hermitian_dtypes(self):
+        # the same types as for a single matrix
+        for dt in (single, double, csingle, cdouble):
+            h = self.stack(3, dt, hermitian=True)
+            assert_equal(linalg.eigvalsh(h).dtype,
+                         linalg.eigvalsh(h[0, 0]).dtype)
+            w, v = linalg.eigh(h)
+            w1, v1 = linalg.eigh(h[0, 0])
+            assert_equal(w.dtype, w1.dtype)
+            assert_equal(v.dtype, v1.dtype)
+
+    def test_real_eig(self):
+        a = np.array([[[2., 0], [0, 3]], [[1, 2], [2, 1]]])
+        w, v = linalg.eig(a)
+        assert_equal(w.dtype, double)
+        assert_equal(v.dtype, double)
+        w = linalg.eigvals(np.array([[[0., 1], [-1, 0]]] * 2))
+        assert_almost_equal(w, [[1j, -1j]] * 2)
+
+    def test_broadcast(self):
+        # a single matrix against a stack, and matrices that are not
+        # contiguous in memory
+        a = self.stack(3, double, shape=(4,))
+        b = self.stack(3, double, shape=(5, 1))
+        x = linalg.solve(a, b)
+        assert_equal(x.shape, (5, 4, 3, 3))
+        assert_almost_equal(np.einsum('...ij,...jk->...ik', a, x),
+                            b + np.zeros((5, 4, 3, 3)))
+        # a single vector against a stack of matrices
+        v = np.arange(3.)
+        x = linalg.solve(a, v)
+        assert_equal(x.shape, (4, 3))
+        assert_almost_equal(x, [linalg.solve(m, v) for m in a])
+        at = a.transpose(0, 2, 1)[:, ::-1]
+        assert_almost_equal(linalg.det(at), [linalg.det(m) for m in at])
+        assert_almost_equal(linalg.inv(at), [linalg.inv(m) for m in at])
+
+    def test_errors(self):
+        olderr = np.geterr()
+        a = self.stack(3, double)
+        a[1, 1] = 0
+        assert_raises(linalg.LinAlgError, linalg.solve, a, a)
+        assert_raises(linalg.LinAlgError, linalg.inv, a)
+        assert_raises(linalg.LinAlgError, linalg.cholesky, a)
+        assert_equal(linalg.det(a)[1, 1], 0)
+        assert_equal(linalg.slogdet(a)[1][1, 1], -inf)
+        # nan does not make det fail either
+        a[0, 0, 0, 0] = np.nan
+        assert_(np.isnan(linalg.det(a)[0, 0]))
+        assert_(np.isnan(linalg.slogdet(a)[1][0, 0]))
+        assert_raises(linalg.LinAlgError, linalg.inv, np.zeros((2, 3, 4)))
+        assert_raises(ValueError, linalg.solve, np.ones((2, 3, 3)),
+                      np.ones((2, 4, 1)))
+        # the errors do not change the floating point error handling
+        assert_equal(np.geterr(), olderr)
+        assert_(np.geterrcall() is None)
+
 
 def test_byteorder_check():
     # Byte order check should pass for native order
@@ -478,5 +629,44 @@ def test_byteorder_check():
             assert_array_equal(res, routine(sw_arr))
 
 
+def test_threads():
+    # lapack_lite runs without the GIL, with its own workspace per thread
+    import threading
+    np.random.seed(5)
+    mats = [np.random.randn(30, 30) for i in range(4)]
+    expected = [(linalg.svd(m, compute_uv=0), linalg.eigvalsh(m + m.T),
+                 linalg.lstsq(m, m[:, 0])[0], linalg.qr(m)[1])
+                for m in mats]
+    errors = []
+
+    def run(k):
+        try:
+            for i in range(20):
+                j = (k + i) % len(mats)
+                m = mats[j]
+                result = (linalg.svd(m, compute_uv=0),
+                          linalg.eigvalsh(m + m.T),
+                          linalg.lstsq(m, m[:, 0])[0], linalg.qr(m)[1])
+                for x, y in zip(result, expected[j]):
+                    assert_almost_equal(x, y)
+        except Exception, e:
+            errors.append(e)
+    threads = [threading.Thread(target=run, args=(k,)) for k in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert_equal(errors, [])
+
+
+@dec.skipif(sys.platform == 'win32',
+            "python_xerbla.c is not built on win32 with an external lapack")
+def test_lapack_illegal_value():
+    from numpy.linalg import lapack_lite
+    a = np.zeros(9)
+    assert_raises(ValueError, lapack_lite.dgesv, 3, 1, a, 0,
+                  np.zeros(3, np.intc), np.zeros(3), 3, 0)
+
+
 if __name__ == "__main__":
     run_module_suite()